@@ -24,3 +24,6 @@ library_dir["shaderc_debug"] = "%{VULKAN_SDK}/Lib/shaderc_sharedd.lib"
 library_dir["opengl"] = "opengl32.lib"
 library_dir["d3dcompiler"] = "d3dcompiler.lib"
 library_dir["d3d11"] = "d3d11.lib"
+
+tool_dir = {}
+tool_dir["glslc"] = "%{VULKAN_SDK}/Bin/glslc"
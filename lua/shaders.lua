@@ -0,0 +1,62 @@
+-- compiles every shader under a project's shader directory at build time and embeds the spir-v in the executable, so
+-- a shipped build never has to run shaderc or read a shader file.
+--
+-- glslc writes every shader out as a c initializer list (`-mfmt=c`), `embedded_shaders.inl` includes those and lists
+-- them by the path the shader would otherwise have been read from. the list is written when the project files are
+-- generated, so a new shader needs the projects to be regenerated, same as a new source file does.
+
+SHADER_EXTENSIONS = { "vert", "frag", "comp", "geom", "tesc", "tese" }
+
+local function shader_symbol(directory, file)
+    return (path.getrelative(directory, file):gsub("[^%w]", "_")) .. "_spv"
+end
+
+-- call from inside a project, `directory` is relative to that project.
+function embed_shaders(directory)
+    local prj    = project()
+    local output = path.join(_MAIN_SCRIPT_DIR, "bin-int", "shaders", prj.name)
+
+    local shaders  = {}
+    local patterns = {}
+    for _, extension in ipairs(SHADER_EXTENSIONS) do
+        table.insert(patterns, directory .. "/**." .. extension)
+        for _, file in ipairs(os.matchfiles(directory .. "/**." .. extension)) do
+            table.insert(shaders, file)
+        end
+    end
+    table.sort(shaders)
+
+    local lines = {
+        "// generated from \"" .. directory .. "\" by lua/shaders.lua, do not edit.",
+        ""
+    }
+    for _, shader in ipairs(shaders) do
+        table.insert(lines, "constexpr u32 " .. shader_symbol(directory, shader) .. "[] =")
+        table.insert(lines, "#include \"" .. shader .. ".inc\"")
+        table.insert(lines, "    ;")
+        table.insert(lines, "")
+    end
+
+    table.insert(lines, "constexpr Embedded_Shader EMBEDDED_SHADERS[] = {")
+    for _, shader in ipairs(shaders) do
+        local symbol = shader_symbol(directory, shader)
+        table.insert(lines, "    { \"" .. shader .. "\", " .. symbol .. ", sizeof(" .. symbol .. ") / sizeof(u32) },")
+    end
+    table.insert(lines, "};")
+
+    os.mkdir(output)
+    os.writefile_ifnotequal(table.concat(lines, "\n") .. "\n", path.join(output, "embedded_shaders.inl"))
+
+    includedirs { output }
+    files(shaders)
+
+    -- same optimization level the runtime compiler uses, so both produce the same spir-v.
+    filter { "files:" .. table.concat(patterns, " or ") }
+        buildmessage "Embedding %{file.relpath}"
+        buildcommands {
+            "{MKDIR} \"" .. output .. "/%{file.reldirectory}\"",
+            "\"%{tool_dir.glslc}\" -O -mfmt=c -o \"" .. output .. "/%{file.relpath}.inc\" \"%{file.abspath}\""
+        }
+        buildoutputs { output .. "/%{file.relpath}.inc" }
+    filter {}
+end
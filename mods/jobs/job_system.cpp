@@ -0,0 +1,307 @@
+#include "job_system.hpp"
+
+namespace jobs {
+
+namespace detail {
+
+struct job {
+    job_fn fn                = {};
+    job_group* group         = nullptr;
+    job* next                = nullptr;
+    bool main_only           = false;
+    std::atomic<bool> unused = true;
+};
+
+} // namespace detail
+
+struct job_system::worker {
+    job_system* owner   = nullptr;
+    std::uint32_t index = 0;
+    std::uint32_t seed  = 0;
+
+    work_stealing_deque<detail::job*, MAX_JOBS_PER_THREAD> deque = {};
+
+    // ring the jobs scheduled from this thread are taken from.
+    std::unique_ptr<detail::job[]> jobs = std::make_unique<detail::job[]>(MAX_JOBS_PER_THREAD);
+    std::size_t next_job                = 0;
+
+    std::atomic<std::uint64_t> executed      = 0;
+    std::atomic<std::uint64_t> steals        = 0;
+    std::atomic<std::uint64_t> failed_steals = 0;
+
+    std::thread thread = {};
+};
+
+namespace {
+
+// spins before a worker out of work goes to sleep, work tends to come in bursts.
+constexpr std::uint32_t SPIN_COUNT = 64;
+
+thread_local void* current_worker = nullptr;
+
+std::uint32_t next_random(std::uint32_t& state) noexcept {
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+} // namespace
+
+job_system::job_system(std::uint32_t thread_count) :
+    thread_count_(std::max(thread_count, 1u)), workers_(std::make_unique<worker[]>(thread_count_)) {
+    STDX_ASSERT(current_worker == nullptr, "This thread already runs a job_system!");
+
+    for (std::uint32_t i = 0; i < thread_count_; ++i) {
+        workers_[i].owner = this;
+        workers_[i].index = i;
+        workers_[i].seed  = 2654435761u * (i + 1);
+    }
+
+    current_worker = &workers_[MAIN_THREAD];
+    for (std::uint32_t i = 1; i < thread_count_; ++i)
+        workers_[i].thread = std::thread([this, i]() { work(workers_[i]); });
+}
+
+job_system::~job_system() noexcept {
+    STDX_ASSERT(main_head_ == nullptr, "Jobs for the main thread were never pumped!");
+    {
+        std::lock_guard lock{ sleep_mutex_ };
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (std::uint32_t i = 1; i < thread_count_; ++i)
+        workers_[i].thread.join();
+    current_worker = nullptr;
+}
+
+void job_system::run(job_group& group, job_fn fn) noexcept { schedule(allocate(group, std::move(fn), false)); }
+
+void job_system::run_on_main(job_group& group, job_fn fn) noexcept { schedule(allocate(group, std::move(fn), true)); }
+
+void job_system::run_after(job_group& dependency, job_group& group, job_fn fn) noexcept {
+    schedule_after(dependency, allocate(group, std::move(fn), false));
+}
+
+void job_system::run_on_main_after(job_group& dependency, job_group& group, job_fn fn) noexcept {
+    schedule_after(dependency, allocate(group, std::move(fn), true));
+}
+
+void job_system::wait(job_group& group) noexcept {
+    worker& self = current();
+    while (!group.done()) {
+        if (!try_run_one(self)) std::this_thread::yield();
+    }
+}
+
+void job_system::pump_main() noexcept {
+    worker& self = current();
+    STDX_ASSERT(self.index == MAIN_THREAD, "Only the main thread runs main thread jobs!");
+
+    // only what is queued right now, jobs that queue themselves again wait for the next pump.
+    std::size_t count = main_queue_depth();
+    for (; count != 0; --count) {
+        detail::job* job = pop_main();
+        if (job == nullptr) return;
+        execute(self, job);
+    }
+}
+
+worker_stats job_system::stats(std::uint32_t worker) const noexcept {
+    STDX_ASSERT(worker < thread_count_, "No such worker!");
+    const auto& w = workers_[worker];
+    return { w.executed.load(std::memory_order_relaxed),
+             w.steals.load(std::memory_order_relaxed),
+             w.failed_steals.load(std::memory_order_relaxed),
+             static_cast<std::uint32_t>(w.deque.size()) };
+}
+
+std::uint32_t job_system::main_queue_depth() const noexcept {
+    std::lock_guard lock{ main_mutex_ };
+    return main_count_;
+}
+
+detail::job* job_system::allocate(job_group& group, job_fn&& fn, bool main_only) noexcept {
+    worker& self = current();
+
+    // first job of an idle group, reopen it once whoever finished its last job has let go of it.
+    if (group.pending_.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        detail::job* expected = job_group::closed();
+        while (!group.continuations_.compare_exchange_weak(
+            expected,
+            nullptr,
+            std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+            expected = job_group::closed();
+            std::this_thread::yield();
+        }
+    }
+
+    for (;;) {
+        for (std::size_t i = 0; i < MAX_JOBS_PER_THREAD; ++i) {
+            detail::job& job = self.jobs[self.next_job++ % MAX_JOBS_PER_THREAD];
+            if (!job.unused.load(std::memory_order_acquire)) continue;
+
+            job.unused.store(false, std::memory_order_relaxed);
+            job.fn        = std::move(fn);
+            job.group     = &group;
+            job.next      = nullptr;
+            job.main_only = main_only;
+            return &job;
+        }
+
+        // every job of this thread is still in flight, help out until one frees up.
+        if (!try_run_one(self)) std::this_thread::yield();
+    }
+}
+
+void job_system::schedule(detail::job* job) noexcept {
+    if (job->main_only) {
+        job->next = nullptr;
+        std::lock_guard lock{ main_mutex_ };
+        if (main_tail_ == nullptr) {
+            main_head_ = job;
+        } else {
+            main_tail_->next = job;
+        }
+        main_tail_ = job;
+        ++main_count_;
+        return;
+    }
+
+    worker& self = current();
+    if (!self.deque.push(job)) {
+        // deque is full, running it right away is still correct.
+        execute(self, job);
+        return;
+    }
+    wake_one();
+}
+
+void job_system::schedule_after(job_group& dependency, detail::job* job) noexcept {
+    detail::job* head = dependency.continuations_.load(std::memory_order_acquire);
+    do {
+        if (head == job_group::closed()) {
+            schedule(job);
+            return;
+        }
+        job->next = head;
+    } while (!dependency.continuations_.compare_exchange_weak(
+        head,
+        job,
+        std::memory_order_release,
+        std::memory_order_acquire));
+}
+
+detail::job* job_system::pop_main() noexcept {
+    std::lock_guard lock{ main_mutex_ };
+    detail::job* job = main_head_;
+    if (job == nullptr) return nullptr;
+
+    main_head_ = job->next;
+    if (main_head_ == nullptr) main_tail_ = nullptr;
+    --main_count_;
+    return job;
+}
+
+void job_system::execute(worker& self, detail::job* job) noexcept {
+    if (hooks_.job_begin != nullptr) hooks_.job_begin(hooks_.user, self.index);
+    job->fn();
+    if (hooks_.job_end != nullptr) hooks_.job_end(hooks_.user, self.index);
+
+    job_group& group = *job->group;
+    job->fn.reset();
+    job->unused.store(true, std::memory_order_release);
+    self.executed.fetch_add(1, std::memory_order_relaxed);
+
+    finish(group);
+}
+
+void job_system::finish(job_group& group) noexcept {
+    if (group.pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    // the group may be gone as soon as it reads as closed, don't touch it after this.
+    detail::job* continuation = group.continuations_.exchange(job_group::closed(), std::memory_order_acq_rel);
+    while (continuation != nullptr) {
+        detail::job* next = continuation->next;
+        schedule(continuation);
+        continuation = next;
+    }
+}
+
+bool job_system::try_run_one(worker& self) noexcept {
+    detail::job* job = self.index == MAIN_THREAD ? pop_main() : nullptr;
+
+    if (job == nullptr && !self.deque.pop(job)) {
+        if (!try_steal(self, job)) return false;
+    }
+
+    execute(self, job);
+    return true;
+}
+
+bool job_system::try_steal(worker& self, detail::job*& out) noexcept {
+    if (thread_count_ == 1) return false;
+
+    const std::uint32_t start = next_random(self.seed) % thread_count_;
+    for (std::uint32_t i = 0; i < thread_count_; ++i) {
+        const std::uint32_t victim = (start + i) % thread_count_;
+        if (victim == self.index || !workers_[victim].deque.steal(out)) continue;
+
+        self.steals.fetch_add(1, std::memory_order_relaxed);
+        if (hooks_.steal != nullptr) hooks_.steal(hooks_.user, self.index, victim);
+        return true;
+    }
+
+    self.failed_steals.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool job_system::has_stealable_work() const noexcept {
+    for (std::uint32_t i = 0; i < thread_count_; ++i) {
+        if (!workers_[i].deque.empty()) return true;
+    }
+    return false;
+}
+
+void job_system::wake_one() noexcept {
+    // pairs with the fence in `work`, either the sleeper sees the new job or we see the sleeper.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed) == 0) return;
+
+    std::lock_guard lock{ sleep_mutex_ };
+    wake_.notify_one();
+}
+
+void job_system::work(worker& self) noexcept {
+    current_worker = &self;
+
+    for (;;) {
+        if (try_run_one(self)) continue;
+
+        bool found = false;
+        for (std::uint32_t i = 0; i < SPIN_COUNT && !found; ++i) {
+            std::this_thread::yield();
+            found = has_stealable_work();
+        }
+        if (found) continue;
+
+        std::unique_lock lock{ sleep_mutex_ };
+        sleeping_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_.wait(lock, [this]() { return stopping_.load() || has_stealable_work(); });
+        sleeping_.fetch_sub(1, std::memory_order_relaxed);
+
+        if (stopping_.load() && !has_stealable_work()) return;
+    }
+}
+
+job_system::worker& job_system::current() const noexcept {
+    auto* self = static_cast<worker*>(current_worker);
+    STDX_ASSERT(self != nullptr && self->owner == this, "Only the main thread and jobs can use the job_system!");
+    return *self;
+}
+
+} // namespace jobs
@@ -0,0 +1,137 @@
+#pragma once
+#include "stdx/fwd.hpp"
+#include "stdx/inplace_function.hpp"
+#include "work_stealing_deque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace jobs {
+
+using job_fn = stdx::inplace_function<void(), 48>;
+
+class job_system;
+
+namespace detail {
+struct job;
+} // namespace detail
+
+// counts the unfinished jobs added to it. other jobs can be made to start only once a group is done with
+// `job_system::run_after`, and any thread that scheduled work can block on it with `job_system::wait`.
+// a group is reusable once it is done, add all of its jobs before hanging continuations off of it.
+class job_group {
+public:
+    job_group() noexcept = default;
+
+    job_group(const job_group&)            = delete;
+    job_group& operator=(const job_group&) = delete;
+
+    ~job_group() noexcept { STDX_ASSERT(done(), "Destroying a job_group with jobs still in flight!"); }
+
+    [[nodiscard]] bool done() const noexcept { return continuations_.load(std::memory_order_acquire) == closed(); }
+    [[nodiscard]] std::uint32_t pending() const noexcept { return pending_.load(std::memory_order_relaxed); }
+
+private:
+    friend class job_system;
+
+    static detail::job* closed() noexcept { return reinterpret_cast<detail::job*>(std::uintptr_t{ 1 }); }
+
+    std::atomic<std::uint32_t> pending_ = 0;
+    // jobs waiting on this group, swapped for `closed()` by whoever finishes the last job.
+    std::atomic<detail::job*> continuations_ = closed();
+};
+
+// counters of one thread, all of them are only approximate while jobs are running.
+struct worker_stats {
+    std::uint64_t executed      = 0;
+    std::uint64_t steals        = 0;
+    std::uint64_t failed_steals = 0;
+    std::uint32_t queue_depth   = 0;
+};
+
+// optional callbacks for a profiler, set them before any job is scheduled. they run on the thread they describe.
+struct profile_hooks {
+    void* user                                                            = nullptr;
+    void (*job_begin)(void* user, std::uint32_t worker)                   = nullptr;
+    void (*job_end)(void* user, std::uint32_t worker)                     = nullptr;
+    void (*steal)(void* user, std::uint32_t thief, std::uint32_t victim) = nullptr;
+};
+
+// work stealing scheduler. every thread owns a deque, pushes and pops its own jobs from the bottom and steals from the
+// top of a random other deque once its own runs dry. the thread that creates the system is worker 0, the main thread,
+// and only runs jobs while inside `wait` or `pump_main`. jobs scheduled with `run_on_main` only ever run there.
+// jobs are stored inline and recycled from a fixed ring per thread, scheduling never allocates.
+class job_system {
+public:
+    static constexpr std::size_t MAX_JOBS_PER_THREAD = 4096;
+    static constexpr std::uint32_t MAIN_THREAD       = 0;
+
+    // `thread_count` includes the calling thread, so 1 runs everything on the main thread.
+    explicit job_system(std::uint32_t thread_count = std::max(std::thread::hardware_concurrency(), 1u));
+    ~job_system() noexcept;
+
+    job_system(const job_system&)            = delete;
+    job_system& operator=(const job_system&) = delete;
+
+    // only the main thread and jobs may schedule.
+    void run(job_group& group, job_fn fn) noexcept;
+    void run_on_main(job_group& group, job_fn fn) noexcept;
+
+    // `fn` is scheduled once `dependency` is done, immediately if it already is.
+    void run_after(job_group& dependency, job_group& group, job_fn fn) noexcept;
+    void run_on_main_after(job_group& dependency, job_group& group, job_fn fn) noexcept;
+
+    // runs jobs on the calling thread until `group` is done.
+    void wait(job_group& group) noexcept;
+
+    // runs every job queued for the main thread, call once per frame.
+    void pump_main() noexcept;
+
+    [[nodiscard]] std::uint32_t thread_count() const noexcept { return thread_count_; }
+    [[nodiscard]] worker_stats stats(std::uint32_t worker) const noexcept;
+    [[nodiscard]] std::uint32_t main_queue_depth() const noexcept;
+
+    void set_profile_hooks(const profile_hooks& hooks) noexcept { hooks_ = hooks; }
+
+private:
+    struct worker;
+
+    detail::job* allocate(job_group& group, job_fn&& fn, bool main_only) noexcept;
+    void schedule(detail::job* job) noexcept;
+    void schedule_after(job_group& dependency, detail::job* job) noexcept;
+    detail::job* pop_main() noexcept;
+    void execute(worker& self, detail::job* job) noexcept;
+    void finish(job_group& group) noexcept;
+
+    bool try_run_one(worker& self) noexcept;
+    bool try_steal(worker& self, detail::job*& out) noexcept;
+    bool has_stealable_work() const noexcept;
+    void wake_one() noexcept;
+    void work(worker& self) noexcept;
+
+    worker& current() const noexcept;
+
+private:
+    std::uint32_t thread_count_ = 0;
+    std::unique_ptr<worker[]> workers_;
+    profile_hooks hooks_ = {};
+
+    // jobs for the main thread, a fifo linked through `job::next`. a job only sits here once it's been scheduled, when
+    // nothing else uses its `next` anymore.
+    mutable std::mutex main_mutex_;
+    detail::job* main_head_   = nullptr;
+    detail::job* main_tail_   = nullptr;
+    std::uint32_t main_count_ = 0;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<std::uint32_t> sleeping_ = 0;
+    std::atomic<bool> stopping_          = false;
+};
+
+} // namespace jobs
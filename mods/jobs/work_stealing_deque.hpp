@@ -0,0 +1,83 @@
+#pragma once
+#include "stdx/fwd.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace jobs {
+
+// fixed capacity Chase-Lev deque. the owning thread pushes and pops at the bottom, any other thread steals from the
+// top. memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Lê et al. 2013).
+template <typename T, std::size_t Capacity>
+class work_stealing_deque {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity has to be a power of two!");
+    static_assert(std::is_trivially_copyable_v<T>, "Elements are read and written atomically!");
+
+public:
+    static constexpr std::size_t capacity = Capacity;
+
+    // owner only, false when full.
+    bool push(T value) noexcept {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top    = top_.load(std::memory_order_acquire);
+        if (bottom - top >= static_cast<std::int64_t>(Capacity)) return false;
+
+        buffer_[bottom & MASK].store(value, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // owner only, takes the most recently pushed element.
+    bool pop(T& out) noexcept {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = buffer_[bottom & MASK].load(std::memory_order_relaxed);
+        if (top != bottom) return true;
+
+        // last element, race the thieves for it.
+        const bool won =
+            top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // any thread, takes the oldest element. can fail spuriously when racing another thief or the owner.
+    bool steal(T& out) noexcept {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) return false;
+
+        out = buffer_[top & MASK].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // approximate when called from another thread.
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top    = top_.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+private:
+    static constexpr std::int64_t MASK = static_cast<std::int64_t>(Capacity) - 1;
+
+    // thieves and the owner hammer different ends, keep them off each other's cache line.
+    alignas(64) std::atomic<std::int64_t> top_    = 0;
+    alignas(64) std::atomic<std::int64_t> bottom_ = 0;
+    alignas(64) std::atomic<T> buffer_[Capacity]  = {};
+};
+
+} // namespace jobs
@@ -12,3 +12,28 @@ project "stdx"
         "%{prj.name}/**.h"
     }
 
+
+project "jobs"
+    language "C++"
+    cppdialect "C++17"
+    staticruntime "on"
+    characterset "MBCS"
+    kind "StaticLib"
+    targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+    objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+    files {
+        "%{prj.name}/**.hpp",
+        "%{prj.name}/**.cpp"
+    }
+
+    includedirs {
+        "."
+    }
+
+    filter "configurations:Debug"
+        runtime "Debug"
+        symbols "on"
+
+    filter "configurations:Release or Dist"
+        runtime "Release"
+        optimize "on"
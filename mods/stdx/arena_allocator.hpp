@@ -0,0 +1,51 @@
+#pragma once
+#include "fwd.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace stdx {
+
+// Adapts a linear arena (anything with `void* allocate(size_t size, size_t alignment)`) to the standard allocator
+// interface. `deallocate` does nothing, memory comes back when the arena is cleared. the allocator propagates with
+// the container so that moved containers keep allocating from the same arena.
+template <typename T, typename Arena>
+class arena_allocator {
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    arena_allocator(Arena& arena) noexcept : arena_(&arena) {}
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U, Arena>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(size_t count) noexcept {
+        void* memory = arena_->allocate(sizeof(T) * count, alignof(T));
+        STDX_ASSERT(memory != nullptr, "Arena ran out of memory!");
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    Arena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator<U, Arena>& rhs) noexcept {
+        return lhs.arena() == rhs.arena();
+    }
+
+    template <typename U>
+    friend bool operator!=(const arena_allocator& lhs, const arena_allocator<U, Arena>& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    Arena* arena_;
+};
+
+} // namespace stdx
@@ -24,6 +24,11 @@ struct contiguous_iterator {
 public:
     contiguous_iterator(pointer data, index_type idx) noexcept : data_(data), curr_(idx) {}
 
+    // iterator -> const_iterator.
+    template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+    contiguous_iterator(const contiguous_iterator<OtherConst, owner_type>& other) noexcept :
+        data_(other.data_), curr_(other.curr_) {}
+
     this_type& operator++() noexcept { return ++curr_, *this; }
     this_type operator++(int) noexcept { return { data_, curr_++ }; }
 
@@ -34,6 +39,15 @@ public:
     reference operator*() noexcept { return data_[curr_]; }
     const_reference operator*() const noexcept { return data_[curr_]; }
 
+    pointer operator->() const noexcept { return data_ + curr_; }
+    reference operator[](difference_type n) const noexcept { return data_[curr_ + n]; }
+
+    this_type& operator+=(difference_type n) noexcept { return curr_ += n, *this; }
+    this_type& operator-=(difference_type n) noexcept { return curr_ -= n, *this; }
+    this_type operator+(difference_type n) const noexcept { return { data_, curr_ + n }; }
+    this_type operator-(difference_type n) const noexcept { return { data_, curr_ - n }; }
+    friend this_type operator+(difference_type n, const this_type& it) noexcept { return it + n; }
+
     bool operator==(const this_type& other) const noexcept {
         STDX_ASSERT(data_ == other.data_, "Not even comparing iterators from the same container!");
         return curr_ == other.curr_;
@@ -63,6 +77,9 @@ public:
     }
 
 private:
+    template <bool, typename>
+    friend struct contiguous_iterator;
+
     pointer data_;
     index_type curr_;
 };
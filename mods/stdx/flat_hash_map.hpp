@@ -0,0 +1,105 @@
+#pragma once
+#include "raw_hash_table.hpp"
+
+namespace stdx {
+
+namespace detail {
+
+template <typename Key, typename Value>
+struct flat_map_policy {
+    using key_type   = Key;
+    using slot_type  = std::pair<const Key, Value>;
+    using value_type = slot_type;
+
+    static constexpr bool constant_iterators = false;
+
+    static const Key& key(const slot_type& slot) noexcept { return slot.first; }
+
+    // moves `from` into the uninitialized `to` and ends the lifetime of `from`.
+    template <typename Allocator>
+    static void transfer(Allocator& allocator, slot_type* to, slot_type* from) noexcept {
+        using traits = std::allocator_traits<Allocator>;
+        if constexpr (is_trivially_relocatable_v<Key> && is_trivially_relocatable_v<Value>) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(slot_type));
+        } else {
+            // the key is const only to the outside, `from` is destroyed right after.
+            traits::construct(allocator, to, std::move(const_cast<Key&>(from->first)), std::move(from->second));
+            traits::destroy(allocator, from);
+        }
+    }
+};
+
+} // namespace detail
+
+// `std::unordered_map` replacement that keeps its elements in one flat array instead of one node per element.
+// references and iterators are invalidated by any insertion that grows the table, erase keeps them valid.
+// lookups accept anything the hash and equality accept when both are transparent (`std::string_view` for
+// `std::string` keys with the default `stdx::hash`).
+template <
+    typename Key,
+    typename Value,
+    typename Hash      = stdx::hash<Key>,
+    typename Eq        = stdx::hash_equal<Key>,
+    typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class flat_hash_map : public detail::raw_hash_table<detail::flat_map_policy<Key, Value>, Hash, Eq, Allocator> {
+    using base = detail::raw_hash_table<detail::flat_map_policy<Key, Value>, Hash, Eq, Allocator>;
+
+    template <typename K>
+    using key_arg = typename base::template key_arg<K>;
+
+public:
+    using mapped_type = Value;
+    using typename base::iterator;
+    using typename base::key_type;
+
+    using base::base;
+    using base::insert;
+
+    template <typename K = key_type, typename... Args>
+    std::pair<iterator, bool> try_emplace(const key_arg<K>& key, Args&&... args) {
+        return base::emplace_with_key(
+            key,
+            std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return base::emplace_with_key(
+            key,
+            std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <typename K = key_type, typename V>
+    std::pair<iterator, bool> insert_or_assign(const key_arg<K>& key, V&& value) {
+        auto result = try_emplace(key, std::forward<V>(value));
+        if (!result.second) result.first->second = std::forward<V>(value);
+        return result;
+    }
+
+    template <typename K = key_type>
+    Value& operator[](const key_arg<K>& key) {
+        return try_emplace(key).first->second;
+    }
+
+    Value& operator[](key_type&& key) { return try_emplace(std::move(key)).first->second; }
+
+    template <typename K = key_type>
+    Value& at(const key_arg<K>& key) noexcept {
+        auto it = base::find(key);
+        STDX_ASSERT(it != base::end(), "Key is not in the map!");
+        return it->second;
+    }
+
+    template <typename K = key_type>
+    const Value& at(const key_arg<K>& key) const noexcept {
+        auto it = base::find(key);
+        STDX_ASSERT(it != base::end(), "Key is not in the map!");
+        return it->second;
+    }
+};
+
+} // namespace stdx
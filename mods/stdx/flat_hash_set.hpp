@@ -0,0 +1,46 @@
+#pragma once
+#include "raw_hash_table.hpp"
+
+namespace stdx {
+
+namespace detail {
+
+template <typename Key>
+struct flat_set_policy {
+    using key_type   = Key;
+    using slot_type  = Key;
+    using value_type = Key;
+
+    static constexpr bool constant_iterators = true;
+
+    static const Key& key(const slot_type& slot) noexcept { return slot; }
+
+    // moves `from` into the uninitialized `to` and ends the lifetime of `from`.
+    template <typename Allocator>
+    static void transfer(Allocator& allocator, slot_type* to, slot_type* from) noexcept {
+        using traits = std::allocator_traits<Allocator>;
+        if constexpr (is_trivially_relocatable_v<Key>) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(slot_type));
+        } else {
+            traits::construct(allocator, to, std::move(*from));
+            traits::destroy(allocator, from);
+        }
+    }
+};
+
+} // namespace detail
+
+// `std::unordered_set` replacement, see `flat_hash_map` for the guarantees it gives.
+template <
+    typename Key,
+    typename Hash      = stdx::hash<Key>,
+    typename Eq        = stdx::hash_equal<Key>,
+    typename Allocator = std::allocator<Key>>
+class flat_hash_set : public detail::raw_hash_table<detail::flat_set_policy<Key>, Hash, Eq, Allocator> {
+    using base = detail::raw_hash_table<detail::flat_set_policy<Key>, Hash, Eq, Allocator>;
+
+public:
+    using base::base;
+};
+
+} // namespace stdx
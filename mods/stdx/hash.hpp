@@ -0,0 +1,180 @@
+#pragma once
+#include "type_traits.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace stdx {
+
+namespace detail {
+
+// 64x64 -> 128 bit multiply folded back into 64 bits, the building block of wyhash.
+inline uint64_t mum(uint64_t lhs, uint64_t rhs) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high      = 0;
+    const uint64_t low = _umul128(lhs, rhs, &high);
+    return low ^ high;
+#else
+    const uint64_t lo_lo = (lhs & 0xffffffff) * (rhs & 0xffffffff);
+    const uint64_t hi_lo = (lhs >> 32) * (rhs & 0xffffffff);
+    const uint64_t lo_hi = (lhs & 0xffffffff) * (rhs >> 32);
+    const uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+    const uint64_t high  = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    const uint64_t low   = (cross << 32) | (lo_lo & 0xffffffff);
+    return low ^ high;
+#endif
+}
+
+inline uint64_t read_u64(const unsigned char* data) noexcept {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint64_t read_u32(const unsigned char* data) noexcept {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline constexpr uint64_t HASH_SECRET[4] = {
+    0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull
+};
+
+} // namespace detail
+
+// spreads the bits of an integer over the whole 64 bits, used for keys that are already unique numbers.
+inline uint64_t hash_mix(uint64_t value) noexcept {
+    return detail::mum(value ^ detail::HASH_SECRET[0], detail::HASH_SECRET[1]);
+}
+
+// wyhash (public domain) over `size` bytes. fast for the short keys caches use and still fine for long ones.
+inline uint64_t hash_bytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+    using detail::HASH_SECRET;
+    using detail::mum;
+    using detail::read_u32;
+    using detail::read_u64;
+
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    seed ^= mum(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (size <= 16) {
+        if (size >= 4) {
+            const size_t offset = (size >> 3) << 2;
+            a                   = (read_u32(bytes) << 32) | read_u32(bytes + offset);
+            b                   = (read_u32(bytes + size - 4) << 32) | read_u32(bytes + size - 4 - offset);
+        } else if (size > 0) {
+            a = (uint64_t{ bytes[0] } << 16) | (uint64_t{ bytes[size >> 1] } << 8) | bytes[size - 1];
+        }
+    } else {
+        size_t left = size;
+        if (left > 48) {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed  = mum(read_u64(bytes) ^ HASH_SECRET[1], read_u64(bytes + 8) ^ seed);
+                seed1 = mum(read_u64(bytes + 16) ^ HASH_SECRET[2], read_u64(bytes + 24) ^ seed1);
+                seed2 = mum(read_u64(bytes + 32) ^ HASH_SECRET[3], read_u64(bytes + 40) ^ seed2);
+                bytes += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (left > 16) {
+            seed = mum(read_u64(bytes) ^ HASH_SECRET[1], read_u64(bytes + 8) ^ seed);
+            bytes += 16;
+            left -= 16;
+        }
+        a = read_u64(bytes + left - 16);
+        b = read_u64(bytes + left - 8);
+    }
+
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    return mum(HASH_SECRET[0] ^ size, mum(a, b) ^ HASH_SECRET[1]);
+}
+
+// hash functor used by the stdx containers. integers, enums and pointers get mixed, strings go through
+// `hash_bytes` and accept any string-like type, everything else is `std::hash` mixed.
+template <typename Type, typename = void>
+struct hash {
+    size_t operator()(const Type& value) const noexcept {
+        return static_cast<size_t>(hash_mix(std::hash<Type>{}(value)));
+    }
+};
+
+template <typename Type>
+struct hash<Type, std::enable_if_t<std::is_integral_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>>> {
+    size_t operator()(Type value) const noexcept {
+        if constexpr (std::is_pointer_v<Type>) {
+            return static_cast<size_t>(hash_mix(reinterpret_cast<uintptr_t>(value)));
+        } else if constexpr (std::is_enum_v<Type>) {
+            using underlying_type = std::underlying_type_t<Type>;
+            return static_cast<size_t>(hash_mix(static_cast<uint64_t>(static_cast<underlying_type>(value))));
+        } else {
+            return static_cast<size_t>(hash_mix(static_cast<uint64_t>(value)));
+        }
+    }
+};
+
+template <>
+struct hash<std::string_view> {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view str) const noexcept {
+        return static_cast<size_t>(hash_bytes(str.data(), str.size()));
+    }
+};
+
+template <>
+struct hash<std::string> : hash<std::string_view> {};
+
+// hashes the object representation of trivially copyable keys, e.g. vulkan create infos. padding is hashed too, so
+// keys with padding have to be zero initialized (`Type key = {}` or a `memset`) and must not carry `pNext` chains.
+template <typename Type>
+struct pod_hash {
+    static_assert(std::is_trivially_copyable_v<Type>, "pod_hash only works on trivially copyable types");
+
+    size_t operator()(const Type& value) const noexcept {
+        return static_cast<size_t>(hash_bytes(&value, sizeof(Type)));
+    }
+};
+
+// byte wise equality to go along with `pod_hash`.
+template <typename Type>
+struct pod_equal {
+    static_assert(std::is_trivially_copyable_v<Type>, "pod_equal only works on trivially copyable types");
+
+    bool operator()(const Type& lhs, const Type& rhs) const noexcept {
+        return std::memcmp(&lhs, &rhs, sizeof(Type)) == 0;
+    }
+};
+
+template <typename Type, typename = void>
+struct is_transparent : std::false_type {};
+
+template <typename Type>
+struct is_transparent<Type, std::void_t<typename Type::is_transparent>> : std::true_type {};
+
+template <typename Type>
+constexpr bool is_transparent_v = is_transparent<Type>::value;
+
+// equality that goes along with `stdx::hash`, transparent whenever the hash is.
+template <typename Type>
+using hash_equal = std::conditional_t<is_transparent_v<hash<Type>>, std::equal_to<>, std::equal_to<Type>>;
+
+} // namespace stdx
@@ -0,0 +1,171 @@
+#pragma once
+#include "aligned_storage.hpp"
+#include "fwd.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace stdx {
+
+template <typename Signature, size_t Capacity = 4 * sizeof(void*), size_t Alignment = alignof(std::max_align_t)>
+class inplace_function;
+
+namespace detail {
+
+template <typename R, typename... Args>
+struct inplace_function_vtable {
+    R (*invoke)(void*, Args...);
+    void (*copy)(void* to, const void* from);
+    // move constructs into `to` and destroys `from`.
+    void (*relocate)(void* to, void* from);
+    void (*destroy)(void*);
+};
+
+template <typename Callable, typename R, typename... Args>
+constexpr inplace_function_vtable<R, Args...> inplace_function_vtable_for = {
+    [](void* obj, Args... args) -> R {
+        return std::invoke(*static_cast<Callable*>(obj), std::forward<Args>(args)...);
+    },
+    [](void* to, const void* from) { new (to) Callable(*static_cast<const Callable*>(from)); },
+    [](void* to, void* from) {
+        new (to) Callable(std::move(*static_cast<Callable*>(from)));
+        std::destroy_at(static_cast<Callable*>(from));
+    },
+    [](void* obj) { std::destroy_at(static_cast<Callable*>(obj)); },
+};
+
+template <bool Noexcept, size_t Capacity, size_t Alignment, typename R, typename... Args>
+class inplace_function_base {
+    using vtable_type = inplace_function_vtable<R, Args...>;
+
+    template <typename Callable>
+    static constexpr bool is_invocable_v = Noexcept ? std::is_nothrow_invocable_r_v<R, Callable&, Args...>
+                                                    : std::is_invocable_r_v<R, Callable&, Args...>;
+
+    template <typename Callable>
+    using enable_if_callable_t = std::enable_if_t<
+        !std::is_base_of_v<inplace_function_base, std::decay_t<Callable>> && is_invocable_v<std::decay_t<Callable>>>;
+
+public:
+    static constexpr size_t capacity  = Capacity;
+    static constexpr size_t alignment = Alignment;
+
+    inplace_function_base() noexcept = default;
+    inplace_function_base(std::nullptr_t) noexcept {}
+
+    template <typename Callable, typename = enable_if_callable_t<Callable>>
+    inplace_function_base(Callable&& c) noexcept(std::is_nothrow_constructible_v<std::decay_t<Callable>, Callable&&>) {
+        emplace(std::forward<Callable>(c));
+    }
+
+    inplace_function_base(const inplace_function_base& other) : vtable_(other.vtable_) {
+        if (vtable_ != nullptr) vtable_->copy(&storage_, &other.storage_);
+    }
+
+    inplace_function_base(inplace_function_base&& other) noexcept : vtable_(other.vtable_) {
+        if (vtable_ != nullptr) vtable_->relocate(&storage_, &other.storage_);
+        other.vtable_ = nullptr;
+    }
+
+    inplace_function_base& operator=(const inplace_function_base& other) {
+        if (this != &other) {
+            reset();
+            if (other.vtable_ != nullptr) other.vtable_->copy(&storage_, &other.storage_);
+            vtable_ = other.vtable_;
+        }
+        return *this;
+    }
+
+    inplace_function_base& operator=(inplace_function_base&& other) noexcept {
+        if (this != &other) {
+            reset();
+            if (other.vtable_ != nullptr) other.vtable_->relocate(&storage_, &other.storage_);
+            vtable_       = other.vtable_;
+            other.vtable_ = nullptr;
+        }
+        return *this;
+    }
+
+    inplace_function_base& operator=(std::nullptr_t) noexcept {
+        reset();
+        return *this;
+    }
+
+    template <typename Callable, typename = enable_if_callable_t<Callable>>
+    inplace_function_base& operator=(Callable&& c) {
+        reset();
+        emplace(std::forward<Callable>(c));
+        return *this;
+    }
+
+    ~inplace_function_base() noexcept { reset(); }
+
+    // takes the arguments as the signature spells them, `T&` parameters bind to lvalues and by value ones are moved
+    // through the vtable.
+    R operator()(Args... args) const noexcept(Noexcept) {
+        STDX_ASSERT(vtable_ != nullptr, "Calling an empty inplace_function!");
+        return vtable_->invoke(const_cast<void*>(static_cast<const void*>(&storage_)), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return vtable_ != nullptr; }
+
+    void reset() noexcept {
+        if (vtable_ != nullptr) vtable_->destroy(&storage_);
+        vtable_ = nullptr;
+    }
+
+    void swap(inplace_function_base& other) noexcept {
+        inplace_function_base temp{ std::move(other) };
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+private:
+    template <typename Callable>
+    void emplace(Callable&& c) {
+        using callable_type = std::decay_t<Callable>;
+        static_assert(sizeof(callable_type) <= Capacity, "Callable does not fit, raise the capacity!");
+        static_assert(alignof(callable_type) <= Alignment, "Callable is over aligned for this inplace_function!");
+        static_assert(std::is_copy_constructible_v<callable_type>, "inplace_function only holds copyable callables!");
+        static_assert(
+            std::is_nothrow_move_constructible_v<callable_type>,
+            "Callable must be nothrow move constructible to be moved around inplace!");
+
+        new (&storage_) callable_type(std::forward<Callable>(c));
+        vtable_ = &inplace_function_vtable_for<callable_type, R, Args...>;
+    }
+
+private:
+    aligned_storage_t<Capacity, Alignment> storage_;
+    const vtable_type* vtable_ = nullptr;
+};
+
+} // namespace detail
+
+// `std::function` look alike that never allocates, the callable is stored inside the object and has to fit in
+// `Capacity` bytes, which is checked at compile time. copies and moves go through a small vtable.
+template <typename R, typename... Args, size_t Capacity, size_t Alignment>
+class inplace_function<R(Args...) noexcept, Capacity, Alignment>
+    : public detail::inplace_function_base<true, Capacity, Alignment, R, Args...> {
+    using base = detail::inplace_function_base<true, Capacity, Alignment, R, Args...>;
+
+public:
+    using base::base;
+    using base::operator=;
+};
+
+template <typename R, typename... Args, size_t Capacity, size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment>
+    : public detail::inplace_function_base<false, Capacity, Alignment, R, Args...> {
+    using base = detail::inplace_function_base<false, Capacity, Alignment, R, Args...>;
+
+public:
+    using base::base;
+    using base::operator=;
+};
+
+} // namespace stdx
@@ -0,0 +1,244 @@
+#pragma once
+#include "aligned_storage.hpp"
+#include "contiguous_iterator.hpp"
+#include "fwd.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+
+namespace stdx {
+
+// vector with a fixed capacity of `N` elements that all live inside the object, it never allocates. going over the
+// capacity is a bug and asserts, `try_emplace_back` is there for callers that would rather check. moving an
+// inplace_vector moves the elements one by one (or `memcpy`s them when trivially relocatable).
+template <typename T, size_t N>
+class inplace_vector {
+    static_assert(N > 0, "inplace_vector needs room for at least one element!");
+
+    static constexpr bool relocatable = is_trivially_relocatable_v<T>;
+
+public:
+    using size_type         = typename detail::vector_traits<T>::size_type;
+    using element_type      = typename detail::vector_traits<T>::element_type;
+    using value_type        = typename detail::vector_traits<T>::value_type;
+    using const_pointer     = typename detail::vector_traits<T>::const_pointer;
+    using const_reference   = typename detail::vector_traits<T>::const_reference;
+    using pointer           = typename detail::vector_traits<T>::pointer;
+    using reference         = typename detail::vector_traits<T>::reference;
+    using difference_type   = typename detail::vector_traits<T>::difference_type;
+    using iterator_category = typename detail::vector_traits<T>::iterator_category;
+    using index_type        = typename detail::vector_traits<T>::index_type;
+
+    using const_iterator = contiguous_iterator<true, detail::vector_traits<T>>;
+    using iterator       = contiguous_iterator<false, detail::vector_traits<T>>;
+
+    inplace_vector() noexcept = default;
+
+    explicit inplace_vector(size_type count) { resize(count); }
+    inplace_vector(size_type count, const T& value) { resize(count, value); }
+
+    template <typename Input_Iterator, typename = typename std::iterator_traits<Input_Iterator>::iterator_category>
+    inplace_vector(Input_Iterator first, Input_Iterator last) {
+        assign(first, last);
+    }
+
+    inplace_vector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    inplace_vector(const inplace_vector& other) { assign(other.data(), other.data() + other.size_); }
+
+    inplace_vector(inplace_vector&& other) noexcept { take(other); }
+
+    inplace_vector& operator=(const inplace_vector& other) {
+        if (this != &other) assign(other.data(), other.data() + other.size_);
+        return *this;
+    }
+
+    inplace_vector& operator=(inplace_vector&& other) noexcept {
+        if (this == &other) return *this;
+        clear();
+        take(other);
+        return *this;
+    }
+
+    inplace_vector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~inplace_vector() noexcept { clear(); }
+
+    template <typename Input_Iterator>
+    void assign(Input_Iterator first, Input_Iterator last) {
+        clear();
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] bool full() const noexcept { return size_ == N; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] static constexpr size_type capacity() noexcept { return N; }
+    [[nodiscard]] static constexpr size_type max_size() noexcept { return N; }
+
+    pointer data() noexcept { return reinterpret_cast<pointer>(&storage_); }
+    const_pointer data() const noexcept { return reinterpret_cast<const_pointer>(&storage_); }
+
+    reference operator[](size_type idx) noexcept {
+        STDX_ASSERT(idx < size_, "Index out of range!");
+        return data()[idx];
+    }
+
+    const_reference operator[](size_type idx) const noexcept {
+        STDX_ASSERT(idx < size_, "Index out of range!");
+        return data()[idx];
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+    reference back() noexcept { return (*this)[size_ - 1]; }
+    const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+    iterator begin() noexcept { return { data(), 0 }; }
+    iterator end() noexcept { return { data(), size_ }; }
+    const_iterator begin() const noexcept { return { data(), 0 }; }
+    const_iterator end() const noexcept { return { data(), size_ }; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // nothing to allocate, only checks that `new_capacity` fits so it can stand in for a `vector`.
+    void reserve([[maybe_unused]] size_type new_capacity) noexcept {
+        STDX_ASSERT(new_capacity <= N, "Reserving more than the inplace_vector can hold!");
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        STDX_ASSERT(size_ < N, "inplace_vector is full!");
+        return *new (data() + size_++) T(std::forward<Args>(args)...);
+    }
+
+    // returns nullptr instead of asserting when full.
+    template <typename... Args>
+    pointer try_emplace_back(Args&&... args) {
+        if (size_ == N) return nullptr;
+        return std::addressof(emplace_back(std::forward<Args>(args)...));
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        STDX_ASSERT(size_ != 0, "pop_back on an empty inplace_vector!");
+        std::destroy_at(data() + --size_);
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const auto idx = static_cast<size_type>(pos - cbegin());
+        STDX_ASSERT(idx <= size_, "Inserting out of range!");
+
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(data() + idx, data() + size_ - 1, data() + size_);
+        return { data(), idx };
+    }
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator pos) noexcept { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        const auto start = static_cast<size_type>(first - cbegin());
+        const auto count = static_cast<size_type>(last - first);
+        STDX_ASSERT(start + count <= size_, "Erasing out of range!");
+        if (count == 0) return { data(), start };
+
+        std::move(data() + start + count, data() + size_, data() + start);
+        destroy(data() + size_ - count, count);
+        size_ -= count;
+        return { data(), start };
+    }
+
+    // O(1) erase that moves the last element into the hole, does not keep the order.
+    void erase_unordered(size_type idx) noexcept {
+        STDX_ASSERT(idx < size_, "Erasing out of range!");
+        if (idx != size_ - 1) data()[idx] = std::move(data()[size_ - 1]);
+        pop_back();
+    }
+
+    void resize(size_type count) { resize_with(count, [](pointer p) { new (p) T(); }); }
+
+    void resize(size_type count, const T& value) {
+        resize_with(count, [&value](pointer p) { new (p) T(value); });
+    }
+
+    void clear() noexcept {
+        destroy(data(), size_);
+        size_ = 0;
+    }
+
+    void swap(inplace_vector& other) {
+        inplace_vector temp{ std::move(other) };
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    friend bool operator==(const inplace_vector& lhs, const inplace_vector& rhs) noexcept {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.data(), lhs.data() + lhs.size_, rhs.data());
+    }
+
+    friend bool operator!=(const inplace_vector& lhs, const inplace_vector& rhs) noexcept { return !(lhs == rhs); }
+
+private:
+    template <typename Construct>
+    void resize_with(size_type count, Construct&& construct) {
+        STDX_ASSERT(count <= N, "Resizing past the capacity of the inplace_vector!");
+        if (count < size_) {
+            destroy(data() + count, size_ - count);
+        } else {
+            for (size_type i = size_; i < count; ++i)
+                construct(data() + i);
+        }
+        size_ = count;
+    }
+
+    // takes the elements of `other`, we must be empty.
+    void take(inplace_vector& other) noexcept {
+        if constexpr (relocatable) {
+            if (other.size_ != 0) {
+                std::memcpy(
+                    static_cast<void*>(data()),
+                    static_cast<const void*>(other.data()),
+                    sizeof(T) * other.size_);
+            }
+        } else {
+            for (size_type i = 0; i < other.size_; ++i) {
+                new (data() + i) T(std::move(other.data()[i]));
+                std::destroy_at(other.data() + i);
+            }
+        }
+        size_       = other.size_;
+        other.size_ = 0;
+    }
+
+    static void destroy(pointer first, size_type count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < count; ++i)
+                std::destroy_at(first + i);
+        }
+    }
+
+private:
+    aligned_storage_t<sizeof(T) * N, alignof(T)> storage_;
+    size_type size_ = 0;
+};
+
+template <typename T, size_t N>
+struct is_trivially_relocatable<inplace_vector<T, N>> : is_trivially_relocatable<T> {};
+
+} // namespace stdx
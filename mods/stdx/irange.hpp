@@ -2,6 +2,8 @@
 #pragma once
 #include "stdx/function_ref.hpp"
 #include "type_traits.hpp"
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
 
 namespace stdx {
@@ -0,0 +1,164 @@
+#pragma once
+#include "fwd.hpp"
+#include "irange.hpp"
+#include "span.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace stdx {
+
+namespace detail {
+
+// state of one fork-join loop, lives on the stack of the thread that started it. every helper grabs `grain` sized
+// chunks until none are left and then reports back, after which it never touches the loop again.
+template <typename Fn>
+struct parallel_loop {
+    Fn& fn;
+    size_t count;
+    size_t grain;
+    std::atomic<size_t> next         = 0;
+    std::atomic<size_t> helpers_done = 0;
+
+    void run_chunks() {
+        for (;;) {
+            const size_t first = next.fetch_add(grain, std::memory_order_relaxed);
+            if (first >= count) return;
+            fn(first, std::min(count, first + grain));
+        }
+    }
+
+    static void help(void* context) {
+        auto* loop = static_cast<parallel_loop*>(context);
+        loop->run_chunks();
+        loop->helpers_done.fetch_add(1, std::memory_order_release);
+    }
+};
+
+// calls `fn(first, last)` for consecutive chunks of at most `grain` indices covering [0, count). the calling thread
+// takes chunks too and keeps running queued tasks while it waits, so nesting parallel loops can't deadlock.
+template <typename Fn>
+void parallel_chunks(size_t count, size_t grain, Fn&& fn) {
+    STDX_ASSERT(grain != 0, "Grain size has to be at least 1!");
+    const size_t chunks = (count + grain - 1) / grain;
+
+    auto& pool           = worker_pool();
+    const size_t helpers = chunks == 0 ? 0 : std::min(pool.worker_count(), chunks - 1);
+    if (helpers == 0) {
+        for (size_t first = 0; first < count; first += grain)
+            fn(first, std::min(count, first + grain));
+        return;
+    }
+
+    parallel_loop<std::remove_reference_t<Fn>> loop{ fn, count, grain };
+    pool.submit({ &loop.help, &loop }, helpers);
+    loop.run_chunks();
+
+    while (loop.helpers_done.load(std::memory_order_acquire) != helpers) {
+        if (!pool.try_run_one()) std::this_thread::yield();
+    }
+}
+
+// one chunk's result, wrapped so a `bool` reduction doesn't end up in a `std::vector<bool>` whose packed bits chunks
+// would race on.
+template <typename T>
+struct reduce_partial {
+    T value;
+};
+
+} // namespace detail
+
+// `fn(i)` for every `i` in `range`, spread over the worker pool `grain` indices at a time. pick a grain large enough
+// that a chunk is worth more than handing it to another thread.
+template <typename I, typename Fn>
+void parallel_for(integer_range<I> range, size_t grain, Fn&& fn) {
+    const I first = *range.begin();
+    const I last  = *range.end();
+    if (last <= first) return;
+
+    detail::parallel_chunks(static_cast<size_t>(last - first), grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            fn(static_cast<I>(first + static_cast<I>(i)));
+    });
+}
+
+// `fn(value)` for every element of `values`.
+template <typename T, typename Fn>
+void parallel_for(span<T> values, size_t grain, Fn&& fn) {
+    T* data = values.data();
+    detail::parallel_chunks(values.size(), grain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            fn(data[i]);
+    });
+}
+
+// folds `map(i)` over `range` with `reduce`. every chunk starts from `identity`, so it has to be neutral for
+// `reduce`. chunk results are combined in order, `reduce` only needs to be associative.
+template <typename I, typename T, typename Map, typename Reduce>
+T parallel_reduce(integer_range<I> range, size_t grain, T identity, Map&& map, Reduce&& reduce) {
+    STDX_ASSERT(grain != 0, "Grain size has to be at least 1!");
+    const I first = *range.begin();
+    const I last  = *range.end();
+    if (last <= first) return identity;
+
+    const auto count = static_cast<size_t>(last - first);
+    std::vector<detail::reduce_partial<T>> partials((count + grain - 1) / grain, { identity });
+    detail::parallel_chunks(count, grain, [&](size_t begin, size_t end) {
+        T result = identity;
+        for (size_t i = begin; i < end; ++i)
+            result = reduce(std::move(result), map(static_cast<I>(first + static_cast<I>(i))));
+        partials[begin / grain].value = std::move(result);
+    });
+
+    T result = std::move(identity);
+    for (auto& partial : partials)
+        result = reduce(std::move(result), std::move(partial.value));
+    return result;
+}
+
+// same as above with `map(value)` for every element of `values`.
+template <typename T, typename U, typename Map, typename Reduce>
+U parallel_reduce(span<T> values, size_t grain, U identity, Map&& map, Reduce&& reduce) {
+    T* data = values.data();
+    return parallel_reduce(
+        irange(size_t{ 0 }, values.size()),
+        grain,
+        std::move(identity),
+        [&](size_t i) { return map(data[i]); },
+        std::forward<Reduce>(reduce));
+}
+
+// sorts runs of at least `grain` elements on separate workers, then merges neighbouring runs pairwise until one is
+// left. not stable, like `std::sort`.
+template <typename T, typename Compare = std::less<>>
+void parallel_sort(span<T> values, size_t grain, Compare comp = {}) {
+    STDX_ASSERT(grain != 0, "Grain size has to be at least 1!");
+    T* data           = values.data();
+    const size_t size = values.size();
+    const size_t runs = std::clamp<size_t>(size / grain, 1, worker_pool().worker_count() + 1);
+    if (runs == 1) {
+        std::sort(data, data + size, comp);
+        return;
+    }
+
+    auto bound = [size, runs](size_t run) { return size * std::min(run, runs) / runs; };
+
+    detail::parallel_chunks(runs, 1, [&](size_t run, size_t) {
+        std::sort(data + bound(run), data + bound(run + 1), comp);
+    });
+
+    for (size_t width = 1; width < runs; width *= 2) {
+        const size_t merges = (runs + 2 * width - 1) / (2 * width);
+        detail::parallel_chunks(merges, 1, [&](size_t merge, size_t) {
+            const size_t run = merge * 2 * width;
+            std::inplace_merge(data + bound(run), data + bound(run + width), data + bound(run + 2 * width), comp);
+        });
+    }
+}
+
+} // namespace stdx
@@ -0,0 +1,78 @@
+#pragma once
+#include "hash.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace stdx {
+
+inline constexpr uint32_t PIPELINE_CACHE_MAGIC   = 0x43'4c'50'5a; // "ZPLC"
+inline constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+// written in front of the driver's data. the driver is supposed to reject data it can't use on its own but not every
+// driver does so safely, truncated, corrupt or foreign files never get that far.
+struct pipeline_cache_header {
+    uint32_t magic     = PIPELINE_CACHE_MAGIC;
+    uint32_t version   = PIPELINE_CACHE_VERSION;
+    uint32_t vendor_id = 0;
+    uint32_t device_id = 0;
+    uint8_t uuid[VK_UUID_SIZE]{};
+    uint64_t data_size = 0;
+    uint64_t data_hash = 0;
+};
+
+// the header for `size` bytes of driver data at `data`, made on the device described by the ids and `uuid`.
+inline pipeline_cache_header make_pipeline_cache_header(
+    uint32_t vendor_id,
+    uint32_t device_id,
+    const uint8_t (&uuid)[VK_UUID_SIZE],
+    const void* data,
+    size_t size) noexcept {
+    pipeline_cache_header header{};
+    header.vendor_id = vendor_id;
+    header.device_id = device_id;
+    std::memcpy(header.uuid, uuid, VK_UUID_SIZE);
+    header.data_size = size;
+    header.data_hash = hash_bytes(data, size);
+    return header;
+}
+
+// the reason `file` can't be used on the device described by the ids and `uuid`, `nullptr` when `data` was set to the
+// part that goes to the driver.
+inline const char* pipeline_cache_reject_reason(
+    std::string_view file,
+    uint32_t vendor_id,
+    uint32_t device_id,
+    const uint8_t (&uuid)[VK_UUID_SIZE],
+    std::string_view& data) noexcept {
+    pipeline_cache_header header{};
+    if (file.size() < sizeof(header)) return "truncated header";
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (header.magic != PIPELINE_CACHE_MAGIC) return "not a pipeline cache";
+    if (header.version != PIPELINE_CACHE_VERSION) return "unknown version";
+    if (header.vendor_id != vendor_id || header.device_id != device_id) return "made for another device";
+    if (std::memcmp(header.uuid, uuid, VK_UUID_SIZE) != 0) return "made for another driver";
+    if (header.data_size != file.size() - sizeof(header)) return "truncated data";
+
+    const std::string_view payload = file.substr(sizeof(header));
+    if (hash_bytes(payload.data(), payload.size()) != header.data_hash) return "corrupt data";
+
+    // every driver starts its data with this header, checked here as well since not every driver does.
+    VkPipelineCacheHeaderVersionOne driver{};
+    if (payload.size() < sizeof(driver)) return "truncated driver header";
+    std::memcpy(&driver, payload.data(), sizeof(driver));
+
+    if (driver.headerSize < sizeof(driver) || driver.headerSize > payload.size()) return "bad driver header size";
+    if (driver.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) return "unknown driver header version";
+    if (driver.vendorID != vendor_id || driver.deviceID != device_id) return "driver data for another device";
+    if (std::memcmp(driver.pipelineCacheUUID, uuid, VK_UUID_SIZE) != 0) return "driver data for another driver";
+
+    data = payload;
+    return nullptr;
+}
+
+} // namespace stdx
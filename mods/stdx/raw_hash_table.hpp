@@ -0,0 +1,615 @@
+#pragma once
+#include "aligned_storage.hpp"
+#include "fwd.hpp"
+#include "hash.hpp"
+#include "type_traits.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STDX_HASH_TABLE_SSE2 1
+#include <emmintrin.h>
+#else
+#define STDX_HASH_TABLE_SSE2 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace stdx {
+
+namespace detail {
+
+// every slot has a control byte. full slots store the low 7 bits of the hash, so most mismatches are rejected
+// without touching the slot itself.
+using ctrl_t = signed char;
+
+inline constexpr ctrl_t CTRL_EMPTY    = -128;
+inline constexpr ctrl_t CTRL_DELETED  = -2;
+inline constexpr ctrl_t CTRL_SENTINEL = -1;
+
+inline constexpr size_t GROUP_WIDTH = 16;
+
+inline bool is_full(ctrl_t ctrl) noexcept { return ctrl >= 0; }
+
+inline uint32_t lowest_bit_index(uint32_t mask) noexcept {
+    STDX_ASSERT(mask != 0, "Mask has no bits set!");
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return static_cast<uint32_t>(idx);
+#else
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+}
+
+// 16 control bytes that are probed together, one bit per matching slot in the returned masks.
+class ctrl_group {
+public:
+#if STDX_HASH_TABLE_SSE2
+    explicit ctrl_group(const ctrl_t* ctrl) noexcept :
+        ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    uint32_t match(ctrl_t h2) const noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+    }
+
+    uint32_t match_empty() const noexcept { return match(CTRL_EMPTY); }
+
+    // empty and deleted are the only control bytes below the sentinel.
+    uint32_t match_empty_or_deleted() const noexcept {
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(CTRL_SENTINEL), ctrl_)));
+    }
+
+private:
+    __m128i ctrl_;
+#else
+    explicit ctrl_group(const ctrl_t* ctrl) noexcept { std::memcpy(ctrl_, ctrl, GROUP_WIDTH); }
+
+    uint32_t match(ctrl_t h2) const noexcept {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+            mask |= static_cast<uint32_t>(ctrl_[i] == h2) << i;
+        return mask;
+    }
+
+    uint32_t match_empty() const noexcept { return match(CTRL_EMPTY); }
+
+    uint32_t match_empty_or_deleted() const noexcept {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+            mask |= static_cast<uint32_t>(ctrl_[i] < CTRL_SENTINEL) << i;
+        return mask;
+    }
+
+private:
+    ctrl_t ctrl_[GROUP_WIDTH];
+#endif
+};
+
+// picks the type heterogeneous lookups take. when the hash and equality are not transparent it collapses to
+// `Key` so that lookups still convert their argument once up front.
+template <bool Transparent>
+struct key_arg_impl {
+    template <typename K, typename Key>
+    using type = Key;
+};
+
+template <>
+struct key_arg_impl<true> {
+    template <typename K, typename Key>
+    using type = K;
+};
+
+// Open addressing hash table shared by `flat_hash_map` and `flat_hash_set` (swiss table layout). slots are split
+// into groups of 16 and probed a group at a time, quadratically over groups. `Policy` tells the table what a slot
+// holds and how to move it between allocations.
+template <typename Policy, typename Hash, typename Eq, typename Allocator>
+class raw_hash_table {
+protected:
+    using slot_type      = typename Policy::slot_type;
+    using slot_storage   = typed_aligned_storage_t<slot_type>;
+    using alloc_traits   = std::allocator_traits<Allocator>;
+    using slot_allocator = typename alloc_traits::template rebind_alloc<slot_storage>;
+    using slot_traits    = std::allocator_traits<slot_allocator>;
+
+    static constexpr size_t npos         = static_cast<size_t>(-1);
+    static constexpr bool transparent    = is_transparent_v<Hash> && is_transparent_v<Eq>;
+    static constexpr size_t MIN_CAPACITY = GROUP_WIDTH;
+
+    template <typename K>
+    using key_arg = typename key_arg_impl<transparent>::template type<K, typename Policy::key_type>;
+
+public:
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using size_type       = size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher          = Hash;
+    using key_equal       = Eq;
+    using allocator_type  = Allocator;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+
+private:
+    template <bool Const>
+    class iterator_impl {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = typename raw_hash_table::value_type;
+        using difference_type   = std::ptrdiff_t;
+        static constexpr bool is_const = Const || Policy::constant_iterators;
+
+        using reference = std::conditional_t<is_const, const value_type&, value_type&>;
+        using pointer   = std::conditional_t<is_const, const value_type*, value_type*>;
+
+        iterator_impl() noexcept = default;
+
+        // iterator -> const_iterator.
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        iterator_impl(const iterator_impl<OtherConst>& other) noexcept : ctrl_(other.ctrl_), slot_(other.slot_) {}
+
+        reference operator*() const noexcept { return *slot_; }
+        pointer operator->() const noexcept { return slot_; }
+
+        iterator_impl& operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            skip_empty_or_deleted();
+            return *this;
+        }
+
+        iterator_impl operator++(int) noexcept {
+            iterator_impl self = *this;
+            ++(*this);
+            return self;
+        }
+
+        friend bool operator==(const iterator_impl& lhs, const iterator_impl& rhs) noexcept {
+            return lhs.ctrl_ == rhs.ctrl_;
+        }
+
+        friend bool operator!=(const iterator_impl& lhs, const iterator_impl& rhs) noexcept { return !(lhs == rhs); }
+
+    private:
+        friend class raw_hash_table;
+
+        template <bool>
+        friend class iterator_impl;
+
+        iterator_impl(ctrl_t* ctrl, slot_type* slot) noexcept : ctrl_(ctrl), slot_(slot) {}
+
+        // the control bytes end with a group of sentinels, so this always stops at `end()`.
+        void skip_empty_or_deleted() noexcept {
+            while (true) {
+                const uint32_t full = ~ctrl_group(ctrl_).match_empty_or_deleted() & 0xffff;
+                if (full != 0) {
+                    const uint32_t shift = lowest_bit_index(full);
+                    ctrl_ += shift;
+                    slot_ += shift;
+                    return;
+                }
+                ctrl_ += GROUP_WIDTH;
+                slot_ += GROUP_WIDTH;
+            }
+        }
+
+        ctrl_t* ctrl_    = nullptr;
+        slot_type* slot_ = nullptr;
+    };
+
+public:
+    using iterator       = iterator_impl<false>;
+    using const_iterator = iterator_impl<true>;
+
+    raw_hash_table() noexcept(noexcept(Hash()) && noexcept(Eq()) && noexcept(Allocator())) = default;
+
+    explicit raw_hash_table(
+        size_type capacity, const Hash& hash = Hash(), const Eq& eq = Eq(), const Allocator& allocator = Allocator()) :
+        hash_(hash), eq_(eq), allocator_(allocator) {
+        reserve(capacity);
+    }
+
+    explicit raw_hash_table(const Allocator& allocator) : allocator_(allocator) {}
+
+    template <typename Input_Iterator>
+    raw_hash_table(
+        Input_Iterator first,
+        Input_Iterator last,
+        size_type capacity         = 0,
+        const Hash& hash           = Hash(),
+        const Eq& eq               = Eq(),
+        const Allocator& allocator = Allocator()) :
+        raw_hash_table(capacity, hash, eq, allocator) {
+        insert(first, last);
+    }
+
+    raw_hash_table(
+        std::initializer_list<value_type> init,
+        size_type capacity         = 0,
+        const Hash& hash           = Hash(),
+        const Eq& eq               = Eq(),
+        const Allocator& allocator = Allocator()) :
+        raw_hash_table(init.begin(), init.end(), capacity, hash, eq, allocator) {}
+
+    raw_hash_table(const raw_hash_table& other) :
+        hash_(other.hash_), eq_(other.eq_),
+        allocator_(alloc_traits::select_on_container_copy_construction(other.allocator_)) {
+        copy_from(other);
+    }
+
+    raw_hash_table(raw_hash_table&& other) noexcept :
+        ctrl_(std::exchange(other.ctrl_, nullptr)), slots_(std::exchange(other.slots_, nullptr)),
+        size_(std::exchange(other.size_, 0)), capacity_(std::exchange(other.capacity_, 0)),
+        growth_left_(std::exchange(other.growth_left_, 0)), hash_(std::move(other.hash_)), eq_(std::move(other.eq_)),
+        allocator_(std::move(other.allocator_)) {}
+
+    raw_hash_table& operator=(const raw_hash_table& other) {
+        if (this == &other) return *this;
+        destroy_and_release();
+        hash_ = other.hash_;
+        eq_   = other.eq_;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) allocator_ = other.allocator_;
+        copy_from(other);
+        return *this;
+    }
+
+    raw_hash_table& operator=(raw_hash_table&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this == &other) return *this;
+        destroy_and_release();
+        hash_ = std::move(other.hash_);
+        eq_   = std::move(other.eq_);
+
+        if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+            if (allocator_ != other.allocator_) {
+                // can't take memory that we are not able to give back, move the elements instead.
+                reserve(other.size_);
+                for (auto& value : other)
+                    emplace_with_key(Policy::key(value), std::move(value));
+                other.clear();
+                return *this;
+            }
+        } else {
+            allocator_ = std::move(other.allocator_);
+        }
+
+        ctrl_        = std::exchange(other.ctrl_, nullptr);
+        slots_       = std::exchange(other.slots_, nullptr);
+        size_        = std::exchange(other.size_, 0);
+        capacity_    = std::exchange(other.capacity_, 0);
+        growth_left_ = std::exchange(other.growth_left_, 0);
+        return *this;
+    }
+
+    ~raw_hash_table() noexcept { destroy_and_release(); }
+
+    iterator begin() noexcept {
+        if (size_ == 0) return end();
+        iterator it{ ctrl_, slots_ };
+        it.skip_empty_or_deleted();
+        return it;
+    }
+
+    iterator end() noexcept { return { ctrl_ + capacity_, slots_ + capacity_ }; }
+    const_iterator begin() const noexcept { return const_cast<raw_hash_table*>(this)->begin(); }
+    const_iterator end() const noexcept { return const_cast<raw_hash_table*>(this)->end(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+    float load_factor() const noexcept { return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_; }
+    static constexpr float max_load_factor() noexcept { return 7.0f / 8.0f; }
+
+    hasher hash_function() const noexcept { return hash_; }
+    key_equal key_eq() const noexcept { return eq_; }
+    allocator_type get_allocator() const noexcept { return allocator_; }
+
+    // makes room for `count` elements without rehashing.
+    void reserve(size_type count) {
+        if (count <= size_ + growth_left_) return;
+        size_type capacity = MIN_CAPACITY;
+        while (max_load(capacity) < count)
+            capacity *= 2;
+        resize(capacity);
+    }
+
+    // destroys every element but keeps the memory around.
+    void clear() noexcept {
+        if (capacity_ == 0) return;
+        destroy_slots();
+        reset_ctrl();
+        size_        = 0;
+        growth_left_ = max_load(capacity_);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) { return emplace_with_key(Policy::key(value), value); }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+        return emplace_with_key(Policy::key(value), std::move(value));
+    }
+
+    template <typename Input_Iterator>
+    void insert(Input_Iterator first, Input_Iterator last) {
+        for (; first != last; ++first)
+            emplace(*first);
+    }
+
+    void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+    // builds the value first to find its key, prefer `insert` or `try_emplace` when the key is at hand.
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {
+        slot_storage storage;
+        auto* temp = reinterpret_cast<slot_type*>(&storage);
+        alloc_traits::construct(allocator_, temp, std::forward<Args>(args)...);
+
+        const auto [idx, inserted] = find_or_prepare_insert(Policy::key(*temp));
+        if (inserted) {
+            Policy::transfer(allocator_, slots_ + idx, temp);
+        } else {
+            alloc_traits::destroy(allocator_, temp);
+        }
+        return { iterator_at(idx), inserted };
+    }
+
+    template <typename K = key_type>
+    iterator find(const key_arg<K>& key) noexcept {
+        const size_t idx = find_index(key, hash_(key));
+        return idx == npos ? end() : iterator_at(idx);
+    }
+
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K>& key) const noexcept {
+        return const_cast<raw_hash_table*>(this)->find(key);
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K>& key) const noexcept {
+        return find_index(key, hash_(key)) != npos;
+    }
+
+    template <typename K = key_type>
+    size_type count(const key_arg<K>& key) const noexcept {
+        return contains(key) ? 1 : 0;
+    }
+
+    iterator erase(const_iterator pos) noexcept {
+        STDX_ASSERT(pos != end(), "Erasing end()!");
+        const auto idx = static_cast<size_t>(pos.slot_ - slots_);
+        erase_at(idx);
+
+        // the slot stays where it is, so the iterator just moves on.
+        iterator next{ ctrl_ + idx, slots_ + idx };
+        ++next;
+        return next;
+    }
+
+    iterator erase(iterator pos) noexcept { return erase(const_iterator{ pos }); }
+
+    template <typename K = key_type>
+    size_type erase(const key_arg<K>& key) noexcept {
+        const size_t idx = find_index(key, hash_(key));
+        if (idx == npos) return 0;
+        erase_at(idx);
+        return 1;
+    }
+
+    void swap(raw_hash_table& other) noexcept {
+        using std::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+        swap(growth_left_, other.growth_left_);
+        swap(hash_, other.hash_);
+        swap(eq_, other.eq_);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            swap(allocator_, other.allocator_);
+        } else {
+            STDX_ASSERT(allocator_ == other.allocator_, "Swapping tables with different allocators!");
+        }
+    }
+
+protected:
+    // inserts a slot built from `args` if `key` is not in the table yet.
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> emplace_with_key(const K& key, Args&&... args) {
+        const auto [idx, inserted] = find_or_prepare_insert(key);
+        if (inserted) alloc_traits::construct(allocator_, slots_ + idx, std::forward<Args>(args)...);
+        return { iterator_at(idx), inserted };
+    }
+
+    iterator iterator_at(size_t idx) noexcept { return { ctrl_ + idx, slots_ + idx }; }
+
+    template <typename K>
+    size_t find_index(const K& key, size_t hash) const noexcept {
+        if (capacity_ == 0) return npos;
+
+        const size_t group_mask = capacity_ / GROUP_WIDTH - 1;
+        size_t group            = h1(hash) & group_mask;
+        for (size_t step = 1;; ++step) {
+            const size_t base = group * GROUP_WIDTH;
+            const ctrl_group ctrl{ ctrl_ + base };
+            for (uint32_t mask = ctrl.match(h2(hash)); mask != 0; mask &= mask - 1) {
+                const size_t idx = base + lowest_bit_index(mask);
+                if (eq_(Policy::key(slots_[idx]), key)) return idx;
+            }
+            // the key would have gone into this group if it was ever inserted.
+            if (ctrl.match_empty() != 0) return npos;
+            group = (group + step) & group_mask;
+        }
+    }
+
+    // index of the slot holding `key`, or a freshly claimed slot where the caller has to construct it.
+    template <typename K>
+    std::pair<size_t, bool> find_or_prepare_insert(const K& key) {
+        const size_t hash = hash_(key);
+        const size_t idx  = find_index(key, hash);
+        if (idx != npos) return { idx, false };
+        return { prepare_insert(hash), true };
+    }
+
+private:
+    static size_t h1(size_t hash) noexcept { return hash >> 7; }
+    static ctrl_t h2(size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7f); }
+
+    // keeps at least 1/8 of the slots empty so every probe sequence ends.
+    static size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+    size_t find_first_non_full(size_t hash) const noexcept {
+        const size_t group_mask = capacity_ / GROUP_WIDTH - 1;
+        size_t group            = h1(hash) & group_mask;
+        for (size_t step = 1;; ++step) {
+            const size_t base   = group * GROUP_WIDTH;
+            const uint32_t mask = ctrl_group(ctrl_ + base).match_empty_or_deleted();
+            if (mask != 0) return base + lowest_bit_index(mask);
+            group = (group + step) & group_mask;
+        }
+    }
+
+    size_t prepare_insert(size_t hash) {
+        size_t idx = capacity_ == 0 ? npos : find_first_non_full(hash);
+        // reusing a tombstone doesn't use up any growth.
+        if (growth_left_ == 0 && (idx == npos || ctrl_[idx] != CTRL_DELETED)) {
+            grow();
+            idx = find_first_non_full(hash);
+        }
+
+        growth_left_ -= ctrl_[idx] == CTRL_EMPTY;
+        ctrl_[idx] = h2(hash);
+        ++size_;
+        return idx;
+    }
+
+    void erase_at(size_t idx) noexcept {
+        alloc_traits::destroy(allocator_, slots_ + idx);
+        --size_;
+
+        // a group only fills up once, after that probes may walk past it. if it still has an empty slot nobody did,
+        // so the slot can go back to empty instead of leaving a tombstone.
+        const size_t base = idx & ~(GROUP_WIDTH - 1);
+        if (ctrl_group(ctrl_ + base).match_empty() != 0) {
+            ctrl_[idx] = CTRL_EMPTY;
+            ++growth_left_;
+        } else {
+            ctrl_[idx] = CTRL_DELETED;
+        }
+    }
+
+    void grow() {
+        if (capacity_ == 0) {
+            resize(MIN_CAPACITY);
+        } else if (size_ <= max_load(capacity_) / 2) {
+            // mostly tombstones, squeeze them out without growing.
+            resize(capacity_);
+        } else {
+            resize(capacity_ * 2);
+        }
+    }
+
+    void resize(size_t new_capacity) {
+        ctrl_t* old_ctrl         = ctrl_;
+        slot_type* old_slots     = slots_;
+        const size_t old_capacity = capacity_;
+
+        allocate(new_capacity);
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (!is_full(old_ctrl[i])) continue;
+            const size_t hash = hash_(Policy::key(old_slots[i]));
+            const size_t idx  = find_first_non_full(hash);
+            ctrl_[idx]        = h2(hash);
+            Policy::transfer(allocator_, slots_ + idx, old_slots + i);
+        }
+        growth_left_ -= size_;
+
+        deallocate(old_slots, old_capacity);
+    }
+
+    void copy_from(const raw_hash_table& other) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.capacity_; ++i) {
+            if (!is_full(other.ctrl_[i])) continue;
+            const size_t hash = hash_(Policy::key(other.slots_[i]));
+            const size_t idx  = find_first_non_full(hash);
+            ctrl_[idx]        = h2(hash);
+            alloc_traits::construct(allocator_, slots_ + idx, other.slots_[i]);
+        }
+        size_ = other.size_;
+        growth_left_ -= size_;
+    }
+
+    // control bytes live right after the slots in the same allocation, followed by a group of sentinels so that
+    // iteration and unaligned group loads never run off the end.
+    static size_t allocation_size(size_t capacity) noexcept {
+        const size_t ctrl_bytes = capacity + GROUP_WIDTH;
+        return capacity + (ctrl_bytes + sizeof(slot_storage) - 1) / sizeof(slot_storage);
+    }
+
+    void allocate(size_t capacity) {
+        slot_allocator allocator{ allocator_ };
+        slot_storage* memory = slot_traits::allocate(allocator, allocation_size(capacity));
+
+        slots_       = reinterpret_cast<slot_type*>(memory);
+        ctrl_        = reinterpret_cast<ctrl_t*>(memory + capacity);
+        capacity_    = capacity;
+        growth_left_ = max_load(capacity);
+        reset_ctrl();
+    }
+
+    void deallocate(slot_type* slots, size_t capacity) noexcept {
+        if (capacity == 0) return;
+        slot_allocator allocator{ allocator_ };
+        slot_traits::deallocate(allocator, reinterpret_cast<slot_storage*>(slots), allocation_size(capacity));
+    }
+
+    void reset_ctrl() noexcept {
+        std::memset(ctrl_, static_cast<unsigned char>(CTRL_EMPTY), capacity_);
+        std::memset(ctrl_ + capacity_, static_cast<unsigned char>(CTRL_SENTINEL), GROUP_WIDTH);
+    }
+
+    void destroy_slots() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+            for (size_t i = 0; i < capacity_; ++i) {
+                if (is_full(ctrl_[i])) alloc_traits::destroy(allocator_, slots_ + i);
+            }
+        }
+    }
+
+    void destroy_and_release() noexcept {
+        destroy_slots();
+        deallocate(slots_, capacity_);
+        ctrl_        = nullptr;
+        slots_       = nullptr;
+        size_        = 0;
+        capacity_    = 0;
+        growth_left_ = 0;
+    }
+
+private:
+    ctrl_t* ctrl_       = nullptr;
+    slot_type* slots_   = nullptr;
+    size_t size_        = 0;
+    size_t capacity_    = 0;
+    size_t growth_left_ = 0;
+
+    Hash hash_           = {};
+    Eq eq_               = {};
+    Allocator allocator_ = {};
+};
+
+} // namespace detail
+
+} // namespace stdx
@@ -0,0 +1,114 @@
+#pragma once
+#include "fwd.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace stdx {
+
+// fixed set of worker threads draining one shared fifo of tasks. tasks are a function pointer and a context, the
+// pool never owns what the context points to, whoever submits makes sure it outlives the task.
+class thread_pool {
+public:
+    struct task {
+        void (*run)(void*) = nullptr;
+        void* context      = nullptr;
+    };
+
+    explicit thread_pool(size_t worker_count) {
+        workers_.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i)
+            workers_.emplace_back([this]() { work(); });
+    }
+
+    thread_pool(const thread_pool&)            = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool() noexcept {
+        {
+            std::lock_guard lock{ mutex_ };
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_)
+            worker.join();
+    }
+
+    [[nodiscard]] size_t worker_count() const noexcept { return workers_.size(); }
+
+    // queues `count` copies of `t`, handy for fanning the same loop out to several workers.
+    void submit(task t, size_t count = 1) {
+        if (count == 0) return;
+        {
+            std::lock_guard lock{ mutex_ };
+            tasks_.insert(tasks_.end(), count, t);
+        }
+        if (count == 1) {
+            wake_.notify_one();
+        } else {
+            wake_.notify_all();
+        }
+    }
+
+    // runs one queued task on the calling thread, used to make progress instead of blocking while waiting.
+    bool try_run_one() {
+        task t;
+        {
+            std::lock_guard lock{ mutex_ };
+            if (tasks_.empty()) return false;
+            t = tasks_.front();
+            tasks_.pop_front();
+        }
+        t.run(t.context);
+        return true;
+    }
+
+private:
+    void work() {
+        for (;;) {
+            task t;
+            {
+                std::unique_lock lock{ mutex_ };
+                wake_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) return;
+                t = tasks_.front();
+                tasks_.pop_front();
+            }
+            t.run(t.context);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<task> tasks_;
+    bool stopping_ = false;
+
+    std::vector<std::thread> workers_;
+};
+
+namespace detail {
+inline std::atomic<size_t> requested_worker_count = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+inline std::atomic<bool> worker_pool_started      = false;
+} // namespace detail
+
+// the pool shared by the parallel algorithms, started on first use.
+inline thread_pool& worker_pool() {
+    detail::worker_pool_started = true;
+    static thread_pool pool{ detail::requested_worker_count };
+    return pool;
+}
+
+// number of threads `worker_pool` starts with, the thread calling into a parallel algorithm always helps out so one
+// less than the core count keeps every core busy. has to be called before anything uses the pool.
+inline void set_worker_count(size_t count) noexcept {
+    STDX_ASSERT(!detail::worker_pool_started, "Worker pool is already running!");
+    detail::requested_worker_count = count;
+}
+
+} // namespace stdx
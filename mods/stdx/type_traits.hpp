@@ -52,4 +52,12 @@ using is_contiguous_container = std::void_t<
     std::enable_if<std::is_same_v<decltype(std::declval<T>().size()), typename T::size_type>, bool>,
     stdx::is_container<T>>;
 
+// types that can be moved to a new address with a `memcpy`, skipping the destructor of the old object. specialize it
+// for types that are not trivially copyable but don't care about their own address, e.g. owning handles.
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 } // namespace stdx
@@ -1,98 +1,413 @@
 #pragma once
+#include "fwd.hpp"
+#include "type_traits.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <type_traits>
 #include <utility>
+
 namespace stdx {
 
+struct monostate {};
+
+constexpr bool operator==(monostate, monostate) noexcept { return true; }
+constexpr bool operator!=(monostate, monostate) noexcept { return false; }
+
+template <typename... Ts>
+class variant;
+
+template <typename T>
+struct variant_size;
+
+template <typename... Ts>
+struct variant_size<variant<Ts...>> : std::integral_constant<size_t, sizeof...(Ts)> {};
+
+template <typename T>
+constexpr size_t variant_size_v = variant_size<std::remove_cv_t<T>>::value;
+
+template <size_t I, typename T>
+struct variant_alternative;
+
+template <size_t I, typename First, typename... Others>
+struct variant_alternative<I, variant<First, Others...>> : variant_alternative<I - 1, variant<Others...>> {};
+
+template <typename First, typename... Others>
+struct variant_alternative<0, variant<First, Others...>> {
+    using type = First;
+};
+
+template <size_t I, typename T>
+using variant_alternative_t = typename variant_alternative<I, T>::type;
+
 namespace detail {
 
-template <typename... All>
-struct variant_leaf {};
+// recursive union so that every alternative can be constructed in a constant expression. the destructor has to be
+// trivial for the variant to stay a literal type, hence the two versions.
+template <bool TriviallyDestructible, typename... Ts>
+union variant_union {};
 
 template <typename First, typename... Others>
-struct variant_leaf<First, Others...> {
+union variant_union<true, First, Others...> {
+    constexpr variant_union() noexcept : empty{} {}
 
-    variant_leaf() : value_{} {}
+    template <typename... Args>
+    constexpr variant_union(std::in_place_index_t<0>, Args&&... args) : head(std::forward<Args>(args)...) {}
 
-    template <size_t Size, typename T, typename... Args>
-    constexpr size_t emplace(Args&&... args) noexcept {
-        if constexpr (std::is_same_v<std::decay_t<T>, std::decay_t<First>>) {
-            new T(std::addressof(value_.f), std::forward<Args&&>(args)...);
-            return Size;
-        } else {
-            return value_.o.template emplace<Size + 1, T>(std::forward<Args&&>(args)...);
+    template <size_t I, typename... Args>
+    constexpr variant_union(std::in_place_index_t<I>, Args&&... args) :
+        tail(std::in_place_index<I - 1>, std::forward<Args>(args)...) {}
+
+    char empty;
+    First head;
+    variant_union<true, Others...> tail;
+};
+
+template <typename First, typename... Others>
+union variant_union<false, First, Others...> {
+    constexpr variant_union() noexcept : empty{} {}
+
+    template <typename... Args>
+    constexpr variant_union(std::in_place_index_t<0>, Args&&... args) : head(std::forward<Args>(args)...) {}
+
+    template <size_t I, typename... Args>
+    constexpr variant_union(std::in_place_index_t<I>, Args&&... args) :
+        tail(std::in_place_index<I - 1>, std::forward<Args>(args)...) {}
+
+    // the variant destroys the active member.
+    ~variant_union() noexcept {}
+
+    char empty;
+    First head;
+    variant_union<false, Others...> tail;
+};
+
+// resolves to a reference at compile time, there is no runtime recursion left after inlining.
+template <size_t I, typename Union>
+constexpr decltype(auto) get_alternative(Union&& storage) noexcept {
+    if constexpr (I == 0) {
+        return (std::forward<Union>(storage).head);
+    } else {
+        return get_alternative<I - 1>(std::forward<Union>(storage).tail);
+    }
+}
+
+// picks the alternative a converting constructor goes to the same way overload resolution would.
+template <size_t I, typename T>
+struct overload_leaf {
+    std::integral_constant<size_t, I> operator()(T) const;
+};
+
+template <typename Sequence, typename... Ts>
+struct overload_set;
+
+template <size_t... Is, typename... Ts>
+struct overload_set<std::index_sequence<Is...>, Ts...> : overload_leaf<Is, Ts>... {
+    using overload_leaf<Is, Ts>::operator()...;
+};
+
+template <typename Arg, typename... Ts>
+using best_alternative =
+    decltype(overload_set<std::index_sequence_for<Ts...>, Ts...>{}(std::declval<Arg>()));
+
+template <typename T, typename... Ts>
+constexpr size_t index_of() noexcept {
+    constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+    size_t found             = sizeof...(Ts);
+    for (size_t i = 0; i < sizeof...(Ts); ++i) {
+        if (matches[i]) {
+            // every alternative type has to be unique to be looked up by type.
+            if (found != sizeof...(Ts)) return sizeof...(Ts);
+            found = i;
         }
     }
+    return found;
+}
+
+template <size_t I, typename R, typename Visitor, typename Variant>
+constexpr R visit_alternative(Visitor&& visitor, Variant&& v) {
+    return std::forward<Visitor>(visitor)(std::forward<Variant>(v).template get<I>());
+}
+
+// one function pointer per alternative, indexed by `index()`. every alternative costs the same to dispatch to and
+// the whole thing folds away when the index is known at compile time.
+template <typename Visitor, typename Variant, size_t... Is>
+constexpr decltype(auto) visit_table(Visitor&& visitor, Variant&& v, std::index_sequence<Is...>) {
+    using result_type   = decltype(std::forward<Visitor>(visitor)(std::forward<Variant>(v).template get<0>()));
+    using function_type = result_type (*)(Visitor&&, Variant&&);
+
+    constexpr function_type table[] = { &visit_alternative<Is, result_type, Visitor, Variant>... };
+    return table[v.index()](std::forward<Visitor>(visitor), std::forward<Variant>(v));
+}
+
+// destroys the active alternative through the same kind of table `visit` uses.
+template <typename Union, size_t... Is>
+void destroy_alternative(Union& storage, size_t index, std::index_sequence<Is...>) noexcept {
+    using function_type             = void (*)(Union&);
+    constexpr function_type table[] = { [](Union& u) { std::destroy_at(std::addressof(get_alternative<Is>(u))); }... };
+    table[index](storage);
+}
+
+template <size_t Count>
+using variant_index_t = std::conditional_t<(Count < 256), unsigned char, unsigned short>;
+
+// owns the storage and the index, destroys the active alternative only when one of them needs it so that a variant
+// of trivially destructible types is trivially destructible too.
+template <typename Index, bool TriviallyDestructible, typename... Ts>
+struct variant_base {
+    template <size_t I, typename... Args>
+    constexpr variant_base(std::in_place_index_t<I>, Args&&... args) :
+        storage_(std::in_place_index<I>, std::forward<Args>(args)...), index_(static_cast<Index>(I)) {}
+
+    // leaves the storage uninitialized, the variant constructs the alternative itself.
+    constexpr explicit variant_base(Index index) noexcept : storage_(), index_(index) {}
+
+    void destroy() noexcept {}
+
+    variant_union<true, Ts...> storage_;
+    Index index_;
+};
+
+template <typename Index, typename... Ts>
+struct variant_base<Index, false, Ts...> {
+    template <size_t I, typename... Args>
+    constexpr variant_base(std::in_place_index_t<I>, Args&&... args) :
+        storage_(std::in_place_index<I>, std::forward<Args>(args)...), index_(static_cast<Index>(I)) {}
+
+    // leaves the storage uninitialized, the variant constructs the alternative itself.
+    constexpr explicit variant_base(Index index) noexcept : storage_(), index_(index) {}
+
+    ~variant_base() noexcept { destroy(); }
+
+    void destroy() noexcept { destroy_alternative(storage_, index_, std::index_sequence_for<Ts...>{}); }
+
+    variant_union<false, Ts...> storage_;
+    Index index_;
+};
+
+} // namespace detail
+
+// Tagged union without the valueless state of `std::variant`, nothing in here throws. trivially destructible
+// alternatives keep the variant trivially destructible and usable in constant expressions, and trivially copyable
+// ones are copied as raw bytes. alternatives are dispatched to through a jump table (see `visit`).
+template <typename... Ts>
+class variant :
+    private detail::variant_base<
+        detail::variant_index_t<sizeof...(Ts)>,
+        (std::is_trivially_destructible_v<Ts> && ...),
+        Ts...> {
+    static_assert(sizeof...(Ts) > 0, "variant needs at least one alternative");
 
-    template <size_t Size>
-    decltype(auto) get() noexcept {
-        if constexpr (Size == 0) {
-            return value_.f;
+    static constexpr bool trivially_copyable = (std::is_trivially_copyable_v<Ts> && ...);
+
+    using index_type = detail::variant_index_t<sizeof...(Ts)>;
+    using base       = detail::variant_base<index_type, (std::is_trivially_destructible_v<Ts> && ...), Ts...>;
+
+    template <size_t I>
+    using alternative = variant_alternative_t<I, variant>;
+
+    template <typename T>
+    static constexpr size_t index_of = detail::index_of<T, Ts...>();
+
+public:
+    // value initializes the first alternative.
+    constexpr variant() noexcept : base(std::in_place_index<0>) {}
+
+    template <
+        typename T,
+        typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, variant>>,
+        size_t I = detail::best_alternative<T&&, Ts...>::value>
+    constexpr variant(T&& value) noexcept : base(std::in_place_index<I>, std::forward<T>(value)) {}
+
+    template <size_t I, typename... Args>
+    constexpr explicit variant(std::in_place_index_t<I>, Args&&... args) noexcept :
+        base(std::in_place_index<I>, std::forward<Args>(args)...) {}
+
+    template <typename T, typename... Args>
+    constexpr explicit variant(std::in_place_type_t<T>, Args&&... args) noexcept :
+        variant(std::in_place_index<index_of<T>>, std::forward<Args>(args)...) {}
+
+    variant(const variant& other) noexcept : base(other.index_) {
+        if constexpr (trivially_copyable) {
+            storage_ = other.storage_;
         } else {
-            return value_.o.template get<Size - 1>();
+            other.visit([this](const auto& value) { construct(value); });
         }
     }
 
-    template <typename Callable>
-    decltype(auto) visit(Callable&& c, size_t idx) noexcept {
-        if (idx == 0) {
-            return c(value_.f);
+    variant(variant&& other) noexcept : base(other.index_) {
+        if constexpr (trivially_copyable) {
+            storage_ = other.storage_;
         } else {
-            return value_.o.visit(std::forward<Callable&&>(c), idx - 1);
+            std::move(other).visit([this](auto&& value) { construct(std::move(value)); });
         }
     }
 
-    void destruct(size_t idx) noexcept {
-        if (idx != 0) {
-            destruct(idx - 1);
+    variant& operator=(const variant& other) noexcept {
+        if (this == &other) return *this;
+        if constexpr (trivially_copyable) {
+            storage_ = other.storage_;
+            index_   = other.index_;
         } else {
-            std::destroy_at(std::addressof(value_.f));
+            destroy();
+            index_ = other.index_;
+            other.visit([this](const auto& value) { construct(value); });
         }
+        return *this;
     }
 
-    union {
-        First f;
-        variant_leaf<Others...> o;
-    } value_;
-};
+    variant& operator=(variant&& other) noexcept {
+        if (this == &other) return *this;
+        if constexpr (trivially_copyable) {
+            storage_ = other.storage_;
+            index_   = other.index_;
+        } else {
+            destroy();
+            index_ = other.index_;
+            std::move(other).visit([this](auto&& value) { construct(std::move(value)); });
+        }
+        return *this;
+    }
 
-} // namespace detail
-  //
-  //
+    template <
+        typename T,
+        typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, variant>>,
+        size_t I = detail::best_alternative<T&&, Ts...>::value>
+    variant& operator=(T&& value) noexcept {
+        if (index_ == I) {
+            get<I>() = std::forward<T>(value);
+        } else {
+            emplace<I>(std::forward<T>(value));
+        }
+        return *this;
+    }
 
-struct monostate {};
+    template <size_t I, typename... Args>
+    alternative<I>& emplace(Args&&... args) noexcept {
+        destroy();
+        index_ = static_cast<index_type>(I);
+        return *::new (static_cast<void*>(std::addressof(get<I>()))) alternative<I>(std::forward<Args>(args)...);
+    }
 
-// should this type pack be unique?
-template <typename... Ts>
-class variant {
-public:
     template <typename T, typename... Args>
-    void emplace(Args&&... args) noexcept {
-        idx_ = args_.template emplace<0, T>(std::forward<Args&&>(args)...);
+    T& emplace(Args&&... args) noexcept {
+        return emplace<index_of<T>>(std::forward<Args>(args)...);
     }
 
-    template <size_t Size>
-    decltype(auto) get() noexcept {
-        return args_.template get<Size>();
+    constexpr size_t index() const noexcept { return index_; }
+
+    template <typename T>
+    constexpr bool holds_alternative() const noexcept {
+        return index_ == index_of<T>;
     }
 
-    template <typename Callable>
-    decltype(auto) visit(Callable&& c) noexcept {
-        return args_.visit(std::forward<Callable&&>(c), idx_);
+    template <size_t I>
+    constexpr alternative<I>& get() & noexcept {
+        STDX_ASSERT(index_ == I, "Getting an alternative that the variant does not hold!");
+        return detail::get_alternative<I>(storage_);
     }
 
-    ~variant() noexcept { args_.destruct(idx_); }
+    template <size_t I>
+    constexpr const alternative<I>& get() const& noexcept {
+        STDX_ASSERT(index_ == I, "Getting an alternative that the variant does not hold!");
+        return detail::get_alternative<I>(storage_);
+    }
+
+    template <size_t I>
+    constexpr alternative<I>&& get() && noexcept {
+        STDX_ASSERT(index_ == I, "Getting an alternative that the variant does not hold!");
+        return detail::get_alternative<I>(std::move(storage_));
+    }
 
     template <typename T>
-    variant(T&& arg) noexcept : idx_(0), args_{} {
-        emplace<std::decay_t<T>>(std::forward<T&&>(arg));
+    constexpr T& get() & noexcept {
+        return get<index_of<T>>();
+    }
+
+    template <typename T>
+    constexpr const T& get() const& noexcept {
+        return get<index_of<T>>();
+    }
+
+    template <typename Callable>
+    constexpr decltype(auto) visit(Callable&& callable) & {
+        return detail::visit_table(std::forward<Callable>(callable), *this, std::index_sequence_for<Ts...>{});
     }
 
-    variant() noexcept : idx_(0), args_{ 0 } {}
+    template <typename Callable>
+    constexpr decltype(auto) visit(Callable&& callable) const& {
+        return detail::visit_table(std::forward<Callable>(callable), *this, std::index_sequence_for<Ts...>{});
+    }
+
+    template <typename Callable>
+    constexpr decltype(auto) visit(Callable&& callable) && {
+        return detail::visit_table(
+            std::forward<Callable>(callable),
+            std::move(*this),
+            std::index_sequence_for<Ts...>{});
+    }
 
 private:
-    size_t idx_                       = 0;
-    detail::variant_leaf<Ts...> args_ = {};
+    // constructs a copy of `value` in the alternative `index_` already points at.
+    template <typename T>
+    void construct(T&& value) noexcept {
+        using value_type = std::remove_cv_t<std::remove_reference_t<T>>;
+        ::new (static_cast<void*>(std::addressof(storage_))) value_type(std::forward<T>(value));
+    }
+
+    using base::destroy;
+    using base::index_;
+    using base::storage_;
 };
 
+template <typename T, typename... Ts>
+constexpr bool holds_alternative(const variant<Ts...>& v) noexcept {
+    return v.template holds_alternative<T>();
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(variant<Ts...>& v) noexcept {
+    return v.template get<I>();
+}
+
+template <size_t I, typename... Ts>
+constexpr decltype(auto) get(const variant<Ts...>& v) noexcept {
+    return v.template get<I>();
+}
+
+template <typename T, typename... Ts>
+constexpr decltype(auto) get(variant<Ts...>& v) noexcept {
+    return v.template get<T>();
+}
+
+template <typename T, typename... Ts>
+constexpr decltype(auto) get(const variant<Ts...>& v) noexcept {
+    return v.template get<T>();
+}
+
+template <size_t I, typename... Ts>
+constexpr auto* get_if(variant<Ts...>* v) noexcept {
+    return v != nullptr && v->index() == I ? std::addressof(v->template get<I>()) : nullptr;
+}
+
+template <typename T, typename... Ts>
+constexpr T* get_if(variant<Ts...>* v) noexcept {
+    return v != nullptr && v->template holds_alternative<T>() ? std::addressof(v->template get<T>()) : nullptr;
+}
+
+template <typename T, typename... Ts>
+constexpr const T* get_if(const variant<Ts...>* v) noexcept {
+    return v != nullptr && v->template holds_alternative<T>() ? std::addressof(v->template get<T>()) : nullptr;
+}
+
+template <typename Callable, typename Variant>
+constexpr decltype(auto) visit(Callable&& callable, Variant&& v) {
+    return std::forward<Variant>(v).visit(std::forward<Callable>(callable));
+}
+
+// a variant only points into itself when one of its alternatives does.
+template <typename... Ts>
+struct is_trivially_relocatable<variant<Ts...>> : std::bool_constant<(is_trivially_relocatable_v<Ts> && ...)> {};
+
 } // namespace stdx
@@ -1,7 +1,13 @@
 #pragma once
+#include "aligned_storage.hpp"
 #include "contiguous_iterator.hpp"
 #include "fwd.hpp"
 #include "type_traits.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
 
 namespace stdx {
@@ -21,10 +27,34 @@ struct vector_traits {
     using iterator_category        = std::random_access_iterator_tag;
     using index_type               = size_type;
 };
+
+template <typename T, size_t N>
+struct vector_inline_storage {
+    T* inline_data() noexcept { return reinterpret_cast<T*>(&storage); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(&storage); }
+
+    aligned_storage_t<sizeof(T) * N, alignof(T)> storage;
+};
+
+// no inline storage, takes no space as a base.
+template <typename T>
+struct vector_inline_storage<T, 0> {
+    T* inline_data() noexcept { return nullptr; }
+    const T* inline_data() const noexcept { return nullptr; }
+};
 } // namespace detail
 
-template <typename T, typename Allocator = std::allocator<T>>
-class vector {
+// `std::vector` look alike that keeps the first `InlineCapacity` elements inside the object and only goes to
+// `Allocator` once it outgrows them. trivially relocatable types are moved around with `memcpy` when growing.
+// unlike `std::vector`, moving a vector that still uses its inline storage moves the elements one by one, so
+// iterators into it don't survive the move.
+template <typename T, typename Allocator = std::allocator<T>, size_t InlineCapacity = 0>
+class vector : private detail::vector_inline_storage<T, InlineCapacity> {
+    using storage_type = detail::vector_inline_storage<T, InlineCapacity>;
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static constexpr bool relocatable = is_trivially_relocatable_v<T>;
+
 public:
     using size_type         = typename detail::vector_traits<T>::size_type;
     using element_type      = typename detail::vector_traits<T>::element_type;
@@ -36,16 +66,307 @@ public:
     using difference_type   = typename detail::vector_traits<T>::difference_type;
     using iterator_category = typename detail::vector_traits<T>::iterator_category;
     using index_type        = typename detail::vector_traits<T>::index_type;
+    using allocator_type    = Allocator;
 
     using const_iterator = contiguous_iterator<true, detail::vector_traits<T>>;
     using iterator       = contiguous_iterator<false, detail::vector_traits<T>>;
 
+    static constexpr size_type inline_capacity = InlineCapacity;
+
+    vector() noexcept(noexcept(Allocator())) : vector(Allocator()) {}
+
+    explicit vector(const Allocator& allocator) noexcept :
+        data_(storage_type::inline_data()), capacity_(InlineCapacity), allocator_(allocator) {}
+
+    explicit vector(size_type count, const Allocator& allocator = Allocator()) : vector(allocator) { resize(count); }
+
+    vector(size_type count, const T& value, const Allocator& allocator = Allocator()) : vector(allocator) {
+        resize(count, value);
+    }
+
+    template <typename Input_Iterator, typename = typename std::iterator_traits<Input_Iterator>::iterator_category>
+    vector(Input_Iterator first, Input_Iterator last, const Allocator& allocator = Allocator()) : vector(allocator) {
+        assign(first, last);
+    }
+
+    vector(std::initializer_list<T> init, const Allocator& allocator = Allocator()) : vector(allocator) {
+        assign(init.begin(), init.end());
+    }
+
+    vector(const vector& other) : vector(alloc_traits::select_on_container_copy_construction(other.allocator_)) {
+        assign(other.data_, other.data_ + other.size_);
+    }
+
+    vector(vector&& other) noexcept : vector(std::move(other.allocator_)) { take(other); }
+
+    vector& operator=(const vector& other) {
+        if (this == &other) return *this;
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+            if (allocator_ != other.allocator_) {
+                clear();
+                release();
+            }
+            allocator_ = other.allocator_;
+        }
+        assign(other.data_, other.data_ + other.size_);
+        return *this;
+    }
+
+    vector& operator=(vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) {
+        if (this == &other) return *this;
+        clear();
+        if constexpr (!alloc_traits::propagate_on_container_move_assignment::value) {
+            if (allocator_ != other.allocator_) {
+                // can't take memory that we are not able to give back, move the elements instead.
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+                return *this;
+            }
+        }
+        release();
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            allocator_ = std::move(other.allocator_);
+        }
+        take(other);
+        return *this;
+    }
+
+    vector& operator=(std::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~vector() noexcept {
+        clear();
+        release();
+    }
+
+    template <typename Input_Iterator>
+    void assign(Input_Iterator first, Input_Iterator last) {
+        clear();
+        if constexpr (std::is_base_of_v<
+                          std::forward_iterator_tag,
+                          typename std::iterator_traits<Input_Iterator>::iterator_category>) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first)
+            emplace_back(*first);
+    }
+
     [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
-    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+    [[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool is_inline() const noexcept { return data_ == storage_type::inline_data(); }
+
+    pointer data() noexcept { return data_; }
+    const_pointer data() const noexcept { return data_; }
+
+    allocator_type get_allocator() const noexcept { return allocator_; }
+
+    reference operator[](size_type idx) noexcept {
+        STDX_ASSERT(idx < size_, "Index out of range!");
+        return data_[idx];
+    }
+
+    const_reference operator[](size_type idx) const noexcept {
+        STDX_ASSERT(idx < size_, "Index out of range!");
+        return data_[idx];
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+    reference back() noexcept { return (*this)[size_ - 1]; }
+    const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+    iterator begin() noexcept { return { data_, 0 }; }
+    iterator end() noexcept { return { data_, size_ }; }
+    const_iterator begin() const noexcept { return { data_, 0 }; }
+    const_iterator end() const noexcept { return { data_, size_ }; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) reallocate(new_capacity);
+    }
+
+    // gives heap memory back, moving the elements into the inline storage if they fit.
+    void shrink_to_fit() {
+        if (is_inline() || size_ == capacity_) return;
+        if (size_ <= InlineCapacity) {
+            pointer old_data         = data_;
+            const size_type capacity = capacity_;
+            relocate(old_data, size_, storage_type::inline_data());
+            alloc_traits::deallocate(allocator_, old_data, capacity);
+            data_     = storage_type::inline_data();
+            capacity_ = InlineCapacity;
+        } else {
+            reallocate(size_);
+        }
+    }
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) return emplace_back_grow(std::forward<Args>(args)...);
+        alloc_traits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
+        return data_[size_++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept {
+        STDX_ASSERT(size_ != 0, "pop_back on an empty vector!");
+        alloc_traits::destroy(allocator_, data_ + --size_);
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args) {
+        const auto idx = static_cast<size_type>(pos - cbegin());
+        STDX_ASSERT(idx <= size_, "Inserting out of range!");
+
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(data_ + idx, data_ + size_ - 1, data_ + size_);
+        return { data_, idx };
+    }
+
+    iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+    iterator erase(const_iterator pos) noexcept { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        const auto start = static_cast<size_type>(first - cbegin());
+        const auto count = static_cast<size_type>(last - first);
+        STDX_ASSERT(start + count <= size_, "Erasing out of range!");
+        if (count == 0) return { data_, start };
+
+        std::move(data_ + start + count, data_ + size_, data_ + start);
+        destroy(data_ + size_ - count, count);
+        size_ -= count;
+        return { data_, start };
+    }
+
+    // swaps with the last element instead of shifting everything after `pos` down.
+    void erase_unordered(size_type idx) noexcept {
+        STDX_ASSERT(idx < size_, "Erasing out of range!");
+        if (idx != size_ - 1) data_[idx] = std::move(data_[size_ - 1]);
+        pop_back();
+    }
+
+    void resize(size_type count) { resize_with(count, [this](pointer p) { alloc_traits::construct(allocator_, p); }); }
+
+    void resize(size_type count, const T& value) {
+        resize_with(count, [this, &value](pointer p) { alloc_traits::construct(allocator_, p, value); });
+    }
+
+    void clear() noexcept {
+        destroy(data_, size_);
+        size_ = 0;
+    }
+
+    void swap(vector& other) {
+        vector temp{ std::move(other) };
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    friend bool operator==(const vector& lhs, const vector& rhs) noexcept {
+        return lhs.size_ == rhs.size_ && std::equal(lhs.data_, lhs.data_ + lhs.size_, rhs.data_);
+    }
+
+    friend bool operator!=(const vector& lhs, const vector& rhs) noexcept { return !(lhs == rhs); }
+
+private:
+    size_type next_capacity(size_type required) const noexcept {
+        return std::max<size_type>({ required, capacity_ * 2, 4 });
+    }
+
+    template <typename... Args>
+    reference emplace_back_grow(Args&&... args) {
+        // construct first, `args` may point into the storage we are about to move out of.
+        const size_type new_capacity = next_capacity(size_ + 1);
+        pointer new_data             = alloc_traits::allocate(allocator_, new_capacity);
+        alloc_traits::construct(allocator_, new_data + size_, std::forward<Args>(args)...);
+        adopt(new_data, new_capacity);
+        return data_[size_++];
+    }
+
+    template <typename Construct>
+    void resize_with(size_type count, Construct&& construct) {
+        if (count < size_) {
+            destroy(data_ + count, size_ - count);
+        } else if (count > size_) {
+            if (count > capacity_) reallocate(next_capacity(count));
+            for (size_type i = size_; i < count; ++i)
+                construct(data_ + i);
+        }
+        size_ = count;
+    }
+
+    void reallocate(size_type new_capacity) {
+        adopt(alloc_traits::allocate(allocator_, new_capacity), new_capacity);
+    }
+
+    // moves the elements over to `new_data` and releases the old memory.
+    void adopt(pointer new_data, size_type new_capacity) noexcept {
+        relocate(data_, size_, new_data);
+        release();
+        data_     = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void relocate(pointer from, size_type count, pointer to) noexcept {
+        if constexpr (relocatable) {
+            if (count != 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(T) * count);
+        } else {
+            for (size_type i = 0; i < count; ++i) {
+                alloc_traits::construct(allocator_, to + i, std::move_if_noexcept(from[i]));
+                alloc_traits::destroy(allocator_, from + i);
+            }
+        }
+    }
+
+    void destroy(pointer first, size_type count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < count; ++i)
+                alloc_traits::destroy(allocator_, first + i);
+        }
+    }
+
+    // frees heap memory, elements must already be gone.
+    void release() noexcept {
+        if (!is_inline()) alloc_traits::deallocate(allocator_, data_, capacity_);
+        data_     = storage_type::inline_data();
+        capacity_ = InlineCapacity;
+    }
+
+    // takes the elements of `other`, which has to use an allocator equal to ours. heap memory changes hands, inline
+    // elements are relocated one by one.
+    void take(vector& other) noexcept {
+        if (other.is_inline()) {
+            relocate(other.data_, other.size_, data_);
+            size_ = other.size_;
+        } else {
+            data_     = other.data_;
+            size_     = other.size_;
+            capacity_ = other.capacity_;
+
+            other.data_     = other.storage_type::inline_data();
+            other.capacity_ = InlineCapacity;
+        }
+        other.size_ = 0;
+    }
 
 private:
-    T* data_;
-    size_t size_;
+    pointer data_        = nullptr;
+    size_type size_      = 0;
+    size_type capacity_  = 0;
+    Allocator allocator_ = {};
 };
 
+// vector that stays off the heap as long as it holds at most `N` elements.
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+using small_vector = vector<T, Allocator, N>;
+
 } // namespace stdx
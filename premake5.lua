@@ -1,5 +1,6 @@
 require("lua/plugs")
 require("lua/globals")
+require("lua/shaders")
 
 workspace "mayo"
 architecture "x86_64"
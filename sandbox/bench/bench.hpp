@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "spdlog/spdlog.h"
+
+namespace bench {
+
+// keeps the optimizer from throwing away the work being measured.
+template <typename Type>
+inline void do_not_optimize(const Type& value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile auto* sink = &reinterpret_cast<const volatile char&>(value);
+    (void)*sink;
+    _ReadWriteBarrier();
+#endif
+}
+
+// runs `fn` `iterations` times and logs the average time per iteration.
+template <typename Fn>
+double run(std::string_view name, size_t iterations, Fn&& fn) noexcept {
+    fn(); // warm up caches and the allocator.
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+        fn();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+    spdlog::info("{:<48} {:>12.1f} ns/iter", name, ns);
+    return ns;
+}
+
+// every benchmark suite, called from `main` when the sandbox is started with `--bench`.
+void vector_benchmarks() noexcept;
+void hash_map_benchmarks() noexcept;
+void job_system_benchmarks() noexcept;
+
+} // namespace bench
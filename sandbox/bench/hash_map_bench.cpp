@@ -0,0 +1,95 @@
+#include "bench.hpp"
+
+#include "stdx/flat_hash_map.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+constexpr size_t KEY_COUNT  = 10'000;
+constexpr size_t ITERATIONS = 100;
+
+// stand in for a vulkan create info, the kind of key the render caches hash.
+struct Sampler_Key {
+    uint32_t mag_filter;
+    uint32_t min_filter;
+    uint32_t address_mode[3];
+    float max_anisotropy;
+    float min_lod;
+    float max_lod;
+};
+
+template <typename Map, typename Key>
+void run_suite(std::string_view name, const std::vector<Key>& keys) noexcept {
+    // look keys up in a different order than they went in, node based maps otherwise walk memory linearly.
+    std::vector<const Key*> lookups(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+        lookups[i] = &keys[i];
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937{ 7 });
+
+    Map map;
+    run(std::string(name) + " insert", ITERATIONS, [&] {
+        map.clear();
+        for (size_t i = 0; i < keys.size(); ++i)
+            map[keys[i]] = static_cast<uint32_t>(i);
+    });
+
+    run(std::string(name) + " lookup", ITERATIONS, [&] {
+        uint32_t sum = 0;
+        for (const Key* key : lookups)
+            sum += map.find(*key)->second;
+        do_not_optimize(sum);
+    });
+
+    run(std::string(name) + " erase + insert", ITERATIONS, [&] {
+        for (const auto& key : keys)
+            map.erase(key);
+        for (size_t i = 0; i < keys.size(); ++i)
+            map[keys[i]] = static_cast<uint32_t>(i);
+    });
+}
+
+} // namespace
+
+void hash_map_benchmarks() noexcept {
+    spdlog::info("-- hash map ({} keys) --", KEY_COUNT);
+
+    std::mt19937_64 rng{ 42 };
+
+    std::vector<uint64_t> ints(KEY_COUNT);
+    for (auto& key : ints)
+        key = rng();
+    run_suite<std::unordered_map<uint64_t, uint32_t>>("std::unordered_map<u64>", ints);
+    run_suite<stdx::flat_hash_map<uint64_t, uint32_t>>("stdx::flat_hash_map<u64>", ints);
+
+    std::vector<std::string> strings(KEY_COUNT);
+    for (auto& key : strings)
+        key = "static/shaders/" + std::to_string(rng()) + ".frag";
+    run_suite<std::unordered_map<std::string, uint32_t>>("std::unordered_map<string>", strings);
+    run_suite<stdx::flat_hash_map<std::string, uint32_t>>("stdx::flat_hash_map<string>", strings);
+
+    std::vector<Sampler_Key> samplers(KEY_COUNT);
+    for (auto& key : samplers) {
+        key                 = {};
+        key.mag_filter      = static_cast<uint32_t>(rng() % 2);
+        key.address_mode[0] = static_cast<uint32_t>(rng() % 4);
+        key.max_lod         = static_cast<float>(rng() % 1024);
+        key.min_lod         = static_cast<float>(rng());
+    }
+    // same hash for both so only the containers differ.
+    using Sampler_Hash  = stdx::pod_hash<Sampler_Key>;
+    using Sampler_Equal = stdx::pod_equal<Sampler_Key>;
+    using Std_Sampler_Map  = std::unordered_map<Sampler_Key, uint32_t, Sampler_Hash, Sampler_Equal>;
+    using Stdx_Sampler_Map = stdx::flat_hash_map<Sampler_Key, uint32_t, Sampler_Hash, Sampler_Equal>;
+    run_suite<Std_Sampler_Map>("std::unordered_map<pod>", samplers);
+    run_suite<Stdx_Sampler_Map>("stdx::flat_hash_map<pod>", samplers);
+}
+
+} // namespace bench
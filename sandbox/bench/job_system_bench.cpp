@@ -0,0 +1,96 @@
+#include "bench.hpp"
+
+#include "jobs/job_system.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+constexpr uint32_t JOB_COUNT  = 4096;
+constexpr uint32_t ROOT_JOBS  = 64;
+constexpr uint32_t WORK_STEPS = 10'000;
+constexpr size_t ITERATIONS   = 5;
+
+// around 10us of pure arithmetic, no memory traffic to get in the way of scaling.
+uint64_t busy_work(uint64_t seed) noexcept {
+    for (uint32_t i = 0; i < WORK_STEPS; ++i)
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+    return seed;
+}
+
+struct Scaling_Result {
+    double ns       = 0;
+    uint64_t steals = 0;
+};
+
+// every job is scheduled from the main thread, the workers have to steal all of them.
+Scaling_Result flat(uint32_t threads, std::vector<uint64_t>& results) noexcept {
+    jobs::job_system system{ threads };
+    const double ns = run(std::to_string(threads) + " threads, flat", ITERATIONS, [&] {
+        jobs::job_group group;
+        for (uint32_t i = 0; i < JOB_COUNT; ++i)
+            system.run(group, [&results, i] { results[i] = busy_work(i); });
+        system.wait(group);
+        do_not_optimize(results.data());
+    });
+
+    Scaling_Result result{ ns, 0 };
+    for (uint32_t i = 0; i < threads; ++i)
+        result.steals += system.stats(i).steals;
+    return result;
+}
+
+// a few root jobs that each fan out, spreading work has to happen between workers too.
+Scaling_Result nested(uint32_t threads, std::vector<uint64_t>& results) noexcept {
+    jobs::job_system system{ threads };
+    const double ns = run(std::to_string(threads) + " threads, nested", ITERATIONS, [&] {
+        jobs::job_group group;
+        for (uint32_t root = 0; root < ROOT_JOBS; ++root) {
+            system.run(group, [&system, &group, &results, root] {
+                for (uint32_t i = root * (JOB_COUNT / ROOT_JOBS); i < (root + 1) * (JOB_COUNT / ROOT_JOBS); ++i)
+                    system.run(group, [&results, i] { results[i] = busy_work(i); });
+            });
+        }
+        system.wait(group);
+        do_not_optimize(results.data());
+    });
+
+    Scaling_Result result{ ns, 0 };
+    for (uint32_t i = 0; i < threads; ++i)
+        result.steals += system.stats(i).steals;
+    return result;
+}
+
+} // namespace
+
+void job_system_benchmarks() noexcept {
+    std::vector<uint64_t> results(JOB_COUNT);
+    const uint32_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    double flat_baseline   = 0;
+    double nested_baseline = 0;
+    for (uint32_t threads = 1; threads <= max_threads; ++threads) {
+        const Scaling_Result flat_result   = flat(threads, results);
+        const Scaling_Result nested_result = nested(threads, results);
+        if (threads == 1) {
+            flat_baseline   = flat_result.ns;
+            nested_baseline = nested_result.ns;
+        }
+
+        spdlog::info(
+            "{:>2} threads: flat {:.2f}x ({} steals), nested {:.2f}x ({} steals)",
+            threads,
+            flat_baseline / flat_result.ns,
+            flat_result.steals,
+            nested_baseline / nested_result.ns,
+            nested_result.steals);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,91 @@
+#include "bench.hpp"
+
+#include "stdx/arena_allocator.hpp"
+#include "stdx/vector.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+constexpr size_t ITERATIONS = 100'000;
+
+// bump allocator that is reset after every iteration.
+struct Scratch_Arena {
+    void* allocate(size_t size, size_t alignment) noexcept {
+        offset        = (offset + alignment - 1) & ~(alignment - 1);
+        void* pointer = offset + size <= CAPACITY ? memory.get() + offset : nullptr;
+        offset += size;
+        return pointer;
+    }
+
+    static constexpr size_t CAPACITY = 1 << 20;
+
+    std::unique_ptr<char[]> memory = std::make_unique<char[]>(CAPACITY);
+    size_t offset                  = 0;
+};
+
+struct Handle {
+    std::unique_ptr<int> value;
+};
+
+} // namespace
+
+} // namespace bench
+
+// owning handles don't care about their address, let the vector `memcpy` them around.
+template <>
+struct stdx::is_trivially_relocatable<bench::Handle> : std::true_type {};
+
+namespace bench {
+
+namespace {
+
+template <typename Vector>
+void push_small(size_t count) noexcept {
+    Vector values;
+    for (size_t i = 0; i < count; ++i)
+        values.push_back(static_cast<int>(i));
+    do_not_optimize(values);
+}
+
+template <typename Vector>
+void grow_handles() noexcept {
+    Vector handles;
+    for (int i = 0; i < 256; ++i)
+        handles.push_back(Handle{ std::make_unique<int>(i) });
+    do_not_optimize(handles);
+}
+
+} // namespace
+
+void vector_benchmarks() noexcept {
+    spdlog::info("-- vector --");
+
+    run("std::vector<int> push 4", ITERATIONS, [] { push_small<std::vector<int>>(4); });
+    run("stdx::vector<int> push 4", ITERATIONS, [] { push_small<stdx::vector<int>>(4); });
+    run("stdx::small_vector<int, 8> push 4", ITERATIONS, [] { push_small<stdx::small_vector<int, 8>>(4); });
+
+    run("std::vector<int> push 64", ITERATIONS, [] { push_small<std::vector<int>>(64); });
+    run("stdx::vector<int> push 64", ITERATIONS, [] { push_small<stdx::vector<int>>(64); });
+    run("stdx::small_vector<int, 8> push 64", ITERATIONS, [] { push_small<stdx::small_vector<int, 8>>(64); });
+
+    // growth has to move every element, relocation turns that into a single `memcpy`.
+    run("std::vector<Handle> grow 256", ITERATIONS / 10, [] { grow_handles<std::vector<Handle>>(); });
+    run("stdx::vector<Handle> grow 256", ITERATIONS / 10, [] { grow_handles<stdx::vector<Handle>>(); });
+
+    Scratch_Arena arena;
+    using Arena_Vector = stdx::vector<int, stdx::arena_allocator<int, Scratch_Arena>>;
+    run("stdx::vector<int, arena> push 64", ITERATIONS, [&arena] {
+        Arena_Vector values{ arena };
+        for (int i = 0; i < 64; ++i)
+            values.push_back(i);
+        do_not_optimize(values);
+        arena.offset = 0;
+    });
+}
+
+} // namespace bench
@@ -1,10 +1,13 @@
 #include "stdx/span.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <optional>
 
+#include "bench/bench.hpp"
 #include "spdlog/spdlog.h"
 #include "sut/shader_compiler.hpp"
+#include "test/test.hpp"
 
 stdx::expected<std::string, std::runtime_error> read_file(std::string_view filename) noexcept {
     std::ifstream file{ filename.data(), std::ios::ate | std::ios::binary };
@@ -21,7 +24,20 @@ stdx::expected<std::string, std::runtime_error> read_file(std::string_view filen
     return buffer;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        bench::vector_benchmarks();
+        bench::hash_map_benchmarks();
+        bench::job_system_benchmarks();
+        return 0;
+    }
+
+    if (argc > 1 && std::strcmp(argv[1], "--test") == 0) {
+        int failures = 0;
+        failures += test::inplace_function_tests();
+        return failures == 0 ? 0 : 1;
+    }
+
     spdlog::info("hello world");
     auto vertex_bytes = read_file("static/shaders/test.vert");
     assert(vertex_bytes && "vertex shader must have value!");
@@ -22,6 +22,7 @@ project "sandbox"
     }
 
     links {
+        "jobs",
         "%{library_dir.vulkan}"
     }
 
@@ -37,6 +38,7 @@ project "sandbox"
         kind "ConsoleApp"
         systemversion "latest"
         defines {}
+        links { "pthread" }
 
     filter "configurations:Debug"
         defines { "ZOO_ENABLE_LOGS" }
@@ -0,0 +1,75 @@
+#include "test.hpp"
+
+#include "stdx/inplace_function.hpp"
+
+#include <memory>
+#include <string>
+
+namespace test {
+
+namespace {
+
+struct Counter {
+    int value = 0;
+};
+
+} // namespace
+
+int inplace_function_tests() noexcept {
+    int failures = 0;
+
+    // lvalues bind to reference parameters and the callable sees the caller's object.
+    {
+        stdx::inplace_function<void(Counter&)> bump = [](Counter& counter) { ++counter.value; };
+        Counter counter{};
+        bump(counter);
+        bump(counter);
+        TEST_CHECK(failures, counter.value == 2);
+    }
+
+    // const lvalues are passed through without a copy.
+    {
+        stdx::inplace_function<const Counter*(const Counter&)> address = [](const Counter& counter) {
+            return &counter;
+        };
+        const Counter counter{ 7 };
+        TEST_CHECK(failures, address(counter) == &counter);
+    }
+
+    // by value parameters accept lvalues, which get copied, and move only rvalues.
+    {
+        stdx::inplace_function<size_t(std::string)> length = [](std::string text) { return text.size(); };
+        const std::string text = "inplace";
+        TEST_CHECK(failures, length(text) == 7);
+        TEST_CHECK(failures, text == "inplace");
+
+        stdx::inplace_function<int(std::unique_ptr<int>)> take = [](std::unique_ptr<int> value) { return *value; };
+        TEST_CHECK(failures, take(std::make_unique<int>(3)) == 3);
+    }
+
+    // rvalue reference parameters are forwarded as rvalues and the callable can steal from them.
+    {
+        stdx::inplace_function<std::string(std::string&&)> steal = [](std::string&& text) { return std::move(text); };
+        std::string text = "moved from";
+        TEST_CHECK(failures, steal(std::move(text)) == "moved from");
+    }
+
+    // a mix of reference and value parameters in one signature.
+    {
+        stdx::inplace_function<void(Counter&, const Counter&, int)> add = [](Counter& to,
+                                                                              const Counter& from,
+                                                                              int scale) {
+            to.value += from.value * scale;
+        };
+        Counter to{ 1 };
+        const Counter from{ 2 };
+        int scale = 3;
+        add(to, from, scale);
+        TEST_CHECK(failures, to.value == 7);
+    }
+
+    spdlog::info("inplace_function: {} failures", failures);
+    return failures;
+}
+
+} // namespace test
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "spdlog/spdlog.h"
+
+namespace test {
+
+// logs a failed check and bumps `failures`, the suites keep going so one run reports every broken check.
+#define TEST_CHECK(failures, condition)                                                                                \
+    do {                                                                                                               \
+        if (!(condition)) {                                                                                            \
+            spdlog::error("{}:{} check failed: {}", __FILE__, __LINE__, #condition);                                   \
+            ++(failures);                                                                                              \
+        }                                                                                                              \
+    } while (false)
+
+// every test suite, called from `main` when the sandbox is started with `--test`. each returns its failure count.
+int inplace_function_tests() noexcept;
+
+} // namespace test
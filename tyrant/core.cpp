@@ -1,6 +1,11 @@
 #include "core.hpp"
+#include "types.hpp"
+#include <atomic>
 #include <cassert>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 
 void Clock::tick() {
     auto previous = latest;
@@ -39,3 +44,33 @@ void Core::update() {
 // what
 Clock Core::clock = {};
 IO Core::io       = {};
+
+bool write_file_atomic(const char* path, const void* data, size_t size) {
+    std::error_code error;
+    const std::filesystem::path target = path;
+    if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), error);
+
+    // every write gets its own temporary, two threads writing the same file can't clobber each other's.
+    static std::atomic<u32> writes = 0;
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%u.tmp", writes.fetch_add(1, std::memory_order_relaxed));
+
+    std::filesystem::path temporary = target;
+    temporary += suffix;
+    {
+        std::ofstream stream{ temporary, std::ios::binary | std::ios::trunc };
+        stream.write((const char*)data, size);
+        stream.flush();
+        if (!stream) {
+            stream.close();
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, target, error);
+    if (!error) return true;
+
+    std::filesystem::remove(temporary, error);
+    return false;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <chrono>
+#include <cstddef>
 
 struct Clock {
     std::chrono::high_resolution_clock::time_point start;
@@ -141,3 +142,6 @@ struct Core {
 
     static void update();
 };
+
+// writes next to `path` first and renames over it, a crash halfway through leaves the previous file intact.
+bool write_file_atomic(const char* path, const void* data, size_t size);
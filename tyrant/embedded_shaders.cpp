@@ -0,0 +1,21 @@
+#include "embedded_shaders.hpp"
+#include <cstring>
+
+namespace {
+
+struct Embedded_Shader {
+    const char* path;
+    const u32* words;
+    size_t word_count;
+};
+
+#include "embedded_shaders.inl"
+
+} // namespace
+
+Buffer_View<const u32> find_embedded_shader(const char* path) {
+    for (const auto& shader : EMBEDDED_SHADERS) {
+        if (strcmp(shader.path, path) == 0) return { shader.words, shader.word_count };
+    }
+    return {};
+}
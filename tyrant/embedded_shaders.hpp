@@ -0,0 +1,6 @@
+#pragma once
+#include "types.hpp"
+
+// spir-v compiled by the build from every shader under `shaders`, see `lua/shaders.lua`. `path` is the path the shader
+// would otherwise be read from, empty when the build did not embed it.
+Buffer_View<const u32> find_embedded_shader(const char* path);
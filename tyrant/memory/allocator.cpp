@@ -0,0 +1,20 @@
+#include "allocator.hpp"
+#include <new>
+
+namespace {
+
+void* heap_allocate(void*, size_t size, [[maybe_unused]] size_t alignment) noexcept {
+    assert(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__ && "heap allocator does not do over aligned allocations");
+    return ::operator new(size, std::nothrow);
+}
+
+void heap_free(void*, void* ptr, size_t) noexcept { ::operator delete(ptr); }
+
+void* arena_allocate(void* context, size_t size, size_t alignment) noexcept {
+    return static_cast<Arena*>(context)->allocate(size, alignment);
+}
+
+} // namespace
+
+Allocator heap_allocator() noexcept { return { nullptr, &heap_allocate, &heap_free }; }
+Allocator arena_allocator(Arena& arena) noexcept { return { &arena, &arena_allocate, nullptr }; }
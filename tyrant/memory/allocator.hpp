@@ -0,0 +1,29 @@
+#pragma once
+#include "arena.hpp"
+
+// Type erased allocator so containers can be handed either the general heap or an arena. `free` does nothing for
+// arenas, their memory comes back when the arena is cleared or restored.
+struct Allocator {
+    using Allocate_Fn = void* (*)(void* context, size_t size, size_t alignment) noexcept;
+    using Free_Fn     = void (*)(void* context, void* ptr, size_t size) noexcept;
+
+    void* context           = nullptr;
+    Allocate_Fn allocate_fn = nullptr;
+    Free_Fn free_fn         = nullptr;
+
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) const noexcept {
+        return allocate_fn(context, size, alignment);
+    }
+
+    void free(void* ptr, size_t size) const noexcept {
+        if (free_fn != nullptr && ptr != nullptr) free_fn(context, ptr, size);
+    }
+
+    bool operator==(const Allocator& o) const noexcept {
+        return context == o.context && allocate_fn == o.allocate_fn && free_fn == o.free_fn;
+    }
+};
+
+// goes through the global `operator new` so it still shows up in `heap_allocation_count`.
+Allocator heap_allocator() noexcept;
+Allocator arena_allocator(Arena& arena) noexcept;
@@ -1,6 +1,54 @@
 #include "arena.hpp"
 #include <new>
 
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+void* reserve_memory(size_t size) noexcept {
+#ifdef _WIN32
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+bool commit_memory(void* ptr, size_t size) noexcept {
+#ifdef _WIN32
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void decommit_memory(void* ptr, size_t size) noexcept {
+#ifdef _WIN32
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+#else
+    // drop the pages first so that the os can reclaim them.
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+#endif
+}
+
+void release_memory(void* ptr, [[maybe_unused]] size_t size) noexcept {
+#ifdef _WIN32
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+size_t round_up(size_t value, size_t alignment) noexcept { return (size_t)align_forward((uintptr_t)value, alignment); }
+
+} // namespace
+
 Linear_Allocator::Linear_Allocator(void* buffer, size_t buffer_length) noexcept :
     ptr((u8*)buffer), length(buffer_length), offset(0) {}
 
@@ -18,29 +66,49 @@ void* Linear_Allocator::allocate(size_t size, size_t alignment) noexcept {
     return (void*)std::launder((u8*)candidate);
 }
 
-void Arena::clear() noexcept {
-    strategy = Linear_Allocator(first.data, first.length);
-    current  = &first;
+Arena::Arena(size_t reserve) noexcept {
+    reserve_size = round_up(reserve, COMMIT_GRANULARITY);
+    base         = (u8*)reserve_memory(reserve_size);
+    assert(base != nullptr && "Unable to reserve address space for arena");
+    if (base == nullptr) reserve_size = 0;
+}
+
+void Arena::clear() noexcept { offset = 0; }
+
+void Arena::restore(Arena_Marker marker) noexcept {
+    assert(marker.offset <= offset && "Restoring to a marker that is ahead of the arena");
+    offset = marker.offset;
 }
 
 void* Arena::allocate(size_t size, size_t alignment) noexcept {
-    void* ptr = strategy.allocate(size, alignment);
-    if (ptr == nullptr) {
-        if (current->next == nullptr) {
-            current->next = new Memory_Bucket();
-            current       = current->next;
-            strategy      = Linear_Allocator(first.data, first.length);
+    uintptr_t candidate = align_forward((uintptr_t)base + offset, alignment);
+    size_t start        = candidate - (uintptr_t)base;
+    size_t end          = start + size;
+
+    if (end > reserve_size) {
+        return nullptr;
+    }
+
+    if (end > commit_size) {
+        size_t new_commit_size = round_up(end, COMMIT_GRANULARITY);
+        if (new_commit_size > reserve_size) new_commit_size = reserve_size;
+        if (!commit_memory(base + commit_size, new_commit_size - commit_size)) {
+            return nullptr;
         }
+        commit_size = new_commit_size;
     }
 
-    return ptr;
+    offset = end;
+    return (void*)std::launder((u8*)candidate);
+}
+
+void Arena::decommit(size_t keep) noexcept {
+    size_t new_commit_size = round_up(offset > keep ? offset : keep, COMMIT_GRANULARITY);
+    if (new_commit_size >= commit_size) return;
+    decommit_memory(base + new_commit_size, commit_size - new_commit_size);
+    commit_size = new_commit_size;
 }
 
 Arena::~Arena() noexcept {
-    auto node = &first;
-    while (node != nullptr) {
-        auto bucket = node;
-        node        = node->next;
-        delete bucket;
-    }
+    if (base != nullptr) release_memory(base, reserve_size);
 }
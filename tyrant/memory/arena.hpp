@@ -15,10 +15,31 @@ private:
     size_t offset;
 };
 
+struct Arena_Marker {
+    size_t offset = 0;
+};
+
+// Reserves a large range of address space up front and commits pages as it grows, so pointers handed out are stable
+// until the arena is cleared (or restored past them) and a single allocation can be as big as the reservation.
 struct Arena {
-    void* allocate(size_t size, size_t alignment) noexcept;
+    static constexpr size_t DEFAULT_RESERVE_SIZE = convert_to::giga_bytes(1);
+    static constexpr size_t COMMIT_GRANULARITY   = convert_to::kilo_bytes(64);
+
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) noexcept;
     void clear() noexcept;
 
+    // for scoped temporaries, everything allocated after `save` is released by `restore`.
+    Arena_Marker save() const noexcept { return { offset }; }
+    void restore(Arena_Marker marker) noexcept;
+
+    // gives committed pages back to the os, keeping `keep` bytes around for reuse.
+    void decommit(size_t keep = 0) noexcept;
+
+    size_t used() const noexcept { return offset; }
+    size_t committed() const noexcept { return commit_size; }
+    size_t reserved() const noexcept { return reserve_size; }
+
+    Arena(size_t reserve = DEFAULT_RESERVE_SIZE) noexcept;
     ~Arena() noexcept;
     Arena(const Arena& o) noexcept            = delete;
     Arena& operator=(const Arena& o) noexcept = delete;
@@ -26,14 +47,25 @@ struct Arena {
     Arena& operator=(Arena&& o) noexcept      = delete;
 
 private:
-    Linear_Allocator strategy;
-    struct Memory_Bucket {
-        // can change and tweak.
-        static constexpr size_t length = convert_to::kilo_bytes(10);
-        u8 data[length];
-        Memory_Bucket* next = nullptr;
-    };
-
-    Memory_Bucket first    = {};
-    Memory_Bucket* current = nullptr;
+    u8* base            = nullptr;
+    size_t reserve_size = 0;
+    size_t commit_size  = 0;
+    size_t offset       = 0;
+};
+
+template <typename T>
+T* arena_push(Arena& arena, size_t count = 1) noexcept {
+    return (T*)arena.allocate(sizeof(T) * count, alignof(T));
+}
+
+// restores the arena to where it was when the scope began.
+struct Temp_Arena {
+    Temp_Arena(Arena& a) noexcept : arena(a), marker(a.save()) {}
+    ~Temp_Arena() noexcept { arena.restore(marker); }
+
+    Temp_Arena(const Temp_Arena& o) noexcept            = delete;
+    Temp_Arena& operator=(const Temp_Arena& o) noexcept = delete;
+
+    Arena& arena;
+    Arena_Marker marker;
 };
@@ -0,0 +1,35 @@
+#include "frame_allocator.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<u64> heap_allocations = 0;
+
+void* counted_allocate(size_t size) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+} // namespace
+
+u64 heap_allocation_count() noexcept { return heap_allocations.load(std::memory_order_relaxed); }
+
+void* operator new(size_t size) {
+    if (void* ptr = counted_allocate(size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size) {
+    if (void* ptr = counted_allocate(size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
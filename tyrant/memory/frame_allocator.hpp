@@ -0,0 +1,37 @@
+#pragma once
+#include "arena.hpp"
+
+// number of calls to the global `operator new` since startup.
+u64 heap_allocation_count() noexcept;
+
+// One arena per frame in flight. `begin_frame` must only be called after the fence that guards `index` has been
+// signaled, since that is the point where the gpu is done with everything the frame used.
+template <u32 N>
+struct Frame_Allocator {
+    static constexpr size_t FRAME_RESERVE_SIZE = convert_to::mega_bytes(64);
+
+    struct Frame_Arena : Arena {
+        Frame_Arena() noexcept : Arena(FRAME_RESERVE_SIZE) {}
+    };
+
+    Frame_Arena arenas[N];
+    u32 current                     = 0;
+    u64 heap_allocations_at_begin   = 0;
+    u64 heap_allocations_last_frame = 0;
+};
+
+template <u32 N>
+void begin_frame(Frame_Allocator<N>& allocator, u32 index) noexcept {
+    assert(index < N);
+    u64 count                             = heap_allocation_count();
+    allocator.heap_allocations_last_frame = count - allocator.heap_allocations_at_begin;
+    allocator.heap_allocations_at_begin   = count;
+
+    allocator.current = index;
+    allocator.arenas[index].clear();
+}
+
+template <u32 N>
+Arena& current_arena(Frame_Allocator<N>& allocator) noexcept {
+    return allocator.arenas[allocator.current];
+}
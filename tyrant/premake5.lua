@@ -36,6 +36,8 @@ project "tyrant"
         "glad"
     }
 
+    embed_shaders "shaders"
+
     warnings "Extra"
 
     --defines for msvc compiler
@@ -67,7 +69,7 @@ project "tyrant"
         }
 
     filter "configurations:Dist"
-        defines { "TYRANT_DIST" }
+        defines { "TYRANT_DIST", "TYRANT_EMBEDDED_SHADERS" }
         runtime "Release"
         optimize "on"
         links {
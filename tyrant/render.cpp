@@ -11,10 +11,18 @@
 #endif
 
 #include "basic.hpp"
+#include "core.hpp"
+#include "embedded_shaders.hpp"
+#include "memory/frame_allocator.hpp"
 #include "shader_compiler.hpp"
+#include "stdx/pipeline_cache_file.hpp"
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <string_view>
+#include <vector>
 
 #define ENABLE_VALIDATION 1
 
@@ -42,6 +50,9 @@ constexpr const char* required_extensions[] = {
 VkInstance instance                                         = { VK_NULL_HANDLE };
 VkDebugUtilsMessengerEXT debug_messenger                    = { VK_NULL_HANDLE };
 VkDebugReportCallbackEXT debug_report                       = { VK_NULL_HANDLE };
+// only loaded with validation, frames are left unlabeled without it.
+PFN_vkCmdBeginDebugUtilsLabelEXT cmd_begin_label            = nullptr;
+PFN_vkCmdEndDebugUtilsLabelEXT cmd_end_label                = nullptr;
 VkPhysicalDevice devices[Render_Params::MAX_NUMBER_DEVICES] = {};
 
 struct Device {
@@ -50,6 +61,7 @@ struct Device {
     VkQueue present_queue;
     VkQueue graphics_queue;
     VkCommandPool command_pool;
+    VkPipelineCache pipeline_cache;
 } gpu = {};
 
 u32 device_count = {};
@@ -110,6 +122,98 @@ VKAPI_ATTR VkBool32 VKAPI_CALL debug_callback(
         maybe_invoke(____result, __VA_ARGS__);                                                                         \
     }
 
+namespace {
+
+// one file per device and driver, a driver update changes `pipelineCacheUUID` and starts from an empty cache again.
+constexpr const char* PIPELINE_CACHE_DIRECTORY = "cache";
+
+char pipeline_cache_path[256] = {};
+
+// kept for as long as the device, so rebuilding the pipeline does not pay for new shaderc compilers.
+Shader_Compiler shader_compiler = {};
+
+VkPipelineCache load_pipeline_cache(VkDevice device, VkPhysicalDevice pd) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(pd, &properties);
+
+    char uuid[VK_UUID_SIZE * 2 + 1] = {};
+    for (u32 i = 0; i < VK_UUID_SIZE; ++i)
+        snprintf(uuid + i * 2, 3, "%02x", properties.pipelineCacheUUID[i]);
+    snprintf(
+        pipeline_cache_path,
+        sizeof(pipeline_cache_path),
+        "%s/tyrant_pipeline_cache_%04x_%04x_%s.bin",
+        PIPELINE_CACHE_DIRECTORY,
+        properties.vendorID,
+        properties.deviceID,
+        uuid);
+
+    std::vector<char> file;
+    if (std::ifstream stream{ pipeline_cache_path, std::ios::ate | std::ios::binary }; stream.is_open()) {
+        file.resize((size_t)stream.tellg());
+        stream.seekg(0);
+        stream.read(file.data(), file.size());
+    }
+
+    VkPipelineCacheCreateInfo create_info{};
+    create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    if (!file.empty()) {
+        std::string_view data;
+        if (const char* reason = stdx::pipeline_cache_reject_reason(
+                { file.data(), file.size() },
+                properties.vendorID,
+                properties.deviceID,
+                properties.pipelineCacheUUID,
+                data)) {
+            log_warn("Ignoring pipeline cache \"{}\" : {}", pipeline_cache_path, reason);
+        } else {
+            create_info.initialDataSize = data.size();
+            create_info.pInitialData    = data.data();
+            log_info("Loaded pipeline cache \"{}\"", pipeline_cache_path);
+        }
+    }
+
+    VkPipelineCache cache = { VK_NULL_HANDLE };
+    VkResult result       = vkCreatePipelineCache(device, &create_info, nullptr, &cache);
+    if (result != VK_SUCCESS && create_info.initialDataSize) {
+        log_warn("Driver refused pipeline cache \"{}\" : {}", pipeline_cache_path, string_VkResult(result));
+        create_info.initialDataSize = 0;
+        create_info.pInitialData    = nullptr;
+        result                      = vkCreatePipelineCache(device, &create_info, nullptr, &cache);
+    }
+    VK_EXPECT_SUCCESS(result);
+    return cache;
+}
+
+void save_pipeline_cache(VkDevice device, VkPipelineCache cache, VkPhysicalDevice pd) {
+    if (!cache) return;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(pd, &properties);
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS) return;
+
+    constexpr size_t HEADER_SIZE = sizeof(stdx::pipeline_cache_header);
+    std::vector<char> file(HEADER_SIZE + size);
+    if (vkGetPipelineCacheData(device, cache, &size, file.data() + HEADER_SIZE) != VK_SUCCESS) return;
+    file.resize(HEADER_SIZE + size);
+
+    const auto header = stdx::make_pipeline_cache_header(
+        properties.vendorID,
+        properties.deviceID,
+        properties.pipelineCacheUUID,
+        file.data() + HEADER_SIZE,
+        size);
+    memcpy(file.data(), &header, sizeof(header));
+
+    if (!write_file_atomic(pipeline_cache_path, file.data(), file.size())) {
+        log_warn("Unable to write pipeline cache \"{}\"", pipeline_cache_path);
+    }
+}
+
+} // namespace
+
 void init_vulkan_resources() {
     // create_instance
     {
@@ -185,6 +289,10 @@ void init_vulkan_resources() {
 
         VK_EXPECT_SUCCESS(
             vkCreateDebugReportCallbackEXT(instance, &debug_report_callback_info, nullptr, &debug_report));
+
+        cmd_begin_label =
+            (PFN_vkCmdBeginDebugUtilsLabelEXT)vkGetInstanceProcAddr(instance, "vkCmdBeginDebugUtilsLabelEXT");
+        cmd_end_label = (PFN_vkCmdEndDebugUtilsLabelEXT)vkGetInstanceProcAddr(instance, "vkCmdEndDebugUtilsLabelEXT");
     }
 #endif // ENABLE_VALIDATION
 
@@ -337,11 +445,15 @@ void init_vulkan_resources() {
             .physical       = pd,
             .present_queue  = present_queue,
             .graphics_queue = graphics_queue,
-            .command_pool   = command_pool };
+            .command_pool   = command_pool,
+            .pipeline_cache = load_pipeline_cache(device, pd) };
 }
 
 void free_vulkan_resources() {
+    free_shader_compiler(shader_compiler);
     if (gpu.logical) {
+        save_pipeline_cache(gpu.logical, gpu.pipeline_cache, gpu.physical);
+        vkDestroyPipelineCache(gpu.logical, gpu.pipeline_cache, nullptr);
         vkDestroyCommandPool(gpu.logical, gpu.command_pool, nullptr);
         vkDestroyDevice(gpu.logical, nullptr);
     }
@@ -661,48 +773,64 @@ struct Draw_Data {
     VkCommandBuffer command_buffers[Render_Params::MAX_SWAPCHAIN_IMAGES] = {};
     VkDescriptorSet dynamic_sets[Render_Params::MAX_SWAPCHAIN_IMAGES]    = {};
     Framebuffer_Info framebuffer                                         = {};
+
+    // fences are per swapchain image so the scratch memory has to follow the same indexing.
+    Frame_Allocator<Render_Params::MAX_SWAPCHAIN_IMAGES> frame_allocator = {};
+    u64 frame_number                                                     = 0;
 };
 
-// @TODO : make shader system more robust? and to use arenas instead of allocating new objects.
+// @TODO : make shader system more robust?
 void create_shaders_and_pipeline() {
-    const auto read_file = [](std::string_view filename) -> Buffer_View<char> {
-        std::ifstream file{ filename.data(), std::ios::ate | std::ios::binary };
+#if defined(TYRANT_EMBEDDED_SHADERS)
+    // compiled by the build, nothing to read or compile.
+    const Buffer_View<const u32> vert_spirv = find_embedded_shader("shaders/color.vert");
+    const Buffer_View<const u32> frag_spirv = find_embedded_shader("shaders/color.frag");
+    assert(vert_spirv.data && frag_spirv.data);
+#else
+    // shader paths and sources only need to live until the pipeline is built.
+    Arena scratch{ convert_to::mega_bytes(16) };
+
+    const auto read_shader = [&scratch](const char* name) -> Buffer_View<char> {
+        String_View path = arena_format(scratch, "shaders/%s", name);
+        std::ifstream file{ path.data, std::ios::ate | std::ios::binary };
         assert(file.is_open());
 
         const size_t file_size   = (size_t)file.tellg();
-        Buffer_View<char> buffer = { new char[file_size], file_size };
+        Buffer_View<char> buffer = { arena_push<char>(scratch, file_size), file_size };
         file.seekg(0);
         file.read(buffer.data, buffer.count);
         file.close();
         return buffer;
     };
 
-    auto vert_buffer = read_file("shaders/color.vert");
-    defer { delete[] vert_buffer.data; };
+    auto vert_buffer = read_shader("color.vert");
+    auto frag_buffer = read_shader("color.frag");
 
-    auto frag_buffer = read_file("shaders/color.frag");
-    defer { delete[] frag_buffer.data; };
+    if (shader_compiler.compiler_count == 0) shader_compiler = create_shader_compiler();
 
-    Shader_Compiler shader_compiler = create_shader_compiler();
-    defer { free_shader_compiler(shader_compiler); };
+    const Shader_Work works[] = { { .kind  = shaderc_vertex_shader,
+                                    .name  = "color.vert",
+                                    .bytes = { vert_buffer.data, vert_buffer.count } },
+                                  { .kind  = shaderc_fragment_shader,
+                                    .name  = "color.frag",
+                                    .bytes = { frag_buffer.data, frag_buffer.count } } };
 
-    Shader_Work vert_work = { .kind  = shaderc_vertex_shader,
-                              .name  = "color.vert",
-                              .bytes = { vert_buffer.data, vert_buffer.count } };
-
-    Shader_Work frag_work = { .kind  = shaderc_fragment_shader,
-                              .name  = "color.frag",
-                              .bytes = { frag_buffer.data, frag_buffer.count } };
+    Compiled_Shader compiled[ARRAY_SIZE(works)] = {};
+    shader_compiler.compile_batch({ works, ARRAY_SIZE(works) }, { compiled, ARRAY_SIZE(compiled) });
+    defer {
+        for (auto& shader : compiled)
+            shader_compiler.free(shader);
+    };
+    log_info("Shaders ready in {:.2f}ms and {:.2f}ms", compiled[0].milliseconds, compiled[1].milliseconds);
 
-    auto spv_vert = shader_compiler.compile(vert_work);
-    defer { shader_compiler.free(spv_vert); };
-    auto spv_frag = shader_compiler.compile(frag_work);
-    defer { shader_compiler.free(spv_frag); };
+    const Buffer_View<const u32> vert_spirv = { compiled[0].data(), compiled[0].size_in_elements() };
+    const Buffer_View<const u32> frag_spirv = { compiled[1].data(), compiled[1].size_in_elements() };
+#endif
 
-    auto vert_shader = create_shader({ spv_vert.data(), spv_vert.size_in_bytes() });
+    auto vert_shader = create_shader({ vert_spirv.data, vert_spirv.count * sizeof(u32) });
     defer { free_shader(vert_shader); };
 
-    auto frag_shader = create_shader({ spv_frag.data(), spv_frag.size_in_bytes() });
+    auto frag_shader = create_shader({ frag_spirv.data, frag_spirv.count * sizeof(u32) });
     defer { free_shader(frag_shader); };
 
     // create pipeline
@@ -864,7 +992,8 @@ void create_shaders_and_pipeline() {
     graphics_pipeline_create_info.basePipelineIndex   = -1;             // Optional
 
     VK_EXPECT_SUCCESS(
-        vkCreateGraphicsPipelines(gpu.logical, nullptr, 1, &graphics_pipeline_create_info, nullptr, &pipeline.handle));
+        vkCreateGraphicsPipelines(
+            gpu.logical, gpu.pipeline_cache, 1, &graphics_pipeline_create_info, nullptr, &pipeline.handle));
 }
 
 void draw(Swapchain& swapchain, Draw_Data* draw_data) {
@@ -879,6 +1008,16 @@ void draw(Swapchain& swapchain, Draw_Data* draw_data) {
 
     vkResetFences(gpu.logical, 1, draw_data->fences + swapchain.current_frame);
 
+    const u64 previous_heap_allocations = draw_data->frame_allocator.heap_allocations_last_frame;
+    begin_frame(draw_data->frame_allocator, swapchain.current_frame);
+    Arena& scratch = current_arena(draw_data->frame_allocator);
+
+    // the first frame creates what the ones after it reuse, only report frames that start allocating again.
+    const u64 heap_allocations = draw_data->frame_allocator.heap_allocations_last_frame;
+    if (draw_data->frame_number > 1 && heap_allocations != 0 && previous_heap_allocations == 0)
+        log_warn("Frame {} made {} heap allocations", draw_data->frame_number - 1, heap_allocations);
+    ++draw_data->frame_number;
+
     auto& framebuffer = draw_data->framebuffer;
 #if 1
     // if (swapchain.width != framebuffer.width[swapchain.current_frame] ||
@@ -916,6 +1055,16 @@ void draw(Swapchain& swapchain, Draw_Data* draw_data) {
     vkResetCommandBuffer(draw_data->command_buffers[swapchain.current_frame], 0);
     VK_EXPECT_SUCCESS(vkBeginCommandBuffer(draw_data->command_buffers[swapchain.current_frame], &begin_info));
 
+    if (cmd_begin_label) {
+        const String_View name = arena_format(
+            scratch, "Frame %llu (image %u)", (unsigned long long)draw_data->frame_number, swapchain.current_frame);
+
+        VkDebugUtilsLabelEXT label = {};
+        label.sType                = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+        label.pLabelName           = name.data;
+        cmd_begin_label(draw_data->command_buffers[swapchain.current_frame], &label);
+    }
+
     VkRenderPassBeginInfo renderpass_info{};
     renderpass_info.sType      = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderpass_info.renderPass = pipeline.renderpass;
@@ -958,6 +1107,7 @@ void draw(Swapchain& swapchain, Draw_Data* draw_data) {
     vkCmdDraw(draw_data->command_buffers[swapchain.current_frame], 3, 1, 0, 0);
 
     vkCmdEndRenderPass(draw_data->command_buffers[swapchain.current_frame]);
+    if (cmd_end_label) cmd_end_label(draw_data->command_buffers[swapchain.current_frame]);
     VK_EXPECT_SUCCESS(
         vkEndCommandBuffer(draw_data->command_buffers[swapchain.current_frame]),
         [](VkResult /* result */) {});
@@ -976,6 +1126,16 @@ void draw(Swapchain& swapchain, Draw_Data* draw_data) {
     VK_EXPECT_SUCCESS(vkQueueSubmit(gpu.graphics_queue, 1, &submit_info, draw_data->fences[swapchain.current_frame]));
 }
 
+Arena& frame_arena(Draw_Data* draw_data) {
+    assert(draw_data);
+    return current_arena(draw_data->frame_allocator);
+}
+
+u64 frame_heap_allocations(Draw_Data* draw_data) {
+    assert(draw_data);
+    return draw_data->frame_allocator.heap_allocations_last_frame;
+}
+
 void assert_format(VkFormat format) { assert(format == VK_FORMAT_B8G8R8A8_SRGB); }
 
 Draw_Data* create_draw_data() {
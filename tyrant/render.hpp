@@ -58,11 +58,16 @@ Swapchain create_swapchain_from_win32(HINSTANCE hinstance, HWND hwnd);
 // TEMP
 
 struct Draw_Data;
+struct Arena;
 
 void create_shaders_and_pipeline();
 void free_shaders_and_pipeline();
 void assert_format(VkFormat format);
 void draw(Swapchain& swapchain, Draw_Data* draw_data);
 
+// scratch memory that lives until this frame's fence is waited on again.
+Arena& frame_arena(Draw_Data* draw_data);
+u64 frame_heap_allocations(Draw_Data* draw_data);
+
 Draw_Data* create_draw_data();
 void free_draw_data(Draw_Data* draw_data);
@@ -1,8 +1,134 @@
 #include "shader_compiler.hpp"
 #include "basic.hpp"
+#include "core.hpp"
+#include "logger.hpp"
+#include "memory/allocator.hpp"
+#include "stdx/hash.hpp"
+#include "stdx/parallel.hpp"
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <utility>
+#include <vector>
+
+namespace {
+
+constexpr shaderc_optimization_level OPTIMIZATION_LEVEL = shaderc_optimization_level_performance;
+
+constexpr u32 SHADER_CACHE_MAGIC = 0x07'23'02'03; // spir-v magic, byte swapped.
+// bump when the way shaders are compiled changes without any of the key inputs changing.
+constexpr u32 SHADER_CACHE_VERSION = 1;
+
+struct Shader_Cache_Header {
+    u32 magic;
+    u32 version;
+    u64 key;
+    u64 word_count;
+    u64 hash;
+};
+
+// shaderc has no version of its own, the spir-v version it targets and the sdk it came with stand in for it.
+u64 shader_cache_key(const Shader_Work& work) {
+    unsigned int spirv_version  = 0;
+    unsigned int spirv_revision = 0;
+    shaderc_get_spv_version(&spirv_version, &spirv_revision);
+
+    const u32 versions[] = { SHADER_CACHE_VERSION,       spirv_version,  spirv_revision,
+                             VK_HEADER_VERSION_COMPLETE, (u32)work.kind, (u32)OPTIMIZATION_LEVEL };
+
+    u64 key = stdx::hash_bytes(versions, sizeof(versions));
+    key     = stdx::hash_bytes(work.name.data, work.name.count, key);
+    key     = stdx::hash_bytes(work.bytes.data, work.bytes.count, key);
+    for (const auto& define : work.defines) {
+        key = stdx::hash_bytes(define.name.data, define.name.count, key);
+        key = stdx::hash_bytes(define.value.data, define.value.count, key);
+    }
+    return key;
+}
+
+struct Shader_Cache_Path {
+    char data[256];
+};
+
+Shader_Cache_Path shader_cache_path(u64 key) {
+    Shader_Cache_Path path;
+    snprintf(path.data, sizeof(path.data), "%s/%016llx.spv", SHADER_CACHE_DIRECTORY, (unsigned long long)key);
+    return path;
+}
+
+void free_cached_shader(Buffer_View<u32>& words) {
+    heap_allocator().free(words.data, words.count * sizeof(u32));
+    words = {};
+}
+
+// empty when there is no usable spir-v for `key`, anything that doesn't check out is recompiled and overwritten.
+Buffer_View<u32> load_cached_shader(u64 key) {
+    const Shader_Cache_Path path = shader_cache_path(key);
+    std::ifstream stream{ path.data, std::ios::ate | std::ios::binary };
+    if (!stream.is_open()) return {};
+
+    const size_t file_size = (size_t)stream.tellg();
+    Shader_Cache_Header header;
+    if (file_size < sizeof(header)) {
+        log_warn("Ignoring cached shader \"{}\" : truncated header", path.data);
+        return {};
+    }
+
+    stream.seekg(0);
+    stream.read((char*)&header, sizeof(header));
+    if (header.magic != SHADER_CACHE_MAGIC || header.version != SHADER_CACHE_VERSION || header.key != key ||
+        header.word_count * sizeof(u32) != file_size - sizeof(header)) {
+        log_warn("Ignoring cached shader \"{}\" : bad header", path.data);
+        return {};
+    }
+
+    const size_t size      = header.word_count * sizeof(u32);
+    Buffer_View<u32> words = { (u32*)heap_allocator().allocate(size, alignof(u32)), header.word_count };
+    stream.read((char*)words.data, size);
+    if (!stream || stdx::hash_bytes(words.data, size) != header.hash) {
+        log_warn("Ignoring cached shader \"{}\" : corrupt spir-v", path.data);
+        free_cached_shader(words);
+    }
+    return words;
+}
+
+void store_cached_shader(u64 key, const u32* words, size_t word_count) {
+    const size_t size = word_count * sizeof(u32);
+
+    Shader_Cache_Header header = { .magic      = SHADER_CACHE_MAGIC,
+                                   .version    = SHADER_CACHE_VERSION,
+                                   .key        = key,
+                                   .word_count = word_count,
+                                   .hash       = stdx::hash_bytes(words, size) };
+
+    std::vector<char> file(sizeof(header) + size);
+    memcpy(file.data(), &header, sizeof(header));
+    memcpy(file.data() + sizeof(header), words, size);
+
+    const Shader_Cache_Path path = shader_cache_path(key);
+    if (!write_file_atomic(path.data, file.data(), file.size())) {
+        log_warn("Unable to cache shader \"{}\"", path.data);
+    }
+}
+
+Compiled_Shader compile_with(shaderc_compiler_t compiler, const Shader_Work& work, bool& cache_hit) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto since = [start]() {
+        return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const u64 key = shader_cache_key(work);
+    cache_hit     = false;
+    if (Buffer_View<u32> cached = load_cached_shader(key); cached.data) {
+        cache_hit = true;
+        return { .result = nullptr, .cached = cached, .milliseconds = since() };
+    }
 
-Compiled_Shader Shader_Compiler::compile(const Shader_Work& work) noexcept {
     shaderc_compile_options_t options = shaderc_compile_options_initialize();
     defer { shaderc_compile_options_release(options); };
 
@@ -15,7 +141,7 @@ Compiled_Shader Shader_Compiler::compile(const Shader_Work& work) noexcept {
             defines.value.count);
     }
 
-    shaderc_compile_options_set_optimization_level(options, shaderc_optimization_level_performance);
+    shaderc_compile_options_set_optimization_level(options, OPTIMIZATION_LEVEL);
 
     shaderc_compilation_result_t compilation_result = shaderc_compile_into_spv(
         compiler,
@@ -26,19 +152,84 @@ Compiled_Shader Shader_Compiler::compile(const Shader_Work& work) noexcept {
         "main", // entry point
         options);
 
-    return { compilation_result };
+    Compiled_Shader shader = { .result = compilation_result, .cached = {}, .milliseconds = 0 };
+    if (shader) store_cached_shader(key, shader.data(), shader.size_in_elements());
+    shader.milliseconds = since();
+    return shader;
+}
+
+} // namespace
+
+Compiled_Shader Shader_Compiler::compile(const Shader_Work& work) noexcept {
+    bool cache_hit         = false;
+    Compiled_Shader shader = compile_with(compilers[0], work, cache_hit);
+    cache_hit ? ++cache_hits : ++cache_misses;
+    return shader;
+}
+
+void Shader_Compiler::compile_batch(Buffer_View<const Shader_Work> works, Buffer_View<Compiled_Shader> out) noexcept {
+    assert(works.count == out.count);
+    // one task per compiler on the shared worker pool, the calling thread takes one too. the tasks pull shaders off a
+    // shared counter so a slow shader doesn't hold up the ones behind it.
+    const size_t workers = stdx::worker_pool().worker_count() + 1;
+    const u32 task_count = (u32)std::min<size_t>({ workers, MAX_WORKERS, std::max<size_t>(works.count, 1) });
+    for (; compiler_count < task_count; ++compiler_count)
+        compilers[compiler_count] = shaderc_compiler_initialize();
+
+    std::atomic<size_t> next = 0;
+    u32 hits[MAX_WORKERS]    = {};
+
+    stdx::parallel_for(stdx::irange(0u, task_count), 1, [&](u32 task) {
+        for (;;) {
+            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= works.count) return;
+
+            bool cache_hit = false;
+            out[i]         = compile_with(compilers[task], works[i], cache_hit);
+            hits[task] += cache_hit;
+        }
+    });
+
+    u32 batch_hits = 0;
+    for (u32 i = 0; i < task_count; ++i)
+        batch_hits += hits[i];
+    cache_hits += batch_hits;
+    cache_misses += (u32)works.count - batch_hits;
 }
 
 Compiled_Shader::operator bool() const {
+    if (cached.data) return true;
     return result && shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success;
 }
 
-const u32* Compiled_Shader::data() const { return reinterpret_cast<const u32*>(shaderc_result_get_bytes(result)); }
-size_t Compiled_Shader::size_in_bytes() const { return shaderc_result_get_length(result); }
+const u32* Compiled_Shader::data() const {
+    if (cached.data) return cached.data;
+    return reinterpret_cast<const u32*>(shaderc_result_get_bytes(result));
+}
+
+size_t Compiled_Shader::size_in_bytes() const {
+    if (cached.data) return cached.count * sizeof(u32);
+    return shaderc_result_get_length(result);
+}
+
 size_t Compiled_Shader::size_in_elements() const { return size_in_bytes() / sizeof(u32); }
 
 // shader_compiler?
-void Shader_Compiler::free(Compiled_Shader& shader) { shaderc_result_release(shader.result); }
+void Shader_Compiler::free(Compiled_Shader& shader) {
+    if (shader.result) shaderc_result_release(shader.result);
+    free_cached_shader(shader.cached);
+    shader.result = nullptr;
+}
 
-Shader_Compiler create_shader_compiler() { return { shaderc_compiler_initialize() }; }
-void free_shader_compiler(Shader_Compiler& compiler) { shaderc_compiler_release(compiler.compiler); }
+Shader_Compiler create_shader_compiler() {
+    Shader_Compiler compiler = {};
+    compiler.compilers[0]    = shaderc_compiler_initialize();
+    compiler.compiler_count  = 1;
+    return compiler;
+}
+
+void free_shader_compiler(Shader_Compiler& compiler) {
+    for (u32 i = 0; i < compiler.compiler_count; ++i)
+        shaderc_compiler_release(compiler.compilers[i]);
+    compiler.compiler_count = 0;
+}
@@ -21,16 +21,32 @@ struct Compiled_Shader {
     size_t size_in_elements() const;
     size_t size_in_bytes() const;
 
-    // mem
+    // mem, `cached` is set instead of `result` when the spir-v came from the shader cache.
     shaderc_compilation_result_t result;
+    Buffer_View<u32> cached;
+    f64 milliseconds;
 };
 
+// spir-v is cached in `SHADER_CACHE_DIRECTORY`, keyed by everything that changes the output. shaderc only runs when
+// a shader is not in there yet.
+constexpr const char* SHADER_CACHE_DIRECTORY = "cache/shaders";
+
 struct Shader_Compiler {
+    static constexpr u32 MAX_WORKERS = 16;
+
     Compiled_Shader compile(const Shader_Work& work) noexcept;
+
+    // compiles `works` on the shared `stdx::worker_pool`, every task with a shaderc compiler of its own. `out[i]` is
+    // the result of `works[i]`.
+    void compile_batch(Buffer_View<const Shader_Work> works, Buffer_View<Compiled_Shader> out) noexcept;
+
     void free(Compiled_Shader& shader);
 
-    // mem
-    shaderc_compiler_t compiler;
+    // mem, `compilers[0]` is used by `compile`, the others are created the first time a batch needs them.
+    shaderc_compiler_t compilers[MAX_WORKERS];
+    u32 compiler_count;
+    u32 cache_hits;
+    u32 cache_misses;
 };
 
 // shader compiler
@@ -1,7 +1,158 @@
 #include "string.hpp"
+#include <cstdarg>
+#include <cstdio>
 #include <cstring>
 
+namespace {
+
+void vappendf(String& str, const char* format, va_list args) noexcept {
+    va_list retry;
+    va_copy(retry, args);
+    defer { va_end(retry); };
+
+    // try to format in place first, only measure again if it did not fit.
+    const size_t available = str.capacity_left();
+    const int length       = vsnprintf(str.data() + str.size(), available + 1, format, args);
+    assert(length >= 0 && "invalid format string");
+    if (length < 0) return;
+
+    if ((size_t)length > available) {
+        str.reserve(str.size() + length);
+        vsnprintf(str.data() + str.size(), length + 1, format, retry);
+    }
+    str.commit(length);
+}
+
+} // namespace
+
 String_View::String_View(const char* str) : underlying{ str, strlen(str) } {}
 String_View::String_View(const char* str, size_t size) : underlying{ str, size } {}
 
 String_View to_string_view(const char* str) { return { str }; }
+
+bool operator==(String_View lhs, String_View rhs) noexcept {
+    return lhs.count == rhs.count && (lhs.count == 0 || memcmp(lhs.data, rhs.data, lhs.count) == 0);
+}
+
+String::String(Allocator allocator) noexcept : allocator(allocator) {}
+
+String::String(String_View str, Allocator allocator) noexcept : allocator(allocator) { append(str); }
+
+String::~String() noexcept { release(); }
+
+String::String(const String& o) noexcept : allocator(o.allocator) { append(o.view()); }
+
+String::String(String&& o) noexcept : allocator(o.allocator) { *this = std::move(o); }
+
+String& String::operator=(const String& o) noexcept {
+    if (this == &o) return *this;
+    clear();
+    append(o.view());
+    return *this;
+}
+
+String& String::operator=(String&& o) noexcept {
+    if (this == &o) return *this;
+
+    // heap memory can only change hands if it goes back to the same place.
+    if (o.heap == nullptr || !(allocator == o.allocator)) {
+        clear();
+        append(o.view());
+        o.clear();
+        return *this;
+    }
+
+    release();
+    heap     = o.heap;
+    count    = o.count;
+    capacity = o.capacity;
+
+    o.heap = nullptr;
+    o.release();
+    return *this;
+}
+
+void String::release() noexcept {
+    if (heap != nullptr) allocator.free(heap, capacity + 1);
+    heap           = nullptr;
+    count          = 0;
+    capacity       = INLINE_CAPACITY;
+    inline_data[0] = '\0';
+}
+
+void String::clear() noexcept {
+    count     = 0;
+    data()[0] = '\0';
+}
+
+void String::reserve(size_t new_capacity) noexcept {
+    if (new_capacity <= capacity) return;
+
+    // grow geometrically so that appending in a loop stays linear.
+    if (new_capacity < capacity * 2) new_capacity = capacity * 2;
+
+    char* memory = (char*)allocator.allocate(new_capacity + 1, alignof(char));
+    assert(memory != nullptr && "String ran out of memory");
+    memcpy(memory, data(), count + 1);
+
+    if (heap != nullptr) allocator.free(heap, capacity + 1);
+    heap     = memory;
+    capacity = new_capacity;
+}
+
+void String::append(String_View str) noexcept {
+    if (str.count == 0) return;
+    reserve(count + str.count);
+    memcpy(data() + count, str.data, str.count);
+    commit(str.count);
+}
+
+void String::append(char c) noexcept { append(String_View{ &c, 1 }); }
+
+void String::commit(size_t length) noexcept {
+    count += length;
+    data()[count] = '\0';
+}
+
+String_Builder::String_Builder(Arena& arena, size_t capacity) noexcept : buffer(arena_allocator(arena)) {
+    buffer.reserve(capacity);
+}
+
+String_Builder& String_Builder::append(String_View str) noexcept {
+    buffer.append(str);
+    return *this;
+}
+
+String_Builder& String_Builder::append(char c) noexcept {
+    buffer.append(c);
+    return *this;
+}
+
+String_Builder& String_Builder::appendf(const char* format, ...) noexcept {
+    va_list args;
+    va_start(args, format);
+    vappendf(buffer, format, args);
+    va_end(args);
+    return *this;
+}
+
+String_View arena_format(Arena& arena, const char* format, ...) noexcept {
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    const int length = vsnprintf(nullptr, 0, format, copy);
+    va_end(copy);
+
+    assert(length >= 0 && "invalid format string");
+    if (length < 0) {
+        va_end(args);
+        return {};
+    }
+
+    char* memory = (char*)arena.allocate(length + 1, alignof(char));
+    assert(memory != nullptr && "arena ran out of memory");
+    vsnprintf(memory, length + 1, format, args);
+    va_end(args);
+    return { memory, (size_t)length };
+}
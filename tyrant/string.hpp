@@ -1,13 +1,87 @@
 #pragma once
+#include "memory/allocator.hpp"
 #include "types.hpp"
 
 struct String_View : Buffer_View<const char> {
     using underlying = Buffer_View<const char>;
 
+    String_View() = default;
     String_View(const char* str);
     String_View(const char* str, size_t size);
 };
 
 String_View to_string_view(const char* str);
 
-struct String {};
+bool operator==(String_View lhs, String_View rhs) noexcept;
+
+// Null terminated string that keeps up to `INLINE_CAPACITY` characters inside the object, so short names and labels
+// never touch the allocator. Longer strings go through `allocator`, which can be an arena.
+struct String {
+    enum : size_t { INLINE_CAPACITY = 23 };
+
+    const char* data() const noexcept { return heap != nullptr ? heap : inline_data; }
+    char* data() noexcept { return heap != nullptr ? heap : inline_data; }
+    const char* c_str() const noexcept { return data(); }
+
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    bool is_inline() const noexcept { return heap == nullptr; }
+
+    String_View view() const noexcept { return { data(), count }; }
+    operator String_View() const noexcept { return view(); }
+
+    void reserve(size_t new_capacity) noexcept;
+    void append(String_View str) noexcept;
+    void append(char c) noexcept;
+
+    // keeps the memory around.
+    void clear() noexcept;
+
+    // for writing into `data()` directly, `commit` accounts for `length` characters written past `size()`.
+    size_t capacity_left() const noexcept { return capacity - count; }
+    void commit(size_t length) noexcept;
+
+    String(Allocator allocator = heap_allocator()) noexcept;
+    String(String_View str, Allocator allocator = heap_allocator()) noexcept;
+    ~String() noexcept;
+
+    // copies use the allocator of the source.
+    String(const String& o) noexcept;
+    String(String&& o) noexcept;
+    String& operator=(const String& o) noexcept;
+    String& operator=(String&& o) noexcept;
+
+private:
+    void release() noexcept;
+
+private:
+    Allocator allocator                   = {};
+    char* heap                            = nullptr;
+    size_t count                          = 0;
+    size_t capacity                       = INLINE_CAPACITY;
+    char inline_data[INLINE_CAPACITY + 1] = {};
+};
+
+// Builds strings in arena memory, the result stays valid until the arena is cleared or restored past it. meant for
+// per frame debug labels and log messages.
+struct String_Builder {
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    String_Builder& append(String_View str) noexcept;
+    String_Builder& append(char c) noexcept;
+
+    // printf style.
+    String_Builder& appendf(const char* format, ...) noexcept;
+
+    String_View view() const noexcept { return buffer.view(); }
+    const char* c_str() const noexcept { return buffer.c_str(); }
+    size_t size() const noexcept { return buffer.size(); }
+    void clear() noexcept { buffer.clear(); }
+
+    String_Builder(Arena& arena, size_t capacity = DEFAULT_CAPACITY) noexcept;
+
+    String buffer;
+};
+
+// one shot printf style formatting into `arena`, the view is null terminated.
+String_View arena_format(Arena& arena, const char* format, ...) noexcept;
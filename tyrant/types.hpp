@@ -1,6 +1,8 @@
 #pragma once
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 #include <utility>
 
 using s8  = int8_t;
@@ -39,9 +41,15 @@ struct Buffer_View {
     const T* begin() const { return data; }
     const T* end() const { return data + count; }
 
-    std::enable_if_t<!std::is_const_v<T>, Buffer_View<std::add_const<T>>> as_const() const { return { data, count }; }
+    template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    Buffer_View<const U> as_const() const {
+        return { data, count };
+    }
 
-    operator std::enable_if_t<!std::is_const_v<T>, Buffer_View<std::add_const<T>>>() const { return as_const(); }
+    template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+    operator Buffer_View<const U>() const {
+        return as_const();
+    }
 };
 
 template <typename T>
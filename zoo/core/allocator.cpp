@@ -0,0 +1,309 @@
+#include "allocator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <malloc.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+std::atomic<u64> heap_allocations = 0;
+
+void* reserve_pages(size_t size) noexcept {
+#if defined(WIN32)
+    return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+    void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+bool commit_pages(void* ptr, size_t size) noexcept {
+#if defined(WIN32)
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void release_pages(void* ptr, [[maybe_unused]] size_t size) noexcept {
+#if defined(WIN32)
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+void* aligned_malloc(size_t size, size_t alignment) noexcept {
+#if defined(WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, std::max(alignment, sizeof(void*)), size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void aligned_free(void* ptr) noexcept {
+#if defined(WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+using zoo::core::Memory_Tag;
+
+thread_local Memory_Tag current_tag = Memory_Tag::general;
+
+#if defined(ZOO_TRACK_ALLOCATIONS)
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(Memory_Tag::count);
+
+struct Tag_Counters {
+    std::atomic<u64> live_bytes        = 0;
+    std::atomic<u64> live_count        = 0;
+    std::atomic<u64> peak_bytes        = 0;
+    std::atomic<u64> total_allocations = 0;
+    std::atomic<u64> total_bytes       = 0;
+
+    // snapshot of the totals at the last `end_memory_frame`.
+    std::atomic<u64> allocations_at_frame   = 0;
+    std::atomic<u64> bytes_at_frame         = 0;
+    std::atomic<u64> allocations_last_frame = 0;
+    std::atomic<u64> bytes_last_frame       = 0;
+};
+
+Tag_Counters tag_counters[TAG_COUNT];
+
+// sits right in front of every tracked allocation, `operator delete` is not always given the size. `offset` is how far
+// the pointer handed out is from the start of the block. 16 bytes so the pointer keeps malloc's alignment.
+struct alignas(16) Tracking_Header {
+    u64 size;
+    u32 offset;
+    Memory_Tag tag;
+};
+
+static_assert(sizeof(Tracking_Header) == 16);
+
+// puts the header at `offset - sizeof(Tracking_Header)` into `block` and counts the allocation against the current tag.
+void* track(void* block, size_t offset, size_t size) noexcept {
+    if (block == nullptr) return nullptr;
+
+    u8* ptr              = static_cast<u8*>(block) + offset;
+    const Memory_Tag tag = current_tag;
+    new (ptr - sizeof(Tracking_Header)) Tracking_Header{ size, static_cast<u32>(offset), tag };
+
+    auto& counters = tag_counters[static_cast<size_t>(tag)];
+    const u64 live = counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+    counters.live_count.fetch_add(1, std::memory_order_relaxed);
+    counters.total_allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.total_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    u64 peak = counters.peak_bytes.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+
+    return ptr;
+}
+
+// uncounts the allocation at `ptr` and returns the start of its block.
+void* untrack(void* ptr) noexcept {
+    auto* header   = reinterpret_cast<Tracking_Header*>(static_cast<u8*>(ptr) - sizeof(Tracking_Header));
+    auto& counters = tag_counters[static_cast<size_t>(header->tag)];
+    counters.live_bytes.fetch_sub(header->size, std::memory_order_relaxed);
+    counters.live_count.fetch_sub(1, std::memory_order_relaxed);
+    return static_cast<u8*>(ptr) - header->offset;
+}
+
+void* counted_allocate(size_t size) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return track(std::malloc(sizeof(Tracking_Header) + size), sizeof(Tracking_Header), size);
+}
+
+void counted_free(void* ptr) noexcept {
+    if (ptr != nullptr) std::free(untrack(ptr));
+}
+
+// the header needs a whole `alignment` step in front of the pointer so the pointer stays aligned.
+void* counted_allocate_aligned(size_t size, size_t alignment) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    alignment           = std::max(alignment, alignof(Tracking_Header));
+    const size_t offset = align_forward(sizeof(Tracking_Header), alignment);
+    return track(aligned_malloc(offset + size, alignment), offset, size);
+}
+
+void counted_free_aligned(void* ptr) noexcept {
+    if (ptr != nullptr) aligned_free(untrack(ptr));
+}
+
+#else
+
+void* counted_allocate(size_t size) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void counted_free(void* ptr) noexcept { std::free(ptr); }
+
+void* counted_allocate_aligned(size_t size, size_t alignment) noexcept {
+    heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    return aligned_malloc(size ? size : 1, alignment);
+}
+
+void counted_free_aligned(void* ptr) noexcept { aligned_free(ptr); }
+
+#endif
+
+} // namespace
+
+void* operator new(size_t size) {
+    if (void* ptr = counted_allocate(size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size) {
+    if (void* ptr = counted_allocate(size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+
+void operator delete(void* ptr) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { counted_free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { counted_free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { counted_free(ptr); }
+
+// over aligned types, `alignas` larger than what malloc guarantees.
+void* operator new(size_t size, std::align_val_t alignment) {
+    if (void* ptr = counted_allocate_aligned(size, static_cast<size_t>(alignment))) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    if (void* ptr = counted_allocate_aligned(size, static_cast<size_t>(alignment))) return ptr;
+    throw std::bad_alloc{};
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_allocate_aligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return counted_allocate_aligned(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept { counted_free_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { counted_free_aligned(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { counted_free_aligned(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { counted_free_aligned(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { counted_free_aligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { counted_free_aligned(ptr); }
+
+namespace zoo::core {
+
+u64 heap_allocation_count() noexcept { return heap_allocations.load(std::memory_order_relaxed); }
+
+const char* memory_tag_name(Memory_Tag tag) noexcept {
+    switch (tag) {
+        case Memory_Tag::general: return "general";
+        case Memory_Tag::render: return "render";
+        case Memory_Tag::imgui: return "imgui";
+        case Memory_Tag::mesh: return "mesh";
+        case Memory_Tag::shader: return "shader";
+        default: return "unknown";
+    }
+}
+
+Memory_Tag current_memory_tag() noexcept { return current_tag; }
+
+Memory_Tag_Scope::Memory_Tag_Scope(Memory_Tag tag) noexcept : previous_(current_tag) { current_tag = tag; }
+Memory_Tag_Scope::~Memory_Tag_Scope() noexcept { current_tag = previous_; }
+
+#if defined(ZOO_TRACK_ALLOCATIONS)
+
+Memory_Tag_Stats memory_tag_stats(Memory_Tag tag) noexcept {
+    const auto& counters = tag_counters[static_cast<size_t>(tag)];
+    return { .live_bytes             = counters.live_bytes.load(std::memory_order_relaxed),
+             .live_count             = counters.live_count.load(std::memory_order_relaxed),
+             .peak_bytes             = counters.peak_bytes.load(std::memory_order_relaxed),
+             .total_allocations      = counters.total_allocations.load(std::memory_order_relaxed),
+             .allocations_last_frame = counters.allocations_last_frame.load(std::memory_order_relaxed),
+             .bytes_last_frame       = counters.bytes_last_frame.load(std::memory_order_relaxed) };
+}
+
+void end_memory_frame() noexcept {
+    for (auto& counters : tag_counters) {
+        const u64 allocations = counters.total_allocations.load(std::memory_order_relaxed);
+        const u64 bytes       = counters.total_bytes.load(std::memory_order_relaxed);
+        counters.allocations_last_frame.store(
+            allocations - counters.allocations_at_frame.exchange(allocations, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        counters.bytes_last_frame.store(
+            bytes - counters.bytes_at_frame.exchange(bytes, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+    }
+}
+
+void reset_memory_peaks() noexcept {
+    for (auto& counters : tag_counters)
+        counters.peak_bytes.store(counters.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+#else
+
+Memory_Tag_Stats memory_tag_stats(Memory_Tag) noexcept { return {}; }
+void end_memory_frame() noexcept {}
+void reset_memory_peaks() noexcept {}
+
+#endif
+
+Arena::Arena(size_t reserve_size) noexcept {
+    reserve_size_ = (size_t)align_forward((uintptr_t)reserve_size, COMMIT_GRANULARITY);
+    base_         = static_cast<u8*>(reserve_pages(reserve_size_));
+    ZOO_ASSERT(base_ != nullptr, "Unable to reserve address space for arena!");
+    if (base_ == nullptr) reserve_size_ = 0;
+}
+
+Arena::~Arena() noexcept {
+    if (base_ != nullptr) release_pages(base_, reserve_size_);
+}
+
+void Arena::restore(Arena_Marker marker) noexcept {
+    ZOO_ASSERT(marker.offset <= offset_, "Restoring to a marker that is ahead of the arena!");
+    offset_ = marker.offset;
+}
+
+void* Arena::allocate(size_t size, size_t alignment) noexcept {
+    const auto candidate = align_forward((uintptr_t)base_ + offset_, alignment);
+    const size_t start   = candidate - (uintptr_t)base_;
+    const size_t end     = start + size;
+
+    if (end > reserve_size_) {
+        return nullptr;
+    }
+
+    if (end > commit_size_) {
+        size_t new_commit_size = (size_t)align_forward((uintptr_t)end, COMMIT_GRANULARITY);
+        if (new_commit_size > reserve_size_) new_commit_size = reserve_size_;
+        if (!commit_pages(base_ + commit_size_, new_commit_size - commit_size_)) {
+            return nullptr;
+        }
+        commit_size_ = new_commit_size;
+    }
+
+    offset_ = end;
+    return reinterpret_cast<void*>(candidate);
+}
+
+} // namespace zoo::core
@@ -1,7 +1,150 @@
+#pragma once
+#include "fwd.hpp"
+#include <cstddef>
 
+namespace zoo::core {
 
+// number of calls that went through the global `operator new` since startup. used to check that the steady state
+// frame loop does not touch the general heap.
+u64 heap_allocation_count() noexcept;
 
-struct Arena {
+// subsystem that gets billed for the heap allocations made on a thread, see `Memory_Tag_Scope`.
+enum class Memory_Tag : u8 { general, render, imgui, mesh, shader, count };
+
+const char* memory_tag_name(Memory_Tag tag) noexcept;
+
+struct Memory_Tag_Stats {
+    u64 live_bytes             = 0;
+    u64 live_count             = 0;
+    u64 peak_bytes             = 0; // high-water mark of `live_bytes` since startup or `reset_memory_peaks`.
+    u64 total_allocations      = 0;
+    u64 allocations_last_frame = 0;
+    u64 bytes_last_frame       = 0; // bytes allocated, not the net change of `live_bytes`.
+};
+
+// per tag tracking is only compiled in with `ZOO_TRACK_ALLOCATIONS`, the stats stay zero otherwise.
+constexpr bool memory_tracking_enabled() noexcept {
+#if defined(ZOO_TRACK_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+Memory_Tag current_memory_tag() noexcept;
+Memory_Tag_Stats memory_tag_stats(Memory_Tag tag) noexcept;
+
+// rolls the per frame counters over, call once per frame from the main loop.
+void end_memory_frame() noexcept;
+void reset_memory_peaks() noexcept;
+
+// bills every heap allocation made on this thread to `tag` until the scope ends. memory is credited back to the tag
+// it was allocated under no matter which scope frees it.
+class Memory_Tag_Scope {
+public:
+    Memory_Tag_Scope(Memory_Tag tag) noexcept;
+    ~Memory_Tag_Scope() noexcept;
+
+    Memory_Tag_Scope(const Memory_Tag_Scope&)            = delete;
+    Memory_Tag_Scope& operator=(const Memory_Tag_Scope&) = delete;
+
+private:
+    Memory_Tag previous_;
 };
 
+#define ZOO_MEMORY_TAG(tag) ::zoo::core::Memory_Tag_Scope ANONYMOUS_VARIABLE(memory_tag_scope)(tag)
+
+struct Arena_Marker {
+    size_t offset = 0;
+};
+
+// Linear arena on top of a reserved range of address space. pages are committed as the arena grows so pointers stay
+// stable until `clear`/`restore` and large allocations don't need a new block.
+class Arena {
+public:
+    static constexpr size_t DEFAULT_RESERVE_SIZE = size_t{ 256 } << 20;
+    static constexpr size_t COMMIT_GRANULARITY   = size_t{ 64 } << 10;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    template <typename T>
+    T* allocate(size_t count = 1) noexcept {
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    void clear() noexcept { offset_ = 0; }
+
+    Arena_Marker save() const noexcept { return { offset_ }; }
+    void restore(Arena_Marker marker) noexcept;
+
+    size_t used() const noexcept { return offset_; }
+    size_t committed() const noexcept { return commit_size_; }
+    size_t reserved() const noexcept { return reserve_size_; }
+
+    Arena(size_t reserve_size = DEFAULT_RESERVE_SIZE) noexcept;
+    ~Arena() noexcept;
+
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&)                 = delete;
+    Arena& operator=(Arena&&)      = delete;
+
+private:
+    u8* base_            = nullptr;
+    size_t reserve_size_ = 0;
+    size_t commit_size_  = 0;
+    size_t offset_       = 0;
+};
+
+class Scoped_Arena {
+public:
+    Scoped_Arena(Arena& arena) noexcept : arena_(arena), marker_(arena.save()) {}
+    ~Scoped_Arena() noexcept { arena_.restore(marker_); }
+
+    Scoped_Arena(const Scoped_Arena&)            = delete;
+    Scoped_Arena& operator=(const Scoped_Arena&) = delete;
+
+    Arena& arena() noexcept { return arena_; }
+
+private:
+    Arena& arena_;
+    Arena_Marker marker_;
+};
+
+// One arena per frame in flight. `begin_frame` must only be called once the fence guarding `index` has been
+// signaled, everything handed out from that arena during the previous use is then released in one go.
+template <s32 N>
+class Frame_Allocator {
+public:
+    static constexpr size_t FRAME_RESERVE_SIZE = size_t{ 64 } << 20;
+
+    void begin_frame(s32 index) noexcept {
+        ZOO_ASSERT(index >= 0 && index < N, "frame index out of range!");
+        const auto count             = heap_allocation_count();
+        heap_allocations_last_frame_ = count - heap_allocations_at_begin_;
+        heap_allocations_at_begin_   = count;
+
+        current_ = index;
+        arenas_[current_].clear();
+    }
+
+    Arena& current() noexcept { return arenas_[current_]; }
+    Arena& operator[](s32 index) noexcept { return arenas_[index]; }
+
+    // heap allocations made between the last two calls to `begin_frame`.
+    u64 heap_allocations_last_frame() const noexcept { return heap_allocations_last_frame_; }
+
+    Frame_Allocator() noexcept = default;
+
+private:
+    struct Frame_Arena : Arena {
+        Frame_Arena() noexcept : Arena(FRAME_RESERVE_SIZE) {}
+    };
+
+    Frame_Arena arenas_[N];
+    s32 current_                     = 0;
+    u64 heap_allocations_at_begin_   = 0;
+    u64 heap_allocations_last_frame_ = 0;
+};
 
+} // namespace zoo::core
@@ -0,0 +1,133 @@
+#include "file_watcher.hpp"
+#include "log.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#else
+#include <filesystem>
+#include <unordered_map>
+#endif
+
+namespace zoo::core {
+
+File_Watcher::~File_Watcher() noexcept { stop(); }
+
+bool File_Watcher::start(std::string_view directory, callback on_change) noexcept {
+    stop();
+    directory_ = directory;
+    on_change_ = std::move(on_change);
+
+#if defined(__linux__)
+    inotify_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_ < 0) {
+        ZOO_LOG_WARN("Unable to watch \"{}\" : {}", directory_, std::strerror(errno));
+        return false;
+    }
+
+    // editors either write the file in place or rename a temporary over it.
+    if (inotify_add_watch(inotify_, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        ZOO_LOG_WARN("Unable to watch \"{}\" : {}", directory_, std::strerror(errno));
+        close(inotify_);
+        inotify_ = -1;
+        return false;
+    }
+#endif
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread{ [this]() { run(); } };
+    return true;
+}
+
+void File_Watcher::stop() noexcept {
+    if (!thread_.joinable()) return;
+
+    // the thread never blocks for longer than `POLL_INTERVAL`, no need to wake it up.
+    running_.store(false, std::memory_order_release);
+    thread_.join();
+
+#if defined(__linux__)
+    close(inotify_);
+    inotify_ = -1;
+#endif
+}
+
+#if defined(__linux__)
+
+void File_Watcher::run() noexcept {
+    std::vector<std::string> changed;
+    alignas(inotify_event) char buffer[4096];
+
+    while (running()) {
+        // once something changed only wait for the writes that belong to the same save.
+        const auto timeout = changed.empty() ? POLL_INTERVAL : SETTLE_TIME;
+        pollfd fd{ .fd = inotify_, .events = POLLIN, .revents = 0 };
+
+        const int ready = poll(&fd, 1, static_cast<int>(timeout.count()));
+        if (ready < 0 && errno != EINTR) {
+            ZOO_LOG_ERROR("Stopped watching \"{}\" : {}", directory_, std::strerror(errno));
+            return;
+        }
+
+        if (ready > 0) {
+            ssize_t size = 0;
+            while ((size = read(inotify_, buffer, sizeof(buffer))) > 0) {
+                for (const char* at = buffer; at < buffer + size;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(at);
+                    at += sizeof(inotify_event) + event->len;
+                    if (event->len == 0 || (event->mask & IN_ISDIR) != 0) continue;
+
+                    std::string path = directory_ + "/" + event->name;
+                    if (std::find(changed.begin(), changed.end(), path) == changed.end())
+                        changed.push_back(std::move(path));
+                }
+            }
+            continue;
+        }
+
+        for (const auto& path : changed)
+            on_change_(path);
+        changed.clear();
+    }
+}
+
+#else
+
+void File_Watcher::run() noexcept {
+    namespace fs = std::filesystem;
+    std::unordered_map<std::string, fs::file_time_type> write_times;
+
+    const auto scan = [&](bool report) {
+        std::error_code error;
+        for (const auto& entry : fs::directory_iterator{ directory_, error }) {
+            if (!entry.is_regular_file(error)) continue;
+
+            const auto write_time = entry.last_write_time(error);
+            if (error) continue;
+
+            std::string path    = directory_ + "/" + entry.path().filename().string();
+            auto [it, inserted] = write_times.try_emplace(path, write_time);
+            if (!inserted && it->second == write_time) continue;
+
+            it->second = write_time;
+            if (report) on_change_(path);
+        }
+    };
+
+    scan(false);
+    while (running()) {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+        scan(true);
+    }
+}
+
+#endif
+
+} // namespace zoo::core
@@ -0,0 +1,53 @@
+#pragma once
+#include "fwd.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace zoo::core {
+
+// Reports files that were written to a directory, from a thread of its own. inotify on linux, anywhere else the
+// directory is polled for write times that changed. editors tend to write a file several times when saving, changes
+// that arrive within `SETTLE_TIME` of each other are reported once. sub directories are not watched.
+class File_Watcher {
+public:
+    using callback = std::function<void(const std::string& path)>;
+
+    static constexpr std::chrono::milliseconds SETTLE_TIME{ 50 };
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{ 250 };
+
+    File_Watcher() noexcept = default;
+    ~File_Watcher() noexcept;
+
+    File_Watcher(const File_Watcher&)            = delete;
+    File_Watcher& operator=(const File_Watcher&) = delete;
+    File_Watcher(File_Watcher&&)                 = delete;
+    File_Watcher& operator=(File_Watcher&&)      = delete;
+
+    // `on_change` runs on the watcher thread with `directory` joined with the name of the file that changed.
+    bool start(std::string_view directory, callback on_change) noexcept;
+    void stop() noexcept;
+
+    bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+    const std::string& directory() const noexcept { return directory_; }
+
+private:
+    void run() noexcept;
+
+private:
+    std::string directory_;
+    callback on_change_;
+
+    std::thread thread_;
+    std::atomic<bool> running_ = false;
+
+#if defined(__linux__)
+    int inotify_ = -1;
+#endif
+};
+
+} // namespace zoo::core
@@ -0,0 +1,98 @@
+#include "name.hpp"
+#include "allocator.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+
+#include "stdx/flat_hash_map.hpp"
+
+namespace zoo::core {
+
+namespace {
+
+struct Entry {
+    const char* data = "";
+    u32 size         = 0;
+};
+
+// entries are handed out in fixed size chunks that never move, so a reader only has to load the chunk pointer.
+class Name_Table {
+public:
+    static constexpr u32 CHUNK_SIZE        = 1024;
+    static constexpr u32 MAX_CHUNKS        = 1024;
+    static constexpr size_t STRING_RESERVE = size_t{ 64 } << 20;
+
+    Name::id_type intern(std::string_view str) noexcept {
+        if (str.empty()) return Name::EMPTY;
+
+        {
+            std::shared_lock guard{ lock_ };
+            if (auto it = ids_.find(str); it != ids_.end()) return it->second;
+        }
+
+        std::unique_lock guard{ lock_ };
+        // someone else might have interned it while we were waiting.
+        if (auto it = ids_.find(str); it != ids_.end()) return it->second;
+
+        const Name::id_type id = count_.load(std::memory_order_relaxed);
+        const u32 chunk        = id / CHUNK_SIZE;
+        ZOO_ASSERT(chunk < MAX_CHUNKS, "Ran out of space for interned names!");
+
+        if (chunks_[chunk].load(std::memory_order_relaxed) == nullptr)
+            chunks_[chunk].store(new Entry[CHUNK_SIZE], std::memory_order_release);
+
+        auto* data = static_cast<char*>(strings_.allocate(str.size() + 1, alignof(char)));
+        ZOO_ASSERT(data != nullptr, "Ran out of memory for interned names!");
+        std::memcpy(data, str.data(), str.size());
+        data[str.size()] = '\0';
+
+        chunks_[chunk].load(std::memory_order_relaxed)[id % CHUNK_SIZE] = { data, static_cast<u32>(str.size()) };
+        ids_.emplace(std::string_view{ data, str.size() }, id);
+        count_.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    std::string_view view(Name::id_type id) const noexcept {
+        ZOO_ASSERT(id < count_.load(std::memory_order_acquire), "Name does not belong to the name table!");
+        const Entry& entry = chunks_[id / CHUNK_SIZE].load(std::memory_order_acquire)[id % CHUNK_SIZE];
+        return { entry.data, entry.size };
+    }
+
+    u32 count() const noexcept { return count_.load(std::memory_order_acquire); }
+
+    Name_Table() noexcept {
+        // id 0 is always the empty string.
+        chunks_[0].store(new Entry[CHUNK_SIZE], std::memory_order_relaxed);
+        count_.store(1, std::memory_order_relaxed);
+    }
+
+    ~Name_Table() noexcept {
+        for (auto& chunk : chunks_)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::shared_mutex lock_                                   = {};
+    stdx::flat_hash_map<std::string_view, Name::id_type> ids_ = {};
+    Arena strings_{ STRING_RESERVE };
+
+    std::atomic<Entry*> chunks_[MAX_CHUNKS] = {};
+    std::atomic<u32> count_                 = 0;
+};
+
+Name_Table& name_table() noexcept {
+    static Name_Table table;
+    return table;
+}
+
+} // namespace
+
+Name::Name(std::string_view str) noexcept : id_(name_table().intern(str)) {}
+
+std::string_view Name::view() const noexcept { return name_table().view(id_); }
+
+u32 Name::count() noexcept { return name_table().count(); }
+
+} // namespace zoo::core
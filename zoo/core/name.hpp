@@ -0,0 +1,51 @@
+#pragma once
+#include "fwd.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <string_view>
+
+namespace zoo::core {
+
+// Interned string, the characters are stored once in a global table and a `Name` is just the 32 bit id of the entry.
+// comparing, copying and moving names never touches the string. interning takes a lock and only allocates the first
+// time a string is seen, looking up the characters of a name is lock free. entries live until the program exits.
+class Name {
+public:
+    using id_type = u32;
+
+    // id of the empty string, what a default constructed `Name` refers to.
+    static constexpr id_type EMPTY = 0;
+
+    // `format_name` truncates anything longer.
+    static constexpr size_t MAX_FORMATTED_SIZE = 256;
+
+    Name() noexcept = default;
+    Name(std::string_view str) noexcept;
+    Name(const char* str) noexcept : Name(std::string_view{ str }) {}
+
+    id_type id() const noexcept { return id_; }
+    bool empty() const noexcept { return id_ == EMPTY; }
+
+    std::string_view view() const noexcept;
+    const char* c_str() const noexcept { return view().data(); }
+
+    friend bool operator==(Name lhs, Name rhs) noexcept { return lhs.id_ == rhs.id_; }
+
+    // number of unique strings interned so far, including the empty string.
+    static u32 count() noexcept;
+
+private:
+    id_type id_ = EMPTY;
+};
+
+// formats on the stack, so only the first time a name shows up costs an allocation.
+template <typename... Args>
+Name format_name(fmt::format_string<Args...> format, Args&&... args) noexcept {
+    char buffer[Name::MAX_FORMATTED_SIZE];
+    const auto result = fmt::format_to_n(buffer, sizeof(buffer), format, std::forward<Args>(args)...);
+    return Name{ std::string_view{ buffer, std::min(result.size, sizeof(buffer)) } };
+}
+
+} // namespace zoo::core
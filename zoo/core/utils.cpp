@@ -1,6 +1,10 @@
 #include "utils.hpp"
 #include "core/fwd.hpp"
 #include "render/resources/mesh.hpp"
+#include <spdlog/fmt/fmt.h>
+
+#include <atomic>
+#include <filesystem>
 #include <fstream>
 
 namespace zoo::core {
@@ -28,6 +32,35 @@ stdx::expected<std::string, std::runtime_error> read_file(std::string_view filen
     return buffer;
 }
 
+bool write_file_atomic(std::string_view filename, std::string_view bytes) noexcept {
+    static std::atomic<u32> writes = 0;
+
+    const std::filesystem::path path{ filename };
+    std::filesystem::path temporary = path;
+    temporary += fmt::format(".{}.tmp", writes.fetch_add(1, std::memory_order_relaxed));
+
+    std::error_code error;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), error);
+
+    {
+        std::ofstream file{ temporary, std::ios::binary | std::ios::trunc };
+        if (!file.is_open()) return false;
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+    if (!error) return true;
+
+    std::filesystem::remove(temporary, error);
+    return false;
+}
+
 namespace example {
 void populate_vertices(render::Device_Context& context) {
     const std::vector<render::resources::Vertex> vertices = {
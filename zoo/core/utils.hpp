@@ -13,6 +13,10 @@ namespace zoo::core {
 void check_memory() noexcept;
 stdx::expected<std::string, std::runtime_error> read_file(std::string_view filename) noexcept;
 
+// writes next to `filename` first and renames over it, readers either see the old file or all of the new one.
+// concurrent writers of the same file each use their own temporary, the last rename wins.
+bool write_file_atomic(std::string_view filename, std::string_view bytes) noexcept;
+
 } // namespace zoo::core
   //
   //
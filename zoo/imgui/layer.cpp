@@ -6,6 +6,7 @@
 // Using a non hpp so that it doesn't kill lsp.
 #include "fonts/roboto.embed"
 
+#include "core/allocator.hpp"
 #include "render/scene/upload_context.hpp"
 
 namespace zoo::imgui {
@@ -62,6 +63,9 @@ void Layer::exit() noexcept {
 }
 
 void Layer::update() noexcept {
+    core::end_memory_frame();
+    ZOO_MEMORY_TAG(core::Memory_Tag::imgui);
+
     imgui_window_new_frame();
     ImGui::NewFrame();
     // Here is an example of some drawing needed.]
@@ -107,6 +111,7 @@ void Layer::update() noexcept {
         }
 
         draw_frame_buffer();
+        draw_memory_panel();
 
         if (ImGui::BeginMenuBar()) {
             if (ImGui::MenuItem("Demo")) {
@@ -125,6 +130,7 @@ void Layer::update() noexcept {
 }
 
 void Layer::render() noexcept {
+    ZOO_MEMORY_TAG(core::Memory_Tag::imgui);
     imgui_render_frame_render();
 
     auto& io = ImGui::GetIO();
@@ -161,4 +167,57 @@ void Layer::draw_frame_buffer() noexcept {
     ImGui::End();
 }
 
+void Layer::draw_memory_panel() noexcept {
+    ImGui::Begin("Memory");
+
+    // both should stay flat once the scene is up, the frame loop is meant to live off the frame arenas.
+    ImGui::Text(
+        "Heap allocations last frame: %llu",
+        static_cast<unsigned long long>(scene_.frame_allocator().heap_allocations_last_frame()));
+    ImGui::Text("Frame arena: %.1f KB", static_cast<f64>(scene_.frame_arena().used()) / 1024.0);
+    ImGui::Separator();
+
+    if constexpr (!core::memory_tracking_enabled()) {
+        ImGui::TextUnformatted("Build Debug or with --track-allocations to track heap allocations per tag.");
+        ImGui::End();
+        return;
+    }
+
+    const f32 frame_rate = ImGui::GetIO().Framerate;
+    if (ImGui::Button("Reset peaks")) core::reset_memory_peaks();
+
+    constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("Memory Tags", 6, table_flags)) {
+        ImGui::TableSetupColumn("Tag");
+        ImGui::TableSetupColumn("Live (KB)");
+        ImGui::TableSetupColumn("Peak (KB)");
+        ImGui::TableSetupColumn("Live count");
+        ImGui::TableSetupColumn("Allocs/frame");
+        ImGui::TableSetupColumn("Allocs/s");
+        ImGui::TableHeadersRow();
+
+        for (u8 i = 0; i < static_cast<u8>(core::Memory_Tag::count); ++i) {
+            const auto tag   = static_cast<core::Memory_Tag>(i);
+            const auto stats = core::memory_tag_stats(tag);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(core::memory_tag_name(tag));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", static_cast<f64>(stats.live_bytes) / 1024.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", static_cast<f64>(stats.peak_bytes) / 1024.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.live_count));
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocations_last_frame));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.0f", static_cast<f64>(stats.allocations_last_frame) * frame_rate);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
 } // namespace zoo::imgui
@@ -29,6 +29,7 @@ private:
     void exit() noexcept;
 
     void draw_frame_buffer() noexcept;
+    void draw_memory_panel() noexcept;
 
 private:
     render::Engine& engine_;
@@ -8,13 +8,12 @@
 #include "render/device_context.hpp"
 #include "render/engine.hpp"
 #include "render/pipeline.hpp"
+#include "render/pipeline_factory.hpp"
 #include "render/resources/buffer.hpp"
 #include "render/resources/texture.hpp"
 #include "render/scene/upload_context.hpp"
 #include "render/sync/fence.hpp"
 
-#include "tools/shader_compiler.hpp"
-
 #include "imgui.h"
 #include "window.hpp"
 #include <stdio.h>
@@ -72,7 +71,8 @@ struct Imgui_Vulkan_Data {
     render::Resource_Bindings bindings;
 
     render::Render_Pass renderpass;
-    render::Pipeline pipeline;
+    render::Pipeline_Factory pipeline_factory{ context };
+    render::Pipeline_Handle pipeline;
     render::Descriptor_Pool descriptor_pool;
 
     Imgui_Viewport_Data* main_window_data;
@@ -96,6 +96,7 @@ render::resources::Buffer imgui_create_buffer(size_t count, VkBufferUsageFlagBit
         .count(count)
         .allocation_type(VMA_MEMORY_USAGE_AUTO)
         .allocation_flag(VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+        .pool(render::resources::Memory_Pool::frame)
         .build(bd.context.allocator());
 }
 
@@ -136,41 +137,33 @@ render::Render_Pass imgui_create_renderpass(render::Device_Context& context, VkF
     return { context, attachments };
 }
 
-render::Pipeline imgui_create_pipeline(render::Device_Context& context, const render::Render_Pass& renderpass) {
+render::Pipeline_Handle
+    imgui_create_pipeline(render::Pipeline_Factory& factory, const render::Render_Pass& renderpass) {
     std::array buffer_description{
         render::VertexBufferDescription{ 0, render::ShaderType::vec2, offsetof(ImDrawVert, pos) },
         render::VertexBufferDescription{ 1, render::ShaderType::vec2, offsetof(ImDrawVert, uv) },
         render::VertexBufferDescription{ 2, render::ShaderType::vec4_unorm, offsetof(ImDrawVert, col) }
     };
 
-    std::array vertex_description{
-        render::VertexInputDescription{ sizeof(ImDrawVert), buffer_description, VK_VERTEX_INPUT_RATE_VERTEX }
-    };
-
-    tools::Shader_Compiler shader_compiler;
-    render::Shader vertex_shader{ context, shader::glsl_vert_spv, "main" };
-    render::Shader fragment_shader{ context, shader::glsl_frag_spv, "main" };
-
     render::BindingDescriptor binding_descriptors[] = {
         { .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, .count = 1, .stage = VK_SHADER_STAGE_FRAGMENT_BIT }
     };
 
-    render::PushConstant push_constant_info = imgui_get_push_constant_descriptor();
-
-    render::PipelineCreateInfo pipeline_create_info{ false };
-
-    return render::Pipeline{ context,
-                             render::ShaderStagesSpecification{ vertex_shader, fragment_shader, vertex_description },
-                             renderpass,
-                             binding_descriptors,
-                             &push_constant_info,
-                             pipeline_create_info };
+    return factory.request(
+        { .vertex_spirv      = { std::begin(shader::glsl_vert_spv), std::end(shader::glsl_vert_spv) },
+          .fragment_spirv    = { std::begin(shader::glsl_frag_spv), std::end(shader::glsl_frag_spv) },
+          .vertex_attributes = { buffer_description.begin(), buffer_description.end() },
+          .vertex_stride     = sizeof(ImDrawVert),
+          .renderpass        = &renderpass,
+          .bindings          = { std::begin(binding_descriptors), std::end(binding_descriptors) },
+          .push_constants    = { imgui_get_push_constant_descriptor() },
+          .create_info       = render::PipelineCreateInfo{ false } });
 }
 
 void imgui_init_pipeline_and_descriptors(Imgui_Vulkan_Data& data, VkFormat format) {
     auto& device_ctx     = data.context;
     data.renderpass      = imgui_create_renderpass(device_ctx, format);
-    data.pipeline        = imgui_create_pipeline(device_ctx, data.renderpass);
+    data.pipeline        = imgui_create_pipeline(data.pipeline_factory, data.renderpass);
     data.descriptor_pool = render::Descriptor_Pool{ device_ctx, 1000 };
 }
 
@@ -187,6 +180,7 @@ render::resources::Texture
             .usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
             .allocation_type(VMA_MEMORY_USAGE_AUTO_PREFER_HOST)
             .allocation_flag(VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+            .pool(render::resources::Memory_Pool::staging)
             .build(device_ctx.allocator());
 
     auto map = scratch_buffer.map();
@@ -204,6 +198,7 @@ render::resources::Texture
                    .tiling(VK_IMAGE_TILING_OPTIMAL)
                    .allocation_type(VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE)
                    .allocation_required_flags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+                   .pool(render::resources::Memory_Pool::general)
                    .build(device_ctx.allocator());
 
     upload_ctx.copy(scratch_buffer, tex);
@@ -231,7 +226,8 @@ void imgui_setup_render_state(const ImDrawData& draw_data, Imgui_Frame_Data& fd,
         auto& translate = pcd.translate;
         translate[0]    = -1.0f - draw_data.DisplayPos.x * scale[0];
         translate[1]    = -1.0f - draw_data.DisplayPos.y * scale[1];
-        command_context.bind_pipeline(bd.pipeline);
+        // `imgui_render` already made sure it is compiled.
+        command_context.bind_pipeline(*bd.pipeline_factory.resolve(bd.pipeline));
         command_context.push_constants(imgui_get_push_constant_descriptor(), &pcd);
         command_context.bind_resources(bd.bindings);
     }
@@ -256,6 +252,9 @@ void imgui_render(const ImDrawData& draw_data, Imgui_Frame_Data& fd) {
     // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates != framebuffer
     // coordinates)
     if (!imgui_should_render(draw_data)) return;
+    // the first frames go by while the pipeline compiles, they only clear.
+    auto& bd = imgui_get_render_static_data();
+    if (bd.pipeline_factory.resolve(bd.pipeline) == nullptr) return;
 
     int fb_width          = (int)(draw_data.DisplaySize.x * draw_data.FramebufferScale.x);
     int fb_height         = (int)(draw_data.DisplaySize.y * draw_data.FramebufferScale.y);
@@ -265,11 +264,13 @@ void imgui_render(const ImDrawData& draw_data, Imgui_Frame_Data& fd) {
     // If there is data to be drawn.
     if (draw_data.TotalVtxCount > 0) {
         // assure size is enough.
+        // grow geometrically so that a ui that keeps getting busier doesn't reallocate every frame.
         if (!fd.vertex || fd.vertex.count() < (size_t)draw_data.TotalVtxCount)
-            fd.vertex = imgui_create_buffer<ImDrawVert>(draw_data.TotalVtxCount, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+            fd.vertex =
+                imgui_create_buffer<ImDrawVert>(draw_data.TotalVtxCount * 2, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
 
         if (!fd.index || fd.index.count() < (size_t)draw_data.TotalIdxCount)
-            fd.index = imgui_create_buffer<ImDrawIdx>(draw_data.TotalIdxCount, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+            fd.index = imgui_create_buffer<ImDrawIdx>(draw_data.TotalIdxCount * 2, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
 
         // Upload vertex/index data into a single contiguous GPU buffer
         ImDrawVert* vtx_dst = fd.vertex.map<ImDrawVert>();
@@ -295,7 +296,6 @@ void imgui_render(const ImDrawData& draw_data, Imgui_Frame_Data& fd) {
     ImVec2 clip_off   = draw_data.DisplayPos;       // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data.FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
-    auto& bd                                      = imgui_get_render_static_data();
     render::Resource_Bindings* current_bind_state = &bd.bindings;
     // Render command lists
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
@@ -508,7 +508,7 @@ void imgui_init_static_render_objects(Imgui_Vulkan_Data& vk_data, VkFormat image
                                .max_anisotrophy(1.f)
                                .build(vk_data.context);
 
-    auto b = vk_data.descriptor_pool.allocate(vk_data.pipeline);
+    auto b = vk_data.descriptor_pool.allocate(vk_data.pipeline_factory.pipeline(vk_data.pipeline));
     b.start_batch()
         .bind(0, vk_data.font_tex, vk_data.font_sampler, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
         .end_batch();
@@ -610,7 +610,8 @@ void imgui_render_exit() {
 
 const render::Pipeline& imgui_get_pipeline() {
     auto& vd = imgui_get_render_static_data();
-    return vd.pipeline;
+    // only its layouts are needed, which are there before it is compiled.
+    return vd.pipeline_factory.pipeline(vd.pipeline);
 }
 
 void imgui_render_frame_render() {
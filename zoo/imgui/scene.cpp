@@ -18,12 +18,15 @@
 #include "stdx/expected.hpp"
 
 #include "imgui/layer.hpp"
+#include "tools/embedded_shaders.hpp"
 #include "tools/shader_compiler.hpp"
 
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <string_view>
@@ -80,31 +83,38 @@ render::resources::Texture create_render_buffer(render::Device_Context& context,
         .extent({ x, y, 1 })
         .allocation_type(VMA_MEMORY_USAGE_GPU_ONLY)
         .allocation_required_flags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+        .pool(render::resources::Memory_Pool::render_target)
         .build(context.allocator());
 }
 
-render::resources::Texture create_depth_buffer(render::Device_Context& context, u32 x, u32 y) noexcept {
-    return render::resources::Texture::start_build("Depth-ImguiFrameBuffer")
-        .format(DEPTH_FORMAT)
-        .usage(VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)
-        .extent({ x, y, 1 })
-        .allocation_type(VMA_MEMORY_USAGE_GPU_ONLY)
-        .allocation_required_flags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
-        .build(context.allocator());
-}
+constexpr std::string_view SHADER_DIRECTORY = "static/shaders";
+constexpr std::string_view VERTEX_SHADER    = "static/shaders/test.vert";
+constexpr std::string_view FRAGMENT_SHADER  = "static/shaders/test.frag";
+constexpr std::string_view SCENE_TEXTURE    = "static/assets/lost_empire-RGBA.png";
 
 Shaders read_shaders() noexcept {
+#if defined(ZOO_EMBEDDED_SHADERS)
+    // compiled by the build, nothing to read or compile.
+    const auto vertex   = tools::find_embedded_shader(VERTEX_SHADER);
+    const auto fragment = tools::find_embedded_shader(FRAGMENT_SHADER);
+    ZOO_ASSERT(vertex.size() != 0 && fragment.size() != 0, "test shaders must be embedded!");
+    return { .vertex   = { vertex.data(), vertex.data() + vertex.size() },
+             .fragment = { fragment.data(), fragment.data() + fragment.size() } };
+#else
     tools::Shader_Compiler compiler;
-    auto vertex_bytes = core::read_file("static/shaders/Test.vert");
+    auto vertex_bytes = core::read_file(VERTEX_SHADER);
     ZOO_ASSERT(vertex_bytes, "vertex shader must have value!");
-    auto fragment_bytes = core::read_file("static/shaders/Test.frag");
+    auto fragment_bytes = core::read_file(FRAGMENT_SHADER);
     ZOO_ASSERT(fragment_bytes, "fragment shader must have value!");
 
-    tools::Shader_Work vertex_work{ shaderc_vertex_shader, "Test.vert", *vertex_bytes };
-    tools::Shader_Work fragment_work{ shaderc_fragment_shader, "Test.frag", *fragment_bytes };
+    const tools::Shader_Work works[] = {
+        { shaderc_vertex_shader, tools::shader_name(VERTEX_SHADER), *vertex_bytes },
+        { shaderc_fragment_shader, tools::shader_name(FRAGMENT_SHADER), *fragment_bytes },
+    };
 
-    auto vertex_spirv   = compiler.compile(vertex_work);
-    auto fragment_spirv = compiler.compile(fragment_work);
+    auto results         = compiler.compile_batch(works);
+    auto& vertex_spirv   = results[0].spirv;
+    auto& fragment_spirv = results[1].spirv;
 
     if (!vertex_spirv) {
         spdlog::error("Vertex has error : {}", vertex_spirv.error().what());
@@ -115,6 +125,7 @@ Shaders read_shaders() noexcept {
     }
 
     return { .vertex = std::move(*vertex_spirv), .fragment = std::move(*fragment_spirv) };
+#endif
 }
 
 render::resources::Texture load_image_from_file(
@@ -141,11 +152,13 @@ render::resources::Texture load_image_from_file(
     void* pixel_ptr   = reinterpret_cast<void*>(pixels.get());
     size_t image_size = tex_details.width * tex_details.height * 4;
 
+    const auto scratch_name = core::format_name("ScratchBuffer for texture : {}", file_name);
     render::resources::Buffer scratch_buffer =
-        render::resources::Buffer::start_build(fmt::format("ScratchBuffer for texture : {}", file_name), image_size)
+        render::resources::Buffer::start_build(scratch_name, image_size)
             .usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
             .allocation_type(VMA_MEMORY_USAGE_AUTO_PREFER_HOST)
             .allocation_flag(VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+            .pool(render::resources::Memory_Pool::staging)
             .build(context.allocator());
 
     scratch_buffer.map(
@@ -162,6 +175,7 @@ render::resources::Texture load_image_from_file(
                        .usage(VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT)
                        .allocation_type(VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE)
                        .allocation_required_flags(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+                       .pool(render::resources::Memory_Pool::general)
                        .build(context.allocator());
 
     upload_context.copy(scratch_buffer, texture);
@@ -182,38 +196,40 @@ size_t pad_uniform_buffer_size(const render::Device_Context& context, size_t ori
 } // namespace
 
 Imgui_Scene::Imgui_Scene(render::Engine& engine, s32 width, s32 height) noexcept :
-    engine_(engine), width_(width), height_(height) {
+    engine_(engine), width_(width), height_(height), pipeline_factory_(engine.context(), MAX_FRAMES),
+    render_graph_(engine.context()), defragmenter_(engine.context()) {
     init();
 }
 
 void Imgui_Scene::init() noexcept {
+    ZOO_MEMORY_TAG(core::Memory_Tag::render);
     auto& context                       = engine_.context();
     auto [vertex_bytes, fragment_bytes] = read_shaders();
-    render::Shader vertex_shader{ context, vertex_bytes, "main" };
-    render::Shader fragment_shader{ context, fragment_bytes, "main" };
+    vertex_spirv_                       = std::move(vertex_bytes);
+    fragment_spirv_                     = std::move(fragment_bytes);
+
+#if !defined(ZOO_EMBEDDED_SHADERS)
+    // embedded shaders have no files to watch.
+    shader_reloader_.start(SHADER_DIRECTORY);
+#endif
 
     render::scene::Upload_Context upload_cmd_buffer{ context };
 
     // upload gpu memory
     mesh_                = { context.allocator(), upload_cmd_buffer, "static/assets", "lost_empire.obj" };
-    lost_empire_         = load_image_from_file(context, upload_cmd_buffer, "static/assets/lost_empire-RGBA.png");
+    lost_empire_         = load_image_from_file(context, upload_cmd_buffer, SCENE_TEXTURE);
     lost_empire_sampler_ = render::resources::TextureSampler::start_build()
                                .mag_filter(VK_FILTER_NEAREST)
                                .min_filter(VK_FILTER_NEAREST)
                                .build(context);
     upload_cmd_buffer.submit();
 
+    // only has to be compatible with the pass `render_graph_` creates, which just needs the same formats.
     render::AttachmentDescription attachments[] = { render::ColorAttachmentDescription(COLOR_IMAGE_FORMAT),
                                                     render::DepthAttachmentDescription() };
-    attachments[0].description.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
     renderpass_ = { context, attachments };
 
-    auto buffer_description = render::resources::Vertex::describe();
-    std::array vertex_description{ render::VertexInputDescription{ sizeof(render::resources::Vertex),
-                                                                   buffer_description,
-                                                                   VK_VERTEX_INPUT_RATE_VERTEX } };
-
+    const auto buffer_description = render::resources::Vertex::describe();
     render::BindingDescriptor binding_descriptors[] = {
         { .type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .count = 1, .stage = VK_SHADER_STAGE_VERTEX_BIT },
         { .type  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
@@ -226,11 +242,15 @@ void Imgui_Scene::init() noexcept {
           .set   = 2 }
     };
 
-    pipeline_ = { context,
-                  render::ShaderStagesSpecification{ vertex_shader, fragment_shader, vertex_description },
-                  renderpass_,
-                  binding_descriptors,
-                  { &push_constant, 1 } };
+    // compiles while the assets upload, the scene is drawn without the mesh until it is done.
+    pipeline_ = pipeline_factory_.request(
+        { .vertex_spirv      = vertex_spirv_,
+          .fragment_spirv    = fragment_spirv_,
+          .vertex_attributes = { buffer_description.begin(), buffer_description.end() },
+          .vertex_stride     = sizeof(render::resources::Vertex),
+          .renderpass        = &renderpass_,
+          .bindings          = { std::begin(binding_descriptors), std::end(binding_descriptors) },
+          .push_constants    = { push_constant } });
 
     descriptor_pool_ = { context };
 
@@ -240,10 +260,18 @@ void Imgui_Scene::init() noexcept {
                              .usage(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
                              .allocation_type(VMA_MEMORY_USAGE_AUTO)
                              .allocation_flag(VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+                             .pool(render::resources::Memory_Pool::frame)
                              .build(context.allocator());
 
+    defragmenter_.on_relocate([this](const render::resources::Defragmenter::Relocation& relocation) {
+        if (relocation.resource != &lost_empire_) return;
+        for (auto& frame_data : frame_datas_)
+            frame_data.texture_binding_dirty = true;
+    });
+
     start_time_ = std::chrono::high_resolution_clock::now();
     upload_cmd_buffer.wait();
+    track_texture();
 }
 
 Imgui_Scene::~Imgui_Scene() noexcept { exit(); }
@@ -252,6 +280,10 @@ void Imgui_Scene::exit() noexcept {
     // TODO: we can remove this after we find out how to properly tie
     // resources to each frame.
     engine_.context().wait();
+
+    // the eviction callback points back at the scene, which may go away before the allocator does.
+    engine_.context().allocator().budget().untrack(lost_empire_streamable_);
+    lost_empire_streamable_ = render::resources::Memory_Budget::INVALID_STREAMABLE;
 }
 
 void Imgui_Scene::allocate_frame_buffer(const render::Pipeline& pipeline) noexcept {
@@ -261,20 +293,22 @@ void Imgui_Scene::allocate_frame_buffer(const render::Pipeline& pipeline) noexce
     for (s32 i = 0; i < MAX_FRAMES; ++i) {
         auto& frame_data = frame_datas_[i];
 
-        const auto uniform_buffer_name = fmt::format("Uniform buffer : {}", i);
-        const auto object_buffer_name  = fmt::format("Object buffer : {}", i);
+        const auto uniform_buffer_name = core::format_name("Uniform buffer : {}", i);
+        const auto object_buffer_name  = core::format_name("Object buffer : {}", i);
         frame_data.uniform_buffer = render::resources::Buffer::start_build<Uniform_Buffer_Data>(uniform_buffer_name)
                                         .usage(VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
                                         .allocation_type(VMA_MEMORY_USAGE_CPU_TO_GPU)
+                                        .pool(render::resources::Memory_Pool::frame)
                                         .build(context.allocator());
 
         frame_data.object_storage_buffer = render::resources::Buffer::start_build<Object_Data>(object_buffer_name)
                                                .count(MAX_OBJECTS)
                                                .usage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
                                                .allocation_type(VMA_MEMORY_USAGE_CPU_TO_GPU)
+                                               .pool(render::resources::Memory_Pool::frame)
                                                .build(context.allocator());
 
-        frame_data.bindings = descriptor_pool_.allocate(pipeline_);
+        frame_data.bindings = descriptor_pool_.allocate(pipeline_factory_.pipeline(pipeline_));
 
         // clang-format off
        frame_data.bindings.start_batch()
@@ -293,10 +327,6 @@ void Imgui_Scene::allocate_frame_buffer(const render::Pipeline& pipeline) noexce
                                         .mag_filter(VK_FILTER_NEAREST)
                                         .min_filter(VK_FILTER_NEAREST)
                                         .build(context);
-        frame_data.depth_buffer                    = create_depth_buffer(context, width_, height_);
-        const render::resources::TextureView* tv[] = { &(frame_data.render_buffer.view()),
-                                                       &(frame_data.depth_buffer.view()) };
-        frame_data.render_target  = render::Framebuffer{ context, renderpass_, tv, (u32)width_, (u32)height_ };
         frame_data.render_binding = descriptor_pool_.allocate(pipeline);
 
         frame_data.render_binding.start_batch()
@@ -312,6 +342,7 @@ const render::Resource_Bindings*
     Imgui_Scene::ensure_frame_buffers_and_update(const render::Pipeline& pipeline, s32 width, s32 height) noexcept {
     if (width <= 0) return nullptr;
     if (height <= 0) return nullptr;
+    ZOO_MEMORY_TAG(core::Memory_Tag::render);
 
     width_ = width;
     height_ = height;
@@ -321,6 +352,20 @@ const render::Resource_Bindings*
     auto& frame_data = frame_datas_[index_];
     frame_data.in_flight_fence.wait();
     frame_data.in_flight_fence.reset();
+    frame_allocator_.begin_frame(index_);
+    check_frame_allocations();
+    frame_data.evicted_texture = {};
+    context.allocator().budget().update();
+    stream_texture();
+    defragmenter_.update();
+
+    pipeline_factory_.update();
+    reload_shaders();
+
+    if (frame_data.texture_binding_dirty && lost_empire_.valid()) {
+        frame_data.bindings.start_batch().bind(2, 0, lost_empire_, lost_empire_sampler_).end_batch();
+        frame_data.texture_binding_dirty = false;
+    }
 
     if (width_ != frame_data.width) {
         resized = true;
@@ -333,11 +378,11 @@ const render::Resource_Bindings*
     }
 
     if (resized) {
-        frame_data.render_buffer                   = create_render_buffer(context, width, height);
-        frame_data.depth_buffer                    = create_depth_buffer(context, width, height);
-        const render::resources::TextureView* tv[] = { &(frame_data.render_buffer.view()),
-                                                        &(frame_data.depth_buffer.view()) };
-        frame_data.render_target  = render::Framebuffer{ context, renderpass_, tv, (u32)width, (u32)height };
+        // resizes are rare enough to be a good point to compact the long lived resources.
+        if (!defragmenter_.active()) defragmenter_.start(render::resources::Memory_Pool::general);
+
+        // the new size changes the graph's topology, it recompiles the next time it runs.
+        frame_data.render_buffer  = create_render_buffer(context, width, height);
         frame_data.render_binding = descriptor_pool_.allocate(pipeline);
 
         frame_data.render_binding.start_batch()
@@ -401,27 +446,138 @@ const render::Resource_Bindings& Imgui_Scene::update() noexcept {
         .extent = { (u32)width_, (u32)height_ },
     };
 
-    command_context.set_viewport(viewport);
-    command_context.set_scissor(scissor);
+    // the imgui layer samples the target once this frame is done, the graph leaves it readable for that.
+    const auto color =
+        render_graph_.import("RT-ImguiFrameBuffer", frame_data.render_buffer, render::Graph_Access::sampled);
+
+    // evicted textures are only drawn again once they were streamed back in.
+    const render::Pipeline* pipeline = lost_empire_.valid() ? pipeline_factory_.resolve(pipeline_) : nullptr;
+    if (pipeline != nullptr) context.allocator().budget().touch(lost_empire_streamable_);
+
+    auto scene_pass =
+        render_graph_.add_pass("Scene", [&](render::scene::Command_Buffer& cmd, const render::Render_Graph&) {
+            cmd.set_viewport(viewport);
+            cmd.set_scissor(scissor);
 
-    VkClearValue depth_clear{};
-    depth_clear.depthStencil.depth = 1.f;
+            // still compiling or the texture is evicted, the pass only clears.
+            if (pipeline == nullptr) return;
 
-    VkClearValue clear_color[]     = { { { { 0.1f, 0.1f, 0.1f, 1.0f } } }, depth_clear };
-    command_context.begin_renderpass(frame_data.render_target, clear_color);
+            cmd.bind_pipeline(*pipeline);
+            cmd.push_constants(push_constant, &push_constant_data);
+            cmd.bind_resources(frame_data.bindings, { &offset, 1 });
 
-    command_context.bind_pipeline(pipeline_);
-    command_context.push_constants(push_constant, &push_constant_data);
-    command_context.bind_resources(frame_data.bindings, { &offset, 1 });
+            cmd.bind_mesh(mesh_);
+            cmd.draw_indexed(1);
+        });
 
-    command_context.bind_mesh(mesh_);
-    command_context.draw_indexed(1);
+    const auto depth = scene_pass.create(
+        "Depth-ImguiFrameBuffer",
+        { .format = DEPTH_FORMAT, .width = (u32)frame_data.width, .height = (u32)frame_data.height });
+    scene_pass.write_color(color, VkClearColorValue{ { 0.1f, 0.1f, 0.1f, 1.0f } });
+    scene_pass.write_depth(depth, VkClearDepthStencilValue{ .depth = 1.f, .stencil = 0 });
 
-    command_context.end_renderpass();
+    render_graph_.execute(command_context, frame_allocator_.current());
     command_context.submit(nullptr, nullptr, nullptr, frame_data.in_flight_fence);
 
     index_ = (index_ + 1) % MAX_FRAMES;
     return frame_data.render_binding;
 }
 
+void Imgui_Scene::track_texture() noexcept {
+    if (!lost_empire_.valid()) return;
+
+    auto& budget            = engine_.context().allocator().budget();
+    lost_empire_heap_       = budget.heap_index(lost_empire_.allocation());
+    lost_empire_size_       = lost_empire_.allocated_size();
+    lost_empire_streamable_ = budget.track(lost_empire_.allocation(), [this]() noexcept {
+        ZOO_LOG_INFO("Evicted {}, the scene is drawn without it until it fits again", SCENE_TEXTURE);
+
+        // called at the start of the frame at `index_`, frames still in flight may sample it until that frame's
+        // fence was waited on again.
+        lost_empire_streamable_              = render::resources::Memory_Budget::INVALID_STREAMABLE;
+        frame_datas_[index_].evicted_texture = std::move(lost_empire_);
+    });
+}
+
+void Imgui_Scene::stream_texture() noexcept {
+    if (lost_empire_.valid()) return;
+
+    // only comes back once it fits below the eviction target, otherwise it would be evicted again right away.
+    auto& context      = engine_.context();
+    const auto& budget = context.allocator().budget();
+    const auto& heap   = budget.heap(lost_empire_heap_);
+    const auto target  = static_cast<VkDeviceSize>(
+        static_cast<f64>(heap.budget) * render::resources::Memory_Budget::EVICTION_TARGET);
+    if (heap.usage + lost_empire_size_ > target) return;
+
+    render::scene::Upload_Context upload_context{ context };
+    lost_empire_ = load_image_from_file(context, upload_context, SCENE_TEXTURE);
+    upload_context.submit();
+    upload_context.wait();
+    if (!lost_empire_.valid()) return;
+
+    ZOO_LOG_INFO("Streamed {} back in", SCENE_TEXTURE);
+    track_texture();
+    for (auto& frame_data : frame_datas_)
+        frame_data.texture_binding_dirty = true;
+}
+
+void Imgui_Scene::check_frame_allocations() noexcept {
+    const bool warmed_up = ++frame_number_ > WARM_UP_FRAMES;
+
+    const auto& host_allocator = engine_.host_allocator();
+    for (u32 scope = 0; scope < render::Host_Allocator::SCOPE_COUNT; ++scope) {
+        const auto vk_scope      = static_cast<VkSystemAllocationScope>(scope);
+        const u64 total          = host_allocator.stats(vk_scope).total_count;
+        const u64 count          = total - host_allocations_[scope];
+        host_allocations_[scope] = total;
+
+        // command scope allocations come from the thread local arenas and are expected every frame.
+        if (vk_scope == VK_SYSTEM_ALLOCATION_SCOPE_COMMAND) continue;
+
+        if (warmed_up && count != 0 && !allocating_[scope]) {
+            ZOO_LOG_WARN(
+                "Frame {} made {} vulkan host allocations in {} scope",
+                frame_number_ - 1,
+                count,
+                render::Host_Allocator::scope_name(vk_scope));
+        }
+        allocating_[scope] = count != 0;
+    }
+
+    const u64 heap_allocations = frame_allocator_.heap_allocations_last_frame();
+    auto& heap_allocating      = allocating_[render::Host_Allocator::SCOPE_COUNT];
+    if (warmed_up && heap_allocations != 0 && !heap_allocating)
+        ZOO_LOG_WARN("Frame {} made {} heap allocations", frame_number_ - 1, heap_allocations);
+    heap_allocating = heap_allocations != 0;
+}
+
+void Imgui_Scene::reload_shaders() noexcept {
+    auto reloads = shader_reloader_.take();
+    if (reloads.empty()) return;
+
+    std::chrono::steady_clock::time_point noticed = std::chrono::steady_clock::time_point::max();
+    std::chrono::nanoseconds compile_time         = {};
+    bool changed                                  = false;
+    for (auto& reload : reloads) {
+        std::vector<u32>* spirv = reload.path == VERTEX_SHADER     ? &vertex_spirv_
+                                  : reload.path == FRAGMENT_SHADER ? &fragment_spirv_
+                                                                   : nullptr;
+        if (spirv == nullptr) continue;
+
+        *spirv       = std::move(reload.spirv);
+        noticed      = std::min(noticed, reload.noticed);
+        compile_time = std::max(compile_time, reload.compile_time);
+        changed      = true;
+    }
+    if (!changed) return;
+
+    // compiles on the worker pool, the old pipeline keeps drawing until `pipeline_factory_` swaps the new one in and
+    // logs how long after the change was noticed that happened.
+    ZOO_LOG_INFO(
+        "Recompiled scene shaders in {:.2f}ms, rebuilding the pipeline",
+        std::chrono::duration<double, std::milli>(compile_time).count());
+    pipeline_factory_.rebuild(pipeline_, vertex_spirv_, fragment_spirv_, noticed);
+}
+
 } // namespace zoo
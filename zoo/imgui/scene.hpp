@@ -1,13 +1,20 @@
 #pragma once
 
+#include "core/allocator.hpp"
 #include "render/descriptor_pool.hpp"
 #include "render/engine.hpp"
 #include "render/framebuffer.hpp"
 #include "render/pipeline.hpp"
+#include "render/pipeline_factory.hpp"
+#include "render/render_graph.hpp"
 #include "render/resources/buffer.hpp"
+#include "render/resources/defragmenter.hpp"
 #include "render/resources/texture.hpp"
 #include "render/scene/command_buffer.hpp"
 #include "render/sync/fence.hpp"
+#include "tools/shader_reloader.hpp"
+
+#include <vector>
 
 namespace zoo {
 
@@ -21,25 +28,57 @@ struct Imgui_Scene {
     const render::Resource_Bindings*
         ensure_frame_buffers_and_update(const render::Pipeline& pipeline, s32 width, s32 height) noexcept;
 
+    static constexpr s32 MAX_FRAMES = 3;
+
+    // scratch memory for the frame currently being recorded, valid until the frame's fence is waited on again.
+    core::Arena& frame_arena() noexcept { return frame_allocator_.current(); }
+    const core::Frame_Allocator<MAX_FRAMES>& frame_allocator() const noexcept { return frame_allocator_; }
+
 private:
-    static constexpr s32 MAX_FRAMES  = 3;
     static constexpr s32 MAX_OBJECTS = 10'000;
+    // the first frames create descriptor sets, the graph's transients and whatever the driver sets up lazily.
+    static constexpr u64 WARM_UP_FRAMES = 2 * MAX_FRAMES;
 
     const render::Resource_Bindings& update() noexcept;
 
+    // rebuilds the pipeline for shaders that were reloaded, called at the start of a frame.
+    void reload_shaders() noexcept;
+
+    // registers `lost_empire_` as streamable with the device memory budget, which evicts it when its heap runs low.
+    void track_texture() noexcept;
+    // loads `lost_empire_` again after it was evicted, once its heap has room for it.
+    void stream_texture() noexcept;
+
+    // warns when a frame after warm-up allocates from the general heap or through vulkan's host allocation callbacks
+    // after a frame that didn't, the steady state frame loop is expected to leave both counters flat.
+    void check_frame_allocations() noexcept;
+
 private:
     render::Engine& engine_;
     s32 width_;
     s32 height_;
 
-    render::Pipeline pipeline_;
+    // spir-v `pipeline_` was built from, a reload of one stage rebuilds it with the other stage as it was.
+    std::vector<u32> vertex_spirv_;
+    std::vector<u32> fragment_spirv_;
+    tools::Shader_Reloader shader_reloader_;
+    // only used to create `pipeline_`, the render graph owns the render passes that are actually recorded.
     render::Render_Pass renderpass_;
+    // after `renderpass_`, pipelines still compiling against it are waited for before it is destroyed.
+    render::Pipeline_Factory pipeline_factory_;
+    render::Pipeline_Handle pipeline_;
     render::Descriptor_Pool descriptor_pool_;
+    render::Render_Graph render_graph_;
     render::resources::Buffer scene_data_buffer_;
 
     render::resources::Mesh mesh_;
     render::resources::Texture lost_empire_;
     render::resources::TextureSampler lost_empire_sampler_;
+    render::resources::Memory_Budget::streamable_id lost_empire_streamable_ =
+        render::resources::Memory_Budget::INVALID_STREAMABLE;
+    // where `lost_empire_` lived before it was evicted and how much it needs to come back.
+    u32 lost_empire_heap_          = 0;
+    VkDeviceSize lost_empire_size_ = 0;
 
     struct Frame_Data {
         render::resources::Buffer uniform_buffer;
@@ -51,18 +90,31 @@ private:
         render::scene::Command_Buffer command_buffer;
         render::sync::Fence in_flight_fence;
 
-        // resize stuff
+        // resize stuff, the depth buffer is a transient of `render_graph_` shared by every frame.
         render::Resource_Bindings render_binding;
         render::resources::Texture render_buffer;
-        render::resources::Texture depth_buffer;
-        render::Framebuffer render_target;
 
         s32 width;
         s32 height;
+
+        // `lost_empire_` was moved by the defragmenter or streamed back in, `bindings` still points at the old image.
+        bool texture_binding_dirty = false;
+        // `lost_empire_` after it was evicted, released once this frame's fence was waited on again.
+        render::resources::Texture evicted_texture;
     };
 
     s32 index_ = 0;
     Frame_Data frame_datas_[MAX_FRAMES];
+    core::Frame_Allocator<MAX_FRAMES> frame_allocator_;
+
+    // frames started so far and the per scope `total_count` of the engine's host allocator when the last one did.
+    u64 frame_number_                                          = 0;
+    u64 host_allocations_[render::Host_Allocator::SCOPE_COUNT] = {};
+    // the last frame allocated in that scope, the general heap is the entry after the vulkan scopes.
+    bool allocating_[render::Host_Allocator::SCOPE_COUNT + 1] = {};
+
+    // declared after everything it may move so that it finishes its pass before they are destroyed.
+    render::resources::Defragmenter defragmenter_;
     std::chrono::high_resolution_clock::time_point start_time_;
 };
 } // namespace zoo
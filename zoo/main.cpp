@@ -3,11 +3,18 @@
 
 #include "core/window.hpp"
 #include "render/engine.hpp"
+#include "tools/shader_compiler.hpp"
 #include "utility/array.hpp"
 
 #include "core/macros.hpp"
 #include "render/vulkan.hpp"
 
+#include "stdx/thread_pool.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+
 #if 0
 void render_api_test() {
     using namespace zoo;
@@ -68,14 +75,155 @@ void demo() {
 }
 #endif
 
+// everything `demo` does up to its first frame, once without anything cached on disk and once with what the first run
+// left behind.
+void startup_benchmark() {
+    using namespace zoo;
+
+    struct Startup {
+        double total_ms     = 0;
+        double pipelines_ms = 0;
+    };
+
+    const auto startup = []() {
+        const auto start = std::chrono::steady_clock::now();
+
+        render::Engine render_engine{};
+        Window main_window{ 1280, 960, "Zoo" };
+        imgui::Layer layer{ render_engine, main_window };
+        layer.update();
+        layer.render();
+        render_engine.context().wait();
+
+        // the cache is saved on the way out, that is not part of starting up.
+        const render::Pipeline_Cache& cache = render_engine.context().pipeline_cache();
+        return Startup{
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+            std::chrono::duration<double, std::milli>(cache.creation_time()).count(),
+        };
+    };
+
+    std::error_code error;
+    std::filesystem::remove_all(render::Pipeline_Cache::DIRECTORY, error);
+
+    const Startup cold = startup();
+    const Startup warm = startup();
+    ZOO_LOG_INFO("Cold startup {:.2f}ms, {:.2f}ms of it creating pipelines", cold.total_ms, cold.pipelines_ms);
+    ZOO_LOG_INFO("Warm startup {:.2f}ms, {:.2f}ms of it creating pipelines", warm.total_ms, warm.pipelines_ms);
+    ZOO_LOG_INFO(
+        "Warm is {:.2f}x faster to start, {:.2f}x faster creating pipelines",
+        cold.total_ms / warm.total_ms,
+        warm.pipelines_ms > 0 ? cold.pipelines_ms / warm.pipelines_ms : 0.0);
+}
+
+// the shaders `Imgui_Scene` builds on startup, compiled with an empty shader cache and then with what it left behind.
+// then the same shaders as many permutations, to see how batch compilation scales with the worker pool.
+void shader_benchmark() {
+    using namespace zoo;
+    constexpr u32 ITERATIONS = 10;
+
+    constexpr std::string_view VERTEX_SHADER   = "static/shaders/test.vert";
+    constexpr std::string_view FRAGMENT_SHADER = "static/shaders/test.frag";
+
+    auto vertex_bytes = core::read_file(VERTEX_SHADER);
+    ZOO_ASSERT(vertex_bytes, "vertex shader must have value!");
+    auto fragment_bytes = core::read_file(FRAGMENT_SHADER);
+    ZOO_ASSERT(fragment_bytes, "fragment shader must have value!");
+
+    const tools::Shader_Work vertex_work{ shaderc_vertex_shader, tools::shader_name(VERTEX_SHADER), *vertex_bytes };
+    const tools::Shader_Work fragment_work{
+        shaderc_fragment_shader, tools::shader_name(FRAGMENT_SHADER), *fragment_bytes
+    };
+
+    const auto elapsed_ms = [](auto start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    const auto setup = [&]() {
+        const auto start = std::chrono::steady_clock::now();
+        tools::Shader_Compiler compiler;
+        auto vertex_spirv   = compiler.compile(vertex_work);
+        auto fragment_spirv = compiler.compile(fragment_work);
+        ZOO_ASSERT(vertex_spirv && fragment_spirv, "benchmark shaders have to compile!");
+        return elapsed_ms(start);
+    };
+
+    std::error_code error;
+    double cold_ms = 0;
+    double warm_ms = 0;
+    for (u32 i = 0; i < ITERATIONS; ++i) {
+        std::filesystem::remove_all(tools::Shader_Cache::DIRECTORY, error);
+        cold_ms += setup();
+    }
+    for (u32 i = 0; i < ITERATIONS; ++i)
+        warm_ms += setup();
+
+    ZOO_LOG_INFO(
+        "Shader setup cold {:.3f}ms, warm {:.3f}ms ({:.2f}x)",
+        cold_ms / ITERATIONS,
+        warm_ms / ITERATIONS,
+        cold_ms / warm_ms);
+
+    // permutations of the same shaders, every one of them a cache miss. compiled one at a time and then as one batch.
+    constexpr u32 PERMUTATIONS = 32;
+    std::vector<tools::Shader_Def_Type> defines(PERMUTATIONS);
+    std::vector<tools::Shader_Work> permutations;
+    for (u32 i = 0; i < PERMUTATIONS; ++i) {
+        defines[i]                     = { "ZOO_PERMUTATION", std::to_string(i) };
+        const tools::Shader_Work& work = i % 2 == 0 ? vertex_work : fragment_work;
+        permutations.push_back({ work.kind, work.name, work.bytes, { &defines[i], 1 } });
+    }
+
+    std::filesystem::remove_all(tools::Shader_Cache::DIRECTORY, error);
+    auto start = std::chrono::steady_clock::now();
+    {
+        tools::Shader_Compiler compiler;
+        for (const auto& work : permutations) {
+            const auto spirv = compiler.compile(work);
+            ZOO_ASSERT(spirv, "benchmark shaders have to compile!");
+        }
+    }
+    const double serial_ms = elapsed_ms(start);
+
+    std::filesystem::remove_all(tools::Shader_Cache::DIRECTORY, error);
+    start          = std::chrono::steady_clock::now();
+    double busy_ms = 0;
+    {
+        tools::Shader_Compiler compiler;
+        for (const auto& result : compiler.compile_batch(permutations)) {
+            ZOO_ASSERT(result.spirv, "benchmark shaders have to compile!");
+            busy_ms += std::chrono::duration<double, std::milli>(result.duration).count();
+        }
+    }
+    const double batch_ms = elapsed_ms(start);
+
+    ZOO_LOG_INFO(
+        "{} permutations on {} threads: one at a time {:.2f}ms, batched {:.2f}ms ({:.2f}x, {:.2f}ms of compiling)",
+        PERMUTATIONS,
+        stdx::worker_pool().worker_count() + 1,
+        serial_ms,
+        batch_ms,
+        serial_ms / batch_ms,
+        busy_ms);
+}
+
 
 // @TODO: change this to WinMain
 int main(int argc, char* argv[]) { // NOLINT
-    static_cast<void>(argc);
-    static_cast<void>(argv);
-
     using namespace zoo;
     core::check_memory();
+
+    // the main thread joins in on every parallel loop, leave it a core.
+    stdx::set_worker_count(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    if (argc > 1 && std::strcmp(argv[1], "--bench-startup") == 0) {
+        startup_benchmark();
+        return 0;
+    }
+    if (argc > 1 && std::strcmp(argv[1], "--bench-shaders") == 0) {
+        shader_benchmark();
+        return 0;
+    }
+
     demo();
     #if 0
     Window window{ 1280, 960, "Zoo" };
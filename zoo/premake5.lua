@@ -1,3 +1,9 @@
+-- per tag heap tracking puts a header in front of every allocation, it's always on in Debug and opt-in elsewhere.
+newoption {
+    trigger     = "track-allocations",
+    description = "Track heap allocations per memory tag in every zoo configuration"
+}
+
 project "zoo"
     language "C++"
     cppdialect "C++20"
@@ -35,6 +41,8 @@ project "zoo"
         "%{library_dir.vulkan}"
     }
 
+    embed_shaders "static/shaders"
+
     warnings "Extra"
 
     --defines for msvc compiler
@@ -47,9 +55,10 @@ project "zoo"
     kind "ConsoleApp"
     systemversion "latest"
     defines {}
+    links { "pthread" }
 
     filter "configurations:Debug"
-        defines { "ZOO_ENABLE_LOGS" }
+        defines { "ZOO_ENABLE_LOGS", "ZOO_TRACK_ALLOCATIONS" }
         runtime "Debug"
         symbols "on"
         links {
@@ -65,10 +74,12 @@ project "zoo"
         }
 
     filter "configurations:Dist"
-        defines { "ZOO_DIST" }
+        defines { "ZOO_DIST", "ZOO_EMBEDDED_SHADERS" }
         runtime "Release"
         optimize "on"
         links {
             "%{library_dir.shaderc}"
         }
 
+    filter "options:track-allocations"
+        defines { "ZOO_TRACK_ALLOCATIONS" }
@@ -160,7 +160,7 @@ Resource_Bindings& Resource_Bindings::operator=(Resource_Bindings&& o) noexcept
 }
 
 Descriptor_Pool::~Descriptor_Pool() noexcept {
-    if (pool_ != nullptr) vkDestroyDescriptorPool(*context_, pool_, nullptr);
+    if (pool_ != nullptr) vkDestroyDescriptorPool(*context_, pool_, context_->allocation_callbacks());
 }
 
 Descriptor_Pool::Descriptor_Pool(Descriptor_Pool&& o) noexcept { *this = std::move(o); }
@@ -205,7 +205,7 @@ Descriptor_Pool::Descriptor_Pool(Device_Context& context, u32 pool_size) noexcep
         .pPoolSizes    = +sizes,
     };
 
-    VK_EXPECT_SUCCESS(vkCreateDescriptorPool(*context_, &pool_info, nullptr, &pool_));
+    VK_EXPECT_SUCCESS(vkCreateDescriptorPool(*context_, &pool_info, context_->allocation_callbacks(), &pool_));
 }
 
 Resource_Bindings Descriptor_Pool::allocate(const render::Pipeline& pipeline) noexcept {
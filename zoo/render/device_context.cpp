@@ -5,7 +5,7 @@
 
 namespace zoo::render {
 namespace {
-const char* device_extension{ VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+const char* device_extensions[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME };
 
 } // namespace
 
@@ -16,9 +16,11 @@ Device_Context::Device_Context(
     [[maybe_unused]] VkInstance instance,
     utils::Physical_Device pdevice,
     const utils::Queue_Family_Properties& family_props,
-    const render::Query& query) noexcept :
+    const render::Query& query,
+    const VkAllocationCallbacks* allocation_callbacks) noexcept :
     physical_(pdevice),
-    queue_properties_{ family_props } {
+    queue_properties_{ family_props },
+    allocation_callbacks_(allocation_callbacks) {
 
     // https://vulkan-tutorial.com/en/Drawing_a_triangle/Setup/Logical_device_and_queues
     VkDeviceQueueCreateInfo queue_create_info{};
@@ -51,8 +53,10 @@ Device_Context::Device_Context(
     create_info.pQueueCreateInfos    = std::addressof(queue_create_info);
     create_info.pEnabledFeatures     = std::addressof(physical_.features());
 
-    create_info.ppEnabledExtensionNames = &device_extension;
-    create_info.enabledExtensionCount   = 1;
+    // memory budget is optional, vma falls back to estimating the budget without it.
+    const bool memory_budget            = physical_.has_required_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    create_info.ppEnabledExtensionNames = +device_extensions;
+    create_info.enabledExtensionCount   = memory_budget ? 2 : 1;
 
     // this has been deprecated on newer versions of VULKAN
     //
@@ -67,7 +71,7 @@ Device_Context::Device_Context(
     }
 
     VK_EXPECT_SUCCESS(
-        vkCreateDevice(physical_, &create_info, nullptr, &logical_),
+        vkCreateDevice(physical_, &create_info, allocation_callbacks_, &logical_),
         [this]([[maybe_unused]] VkResult result) {
             // not sure if device will be set to nullptr after the
             // end. need a `then` callback.
@@ -85,18 +89,20 @@ Device_Context::Device_Context(
     pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     pool_create_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
     pool_create_info.queueFamilyIndex = queue_properties_.index();
-    VK_EXPECT_SUCCESS(vkCreateCommandPool(logical_, &pool_create_info, nullptr, &command_pool_));
+    VK_EXPECT_SUCCESS(vkCreateCommandPool(logical_, &pool_create_info, allocation_callbacks_, &command_pool_));
 
-    allocator_.emplace(instance, logical_, physical_);
+    allocator_.emplace(instance, logical_, physical_, allocation_callbacks_, memory_budget);
+    pipeline_cache_.emplace(logical_, physical_.properties(), allocation_callbacks_);
 }
 
 void Device_Context::reset() noexcept {
     if (logical_ != nullptr) {
         wait();
+        pipeline_cache_.reset();
         allocator_.reset();
-        if (command_pool_ != nullptr) vkDestroyCommandPool(logical_, command_pool_, nullptr);
+        if (command_pool_ != nullptr) vkDestroyCommandPool(logical_, command_pool_, allocation_callbacks_);
 
-        vkDestroyDevice(logical_, nullptr);
+        vkDestroyDevice(logical_, allocation_callbacks_);
         logical_ = nullptr;
     }
 }
@@ -121,23 +127,23 @@ VkCommandBuffer Device_Context::vk_command_buffer_from_pool(Operation op) const
     release device resources for each vulkan resource
 */
 void Device_Context::release_device_resource(VkFence fence) noexcept {
-    if (fence != nullptr) vkDestroyFence(logical_, fence, nullptr);
+    if (fence != nullptr) vkDestroyFence(logical_, fence, allocation_callbacks_);
 }
 
 void Device_Context::release_device_resource(VkRenderPass renderpass) noexcept {
-    if (renderpass != nullptr) vkDestroyRenderPass(logical_, renderpass, nullptr);
+    if (renderpass != nullptr) vkDestroyRenderPass(logical_, renderpass, allocation_callbacks_);
 }
 
 void Device_Context::release_device_resource(VkSemaphore semaphore) noexcept {
-    if (semaphore != nullptr) vkDestroySemaphore(logical_, semaphore, nullptr);
+    if (semaphore != nullptr) vkDestroySemaphore(logical_, semaphore, allocation_callbacks_);
 }
 
 void Device_Context::release_device_resource(VkBuffer buffer) noexcept {
-    if (buffer != nullptr) vkDestroyBuffer(logical_, buffer, nullptr);
+    if (buffer != nullptr) vkDestroyBuffer(logical_, buffer, allocation_callbacks_);
 }
 
 void Device_Context::release_device_resource(VkDeviceMemory device_memory) noexcept {
-    if (device_memory != nullptr) vkFreeMemory(logical_, device_memory, nullptr);
+    if (device_memory != nullptr) vkFreeMemory(logical_, device_memory, allocation_callbacks_);
 }
 
 VkQueue Device_Context::retrieve(Operation op) const noexcept {
@@ -2,6 +2,7 @@
 #include "utils/physical_device.hpp"
 
 #include "fwd.hpp"
+#include "pipeline_cache.hpp"
 #include "query.hpp"
 #include "render/resources/allocator.hpp"
 #include <memory>
@@ -14,7 +15,8 @@ public:
         VkInstance instance,
         utils::Physical_Device pdevice,
         const utils::Queue_Family_Properties& family_props,
-        const render::Query& query) noexcept;
+        const render::Query& query,
+        const VkAllocationCallbacks* allocation_callbacks) noexcept;
 
     ~Device_Context() noexcept;
 
@@ -46,10 +48,18 @@ public:
 
     void wait() noexcept;
 
+    // host memory for everything created on this device, every create has to be destroyed with the same callbacks.
+    const VkAllocationCallbacks* allocation_callbacks() const noexcept { return allocation_callbacks_; }
+
     resources::Allocator& allocator() noexcept { return allocator_; }
 
     const resources::Allocator& allocator() const noexcept { return allocator_; }
 
+    // shared by every pipeline created on this device, loaded on creation and saved on `reset`.
+    Pipeline_Cache& pipeline_cache() noexcept { return pipeline_cache_; }
+
+    const Pipeline_Cache& pipeline_cache() const noexcept { return pipeline_cache_; }
+
 private:
     utils::Physical_Device physical_ = nullptr;
     VkDevice logical_                = nullptr;
@@ -57,7 +67,10 @@ private:
     utils::Queue_Family_Properties queue_properties_;
     VkCommandPool command_pool_ = nullptr;
 
+    const VkAllocationCallbacks* allocation_callbacks_ = nullptr;
+
     resources::Allocator allocator_;
+    Pipeline_Cache pipeline_cache_;
 };
 
 } // namespace zoo::render
@@ -1,4 +1,5 @@
 #include "render/engine.hpp"
+#include "core/allocator.hpp"
 #include "core/fwd.hpp"
 #include "core/log.hpp"
 
@@ -37,7 +38,8 @@ std::optional<size_t> get_queue_index_if_physical_device_is_chosen(
 
 uint32_t get_version() noexcept { return VK_MAKE_VERSION(0, 0, 0); }
 
-VkInstance create_instance() noexcept {
+VkInstance create_instance(const VkAllocationCallbacks* allocator) noexcept {
+    ZOO_MEMORY_TAG(core::Memory_Tag::render);
     VkApplicationInfo app_info{ .sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO,
                                 .pNext              = nullptr, // for now
                                 .pApplicationName   = "Zoo Engine",
@@ -62,7 +64,7 @@ VkInstance create_instance() noexcept {
     };
 
     VkInstance instance = nullptr;
-    VK_EXPECT_SUCCESS(vkCreateInstance(&create_info, nullptr, &instance));
+    VK_EXPECT_SUCCESS(vkCreateInstance(&create_info, allocator, &instance));
     return instance;
 }
 
@@ -90,32 +92,36 @@ std::optional<debug::Messenger> create_debugger(VkInstance instance, const engin
     return instance != nullptr && info.debug_layer ? std::make_optional(instance) : std::nullopt;
 }
 
-Device_Context create_context(VkInstance instance, const std::vector<utils::Physical_Device>& physical_devices) {
+Device_Context create_context(
+    VkInstance instance,
+    const std::vector<utils::Physical_Device>& physical_devices,
+    const VkAllocationCallbacks* allocator) {
+    ZOO_MEMORY_TAG(core::Memory_Tag::render);
     for (const auto& pd : physical_devices) {
         auto optional_index = get_queue_index_if_physical_device_is_chosen(pd, instance);
 
         if (optional_index) {
-            return { instance, pd, pd.queue_properties()[*optional_index], query };
+            return { instance, pd, pd.queue_properties()[*optional_index], query, allocator };
         }
     }
 
     ZOO_ASSERT(false, "Something went wrong when choosing physical devices");
     // default to first device.
-    return { instance, physical_devices.front(), physical_devices.front().queue_properties()[0], query };
+    return { instance, physical_devices.front(), physical_devices.front().queue_properties()[0], query, allocator };
 }
 
 } // namespace
 
 Engine::Engine(const Info& info) noexcept :
-    info_(info), instance_(create_instance()), physical_devices_(populate_physical_devices(instance_)),
-    context_(create_context(instance_, physical_devices_)), reporter_(create_debugger(instance_, info)) {}
+    info_(info), instance_(create_instance(allocator())), physical_devices_(populate_physical_devices(instance_)),
+    context_(create_context(instance_, physical_devices_, allocator())), reporter_(create_debugger(instance_, info)) {}
 
 Engine::~Engine() noexcept {
     reporter_.reset();
     context_.reset();
     if (instance_ != nullptr) {
+        vkDestroyInstance(instance_, allocator());
         instance_ = nullptr;
-        vkDestroyInstance(instance_, nullptr);
     }
 }
 
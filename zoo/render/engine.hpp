@@ -4,6 +4,7 @@
 
 #include "device_context.hpp"
 #include "fwd.hpp"
+#include "host_allocator.hpp"
 #include "utils/physical_device.hpp"
 
 #include "render/debug/messenger.hpp"
@@ -32,10 +33,8 @@ public:
 
     VkInstance vk_instance() const noexcept { return instance_; }
 
-    // TODO : write allocator
-    const VkAllocationCallbacks* allocator() const noexcept {
-        return callbacks_ ? std::addressof(callbacks_.value()) : nullptr;
-    }
+    const VkAllocationCallbacks* allocator() const noexcept { return &host_allocator_.callbacks(); }
+    const Host_Allocator& host_allocator() const noexcept { return host_allocator_; }
 
     Device_Context& context() noexcept { return context_; }
     const Device_Context& context() const noexcept { return context_; }
@@ -51,6 +50,9 @@ public:
 
 private:
     Info info_;
+
+    // needs to outlive everything that was created with `allocator()`.
+    Host_Allocator host_allocator_;
     VkInstance instance_ = nullptr;
 
     // stores all the physical devices.
@@ -62,8 +64,6 @@ private:
     // debugger may be named incorrectly
     // TODO: change this name to something that is more correct
     std::optional<debug::Messenger> reporter_ = std::nullopt;
-
-    std::optional<VkAllocationCallbacks> callbacks_ = std::nullopt;
 };
 
 } // namespace zoo::render
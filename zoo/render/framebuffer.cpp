@@ -35,7 +35,8 @@ VkFramebuffer create_framebuffer(
     framebuffer_create_info.layers          = layers;
 
     VkFramebuffer framebuffer{};
-    VK_EXPECT_SUCCESS(vkCreateFramebuffer(context, &framebuffer_create_info, nullptr, &framebuffer));
+    VK_EXPECT_SUCCESS(
+        vkCreateFramebuffer(context, &framebuffer_create_info, context.allocation_callbacks(), &framebuffer));
     return framebuffer;
 }
 } // namespace
@@ -75,7 +76,9 @@ Framebuffer::Framebuffer(
     renderpass_(renderpass), width_(width), height_(height), layers_(layers) {}
 
 Framebuffer::~Framebuffer() noexcept {
-    if (context_ != nullptr && underlying_ != nullptr) vkDestroyFramebuffer(*context_, underlying_, nullptr);
+    if (context_ != nullptr && underlying_ != nullptr) {
+        vkDestroyFramebuffer(*context_, underlying_, context_->allocation_callbacks());
+    }
 }
 
 } // namespace zoo::render
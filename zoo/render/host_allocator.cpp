@@ -0,0 +1,263 @@
+#include "host_allocator.hpp"
+#include "core/allocator.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <cstring>
+
+namespace zoo::render {
+
+namespace {
+
+enum class Source : u8 { heap, pool, command };
+
+// sits right in front of every pointer handed to vulkan, `pfnFree` does not tell us the scope or the size.
+struct Allocation_Header {
+    void* base;
+    u64 size : 48;
+    u64 source : 4;
+    u64 scope : 4;
+    u64 size_class : 8;
+};
+
+static_assert(sizeof(Allocation_Header) == 16);
+
+constexpr size_t HEADER_SIZE   = sizeof(Allocation_Header);
+constexpr size_t MIN_ALIGNMENT = 16;
+
+// COMMAND scope allocations only live for the duration of a single vulkan call, so a linear arena that rewinds
+// whenever nothing is outstanding never grows past the largest command. only the owning thread touches `arena`, it
+// rewinds on its next allocation since the last allocation may be freed on another thread.
+struct Command_Arena {
+    static constexpr size_t RESERVE_SIZE = size_t{ 16 } << 20;
+
+    core::Arena arena{ RESERVE_SIZE };
+    std::atomic<u64> live = 0;
+};
+
+Command_Arena& thread_command_arena() noexcept {
+    thread_local Command_Arena command_arena;
+    return command_arena;
+}
+
+size_t effective_alignment(size_t alignment) noexcept { return alignment < MIN_ALIGNMENT ? MIN_ALIGNMENT : alignment; }
+
+// `owner` is whatever `free` needs to give the memory back, usually the block itself.
+void* place_header(
+    void* block,
+    void* owner,
+    size_t size,
+    size_t alignment,
+    Source source,
+    VkSystemAllocationScope scope,
+    u32 size_class) noexcept {
+    auto user = align_forward((uintptr_t)block + HEADER_SIZE, alignment);
+    new ((void*)(user - HEADER_SIZE)) Allocation_Header{ owner, size, (u64)source, (u64)scope, (u64)size_class };
+    return (void*)user;
+}
+
+Allocation_Header& header_of(void* memory) noexcept {
+    return *reinterpret_cast<Allocation_Header*>((uintptr_t)memory - HEADER_SIZE);
+}
+
+u32 size_class_index(size_t bytes) noexcept {
+    u32 index = 0;
+    for (size_t class_size = 16; class_size < bytes; class_size <<= 1)
+        ++index;
+    return index;
+}
+
+} // namespace
+
+Host_Allocator::Host_Allocator() noexcept {
+    callbacks_ = { .pUserData             = this,
+                   .pfnAllocation         = &Host_Allocator::allocate,
+                   .pfnReallocation       = &Host_Allocator::reallocate,
+                   .pfnFree               = &Host_Allocator::free,
+                   .pfnInternalAllocation = &Host_Allocator::internal_allocation,
+                   .pfnInternalFree       = &Host_Allocator::internal_free };
+}
+
+Host_Allocator::~Host_Allocator() noexcept {
+    for (auto& pool : pools_) {
+        for (Chunk* chunk = pool.chunks; chunk != nullptr;) {
+            Chunk* next = chunk->next;
+            std::free(chunk);
+            chunk = next;
+        }
+        pool.chunks    = nullptr;
+        pool.free_list = nullptr;
+    }
+}
+
+const char* Host_Allocator::scope_name(VkSystemAllocationScope scope) noexcept {
+    switch (scope) {
+        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "COMMAND";
+        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "OBJECT";
+        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "CACHE";
+        case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "DEVICE";
+        case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "INSTANCE";
+        default: return "UNKNOWN";
+    }
+}
+
+Host_Allocator::Stats_Snapshot Host_Allocator::stats(VkSystemAllocationScope scope) const noexcept {
+    const auto& s = stats_[scope];
+    return { .live_bytes          = s.live_bytes.load(std::memory_order_relaxed),
+             .live_count          = s.live_count.load(std::memory_order_relaxed),
+             .total_count         = s.total_count.load(std::memory_order_relaxed),
+             .internal_live_bytes = s.internal_live_bytes.load(std::memory_order_relaxed) };
+}
+
+void* Host_Allocator::allocate(size_t size, size_t alignment, VkSystemAllocationScope scope) noexcept {
+    if (size == 0) return nullptr;
+    ZOO_ASSERT(is_power_of_two(alignment), "vulkan alignment must be a power of two!");
+    alignment = effective_alignment(alignment);
+
+    // worst case padding to get `alignment` after the header.
+    const size_t required = HEADER_SIZE + size + (alignment - MIN_ALIGNMENT);
+    void* memory          = nullptr;
+
+    switch (scope) {
+        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: {
+            auto& command = thread_command_arena();
+            // pairs with the release in `free`, whoever freed last is done with the memory being reused.
+            if (command.live.load(std::memory_order_acquire) == 0) command.arena.clear();
+            if (void* base = command.arena.allocate(required, MIN_ALIGNMENT)) {
+                command.live.fetch_add(1, std::memory_order_relaxed);
+                memory = place_header(base, &command, size, alignment, Source::command, scope, 0);
+            }
+        } break;
+        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT:
+        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: {
+            const u32 size_class = size_class_index(required);
+            if (size_class < SIZE_CLASS_COUNT) {
+                if (void* base = allocate_from_pool(size_class))
+                    memory = place_header(base, base, size, alignment, Source::pool, scope, size_class);
+            }
+        } break;
+        default: break;
+    }
+
+    // device/instance scope and everything that didn't fit above.
+    if (memory == nullptr) {
+        void* base = std::malloc(required);
+        if (base == nullptr) return nullptr;
+        memory = place_header(base, base, size, alignment, Source::heap, scope, 0);
+    }
+
+    auto& s = stats_[scope];
+    s.live_bytes.fetch_add(size, std::memory_order_relaxed);
+    s.live_count.fetch_add(1, std::memory_order_relaxed);
+    s.total_count.fetch_add(1, std::memory_order_relaxed);
+    return memory;
+}
+
+void Host_Allocator::free(void* memory) noexcept {
+    if (memory == nullptr) return;
+
+    const auto header = header_of(memory);
+    auto& s           = stats_[header.scope];
+    s.live_bytes.fetch_sub(header.size, std::memory_order_relaxed);
+    s.live_count.fetch_sub(1, std::memory_order_relaxed);
+
+    switch ((Source)header.source) {
+        case Source::command: {
+            // the owning thread rewinds the arena on its next allocation once nothing is live.
+            static_cast<Command_Arena*>(header.base)->live.fetch_sub(1, std::memory_order_release);
+        } break;
+        case Source::pool: {
+            // `base` is the start of the slot that was handed out by the pool.
+            free_to_pool(header.size_class, header.base);
+        } break;
+        case Source::heap: {
+            std::free(header.base);
+        } break;
+    }
+}
+
+void* Host_Allocator::allocate_from_pool(u32 size_class) noexcept {
+    auto& pool = pools_[size_class];
+    std::lock_guard<std::mutex> guard{ pool.lock };
+
+    if (pool.free_list == nullptr) {
+        const size_t slot_size = size_t{ MIN_SIZE_CLASS } << size_class;
+        auto* chunk            = static_cast<Chunk*>(std::malloc(CHUNK_SIZE));
+        if (chunk == nullptr) return nullptr;
+
+        chunk->next = pool.chunks;
+        pool.chunks = chunk;
+
+        // first 16 bytes of every chunk links the chunks together.
+        for (size_t offset = MIN_ALIGNMENT; offset + slot_size <= CHUNK_SIZE; offset += slot_size) {
+            auto* slot     = reinterpret_cast<Free_Slot*>(reinterpret_cast<u8*>(chunk) + offset);
+            slot->next     = pool.free_list;
+            pool.free_list = slot;
+        }
+    }
+
+    Free_Slot* slot = pool.free_list;
+    pool.free_list  = slot->next;
+    return slot;
+}
+
+void Host_Allocator::free_to_pool(u32 size_class, void* memory) noexcept {
+    auto& pool = pools_[size_class];
+    std::lock_guard<std::mutex> guard{ pool.lock };
+
+    auto* slot     = static_cast<Free_Slot*>(memory);
+    slot->next     = pool.free_list;
+    pool.free_list = slot;
+}
+
+void* VKAPI_CALL
+    Host_Allocator::allocate(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope scope) {
+    return static_cast<Host_Allocator*>(user_data)->allocate(size, alignment, scope);
+}
+
+void* VKAPI_CALL Host_Allocator::reallocate(
+    void* user_data,
+    void* original,
+    size_t size,
+    size_t alignment,
+    VkSystemAllocationScope scope) {
+    auto* self = static_cast<Host_Allocator*>(user_data);
+    if (original == nullptr) return self->allocate(size, alignment, scope);
+
+    if (size == 0) {
+        self->free(original);
+        return nullptr;
+    }
+
+    const size_t old_size = header_of(original).size;
+    void* memory          = self->allocate(size, alignment, scope);
+    if (memory == nullptr) return nullptr; // original must be left untouched.
+
+    std::memcpy(memory, original, old_size < size ? old_size : size);
+    self->free(original);
+    return memory;
+}
+
+void VKAPI_CALL Host_Allocator::free(void* user_data, void* memory) {
+    static_cast<Host_Allocator*>(user_data)->free(memory);
+}
+
+void VKAPI_CALL Host_Allocator::internal_allocation(
+    void* user_data,
+    size_t size,
+    [[maybe_unused]] VkInternalAllocationType type,
+    VkSystemAllocationScope scope) {
+    auto* self = static_cast<Host_Allocator*>(user_data);
+    self->stats_[scope].internal_live_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void VKAPI_CALL Host_Allocator::internal_free(
+    void* user_data,
+    size_t size,
+    [[maybe_unused]] VkInternalAllocationType type,
+    VkSystemAllocationScope scope) {
+    auto* self = static_cast<Host_Allocator*>(user_data);
+    self->stats_[scope].internal_live_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+} // namespace zoo::render
@@ -0,0 +1,97 @@
+#pragma once
+#include "fwd.hpp"
+
+#include <atomic>
+#include <mutex>
+
+namespace zoo::render {
+
+// CPU side allocator handed to vulkan through `VkAllocationCallbacks`. Allocations are routed by their
+// `VkSystemAllocationScope`:
+//  - COMMAND           : thread local linear arena, rewound by its thread once every allocation from it is freed.
+//  - OBJECT and CACHE  : size class pools, falls back to the heap for big allocations.
+//  - DEVICE/INSTANCE   : long lived heap allocations.
+// Statistics are kept per scope with relaxed atomics so the hot path never locks or logs for them.
+class Host_Allocator {
+public:
+    static constexpr u32 SCOPE_COUNT = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+    struct Scope_Stats {
+        std::atomic<u64> live_bytes          = 0;
+        std::atomic<u64> live_count          = 0;
+        std::atomic<u64> total_count         = 0;
+        std::atomic<u64> internal_live_bytes = 0;
+    };
+
+    struct Stats_Snapshot {
+        u64 live_bytes;
+        u64 live_count;
+        u64 total_count;
+        u64 internal_live_bytes;
+    };
+
+    const VkAllocationCallbacks& callbacks() const noexcept { return callbacks_; }
+    Stats_Snapshot stats(VkSystemAllocationScope scope) const noexcept;
+
+    static const char* scope_name(VkSystemAllocationScope scope) noexcept;
+
+    Host_Allocator() noexcept;
+    ~Host_Allocator() noexcept;
+
+    Host_Allocator(const Host_Allocator&)            = delete;
+    Host_Allocator& operator=(const Host_Allocator&) = delete;
+    Host_Allocator(Host_Allocator&&)                 = delete;
+    Host_Allocator& operator=(Host_Allocator&&)      = delete;
+
+private:
+    static void* VKAPI_CALL allocate(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope scope);
+    static void* VKAPI_CALL reallocate(
+        void* user_data,
+        void* original,
+        size_t size,
+        size_t alignment,
+        VkSystemAllocationScope scope);
+    static void VKAPI_CALL free(void* user_data, void* memory);
+    static void VKAPI_CALL internal_allocation(
+        void* user_data,
+        size_t size,
+        VkInternalAllocationType type,
+        VkSystemAllocationScope scope);
+    static void VKAPI_CALL internal_free(
+        void* user_data,
+        size_t size,
+        VkInternalAllocationType type,
+        VkSystemAllocationScope scope);
+
+    void* allocate(size_t size, size_t alignment, VkSystemAllocationScope scope) noexcept;
+    void free(void* memory) noexcept;
+
+    void* allocate_from_pool(u32 size_class) noexcept;
+    void free_to_pool(u32 size_class, void* slot) noexcept;
+
+private:
+    // 16, 32, 64 ... 4096 bytes.
+    static constexpr u32 SIZE_CLASS_COUNT = 9;
+    static constexpr u32 MIN_SIZE_CLASS   = 16;
+    static constexpr size_t CHUNK_SIZE    = size_t{ 64 } << 10;
+
+    struct Free_Slot {
+        Free_Slot* next;
+    };
+
+    struct Chunk {
+        Chunk* next;
+    };
+
+    struct Size_Class_Pool {
+        std::mutex lock;
+        Free_Slot* free_list = nullptr;
+        Chunk* chunks        = nullptr;
+    };
+
+    VkAllocationCallbacks callbacks_ = {};
+    Scope_Stats stats_[SCOPE_COUNT];
+    Size_Class_Pool pools_[SIZE_CLASS_COUNT];
+};
+
+} // namespace zoo::render
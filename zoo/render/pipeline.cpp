@@ -2,6 +2,8 @@
 #include "pipeline.hpp"
 #include "core/fwd.hpp"
 
+#include <utility>
+
 namespace zoo::render {
 
 namespace {
@@ -79,7 +81,9 @@ VkFormat convert_to_shader_stage(ShaderType t) {
 } // namespace
 
 void Shader::reset() noexcept {
-    if (module_ != nullptr && context_ != nullptr) vkDestroyShaderModule(*context_, module_, nullptr);
+    if (module_ != nullptr && context_ != nullptr) {
+        vkDestroyShaderModule(*context_, module_, context_->allocation_callbacks());
+    }
 
     module_ = nullptr;
 }
@@ -91,7 +95,7 @@ Shader::Shader(Device_Context& context, stdx::span<const uint32_t> code, std::st
     create_info.codeSize = sizeof(uint32_t) * code.size();
     create_info.pCode    = code.data();
     // TODO : write allocator
-    VK_EXPECT_SUCCESS(vkCreateShaderModule(*context_, &create_info, nullptr, &module_));
+    VK_EXPECT_SUCCESS(vkCreateShaderModule(*context_, &create_info, context_->allocation_callbacks(), &module_));
 }
 
 Shader::Shader() noexcept : context_(nullptr), module_(nullptr), entry_point_() {}
@@ -124,25 +128,15 @@ Pipeline::Pipeline(
     stdx::span<BindingDescriptor> binding_descriptors,
     stdx::span<PushConstant> push_constants,
     const PipelineCreateInfo& create_info) noexcept :
-    context_(&context) {
-
-    enum : uint32_t { vertex_stage = 0, fragment_stage = 1, shader_stages = 2 };
+    Pipeline(context, binding_descriptors, push_constants) {
+    underlying_ = create(specifications, renderpass, create_info);
+}
 
-    VkPipelineShaderStageCreateInfo shaders_create_info[shader_stages]{};
-    {
-        VkPipelineShaderStageCreateInfo& vertex_create_info{ shaders_create_info[vertex_stage] };
-        vertex_create_info.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        vertex_create_info.stage  = VK_SHADER_STAGE_VERTEX_BIT;
-        vertex_create_info.module = specifications.vertex;
-        vertex_create_info.pName  = specifications.vertex.entry_point().data();
-    }
-    {
-        VkPipelineShaderStageCreateInfo& fragment_create_info{ shaders_create_info[fragment_stage] };
-        fragment_create_info.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        fragment_create_info.stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
-        fragment_create_info.module = specifications.fragment;
-        fragment_create_info.pName  = specifications.fragment.entry_point().data();
-    }
+Pipeline::Pipeline(
+    Device_Context& context,
+    stdx::span<BindingDescriptor> binding_descriptors,
+    stdx::span<PushConstant> push_constants) noexcept :
+    context_(&context) {
 
     // for reusing
     {
@@ -179,10 +173,55 @@ Pipeline::Pipeline(
                                                                 .bindingCount = descriptor_set_count,
                                                                 .pBindings    = descriptor_set_layouts };
 
-            VK_EXPECT_SUCCESS(vkCreateDescriptorSetLayout(context, &set_create_info, nullptr, set_layout_ + idx));
+            VK_EXPECT_SUCCESS(vkCreateDescriptorSetLayout(
+                context, &set_create_info, context.allocation_callbacks(), set_layout_ + idx));
         }
     }
 
+    VkPipelineLayoutCreateInfo pipeline_layout_create_info{};
+    pipeline_layout_create_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipeline_layout_create_info.setLayoutCount         = set_layout_count_;
+    pipeline_layout_create_info.pSetLayouts            = +set_layout_;
+    pipeline_layout_create_info.pushConstantRangeCount = static_cast<u32>(push_constants.size());
+    pipeline_layout_create_info.pPushConstantRanges    = push_constants.data();
+
+    VK_EXPECT_SUCCESS(
+        vkCreatePipelineLayout(*context_, &pipeline_layout_create_info, context_->allocation_callbacks(), &layout_),
+        [](VkResult /* result */) {
+            ZOO_LOG_ERROR("Pipeline layout creation failed, maybe we should "
+                          "assert here?");
+        });
+}
+
+Pipeline Pipeline::replace(VkPipeline pipeline) noexcept {
+    Pipeline replaced;
+    replaced.context_    = context_;
+    replaced.underlying_ = std::exchange(underlying_, pipeline);
+    return replaced;
+}
+
+VkPipeline Pipeline::create(
+    const ShaderStagesSpecification& specifications,
+    const Render_Pass& renderpass,
+    const PipelineCreateInfo& create_info) const noexcept {
+    enum : uint32_t { vertex_stage = 0, fragment_stage = 1, shader_stages = 2 };
+
+    VkPipelineShaderStageCreateInfo shaders_create_info[shader_stages]{};
+    {
+        VkPipelineShaderStageCreateInfo& vertex_create_info{ shaders_create_info[vertex_stage] };
+        vertex_create_info.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        vertex_create_info.stage  = VK_SHADER_STAGE_VERTEX_BIT;
+        vertex_create_info.module = specifications.vertex;
+        vertex_create_info.pName  = specifications.vertex.entry_point().data();
+    }
+    {
+        VkPipelineShaderStageCreateInfo& fragment_create_info{ shaders_create_info[fragment_stage] };
+        fragment_create_info.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        fragment_create_info.stage  = VK_SHADER_STAGE_FRAGMENT_BIT;
+        fragment_create_info.module = specifications.fragment;
+        fragment_create_info.pName  = specifications.fragment.entry_point().data();
+    }
+
     VkDynamicState dynamic_states_array[]{ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
 
     VkPipelineDynamicStateCreateInfo dynamic_state{};
@@ -295,20 +334,7 @@ Pipeline::Pipeline(
     color_blend_state_create_info.blendConstants[1] = 0.0f; // Optional
     color_blend_state_create_info.blendConstants[2] = 0.0f; // Optional
     color_blend_state_create_info.blendConstants[3] = 0.0f; // Optional
-                                                            //
-    VkPipelineLayoutCreateInfo pipeline_layout_create_info{};
-    pipeline_layout_create_info.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipeline_layout_create_info.setLayoutCount         = set_layout_count_;
-    pipeline_layout_create_info.pSetLayouts            = +set_layout_;
-    pipeline_layout_create_info.pushConstantRangeCount = static_cast<u32>(push_constants.size());
-    pipeline_layout_create_info.pPushConstantRanges    = push_constants.data();
 
-    VK_EXPECT_SUCCESS(
-        vkCreatePipelineLayout(*context_, &pipeline_layout_create_info, nullptr, &layout_),
-        [](VkResult /* result */) {
-            ZOO_LOG_ERROR("Pipeline layout creation failed, maybe we should "
-                          "assert here?");
-        });
     VkPipelineDepthStencilStateCreateInfo depth_stencil_state_info = {};
     depth_stencil_state_info.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
     depth_stencil_state_info.pNext                 = nullptr;
@@ -339,8 +365,15 @@ Pipeline::Pipeline(
     graphics_pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE; // Optional
     graphics_pipeline_create_info.basePipelineIndex  = -1;             // Optional
 
+    Pipeline_Cache& cache = context_->pipeline_cache();
+    const auto start      = std::chrono::steady_clock::now();
+    VkPipeline pipeline   = nullptr;
     VK_EXPECT_SUCCESS(
-        vkCreateGraphicsPipelines(*context_, nullptr, 1, &graphics_pipeline_create_info, nullptr, &underlying_));
+        vkCreateGraphicsPipelines(
+            *context_, cache, 1, &graphics_pipeline_create_info, context_->allocation_callbacks(), &pipeline),
+        [&pipeline](VkResult) { pipeline = nullptr; });
+    cache.record_creation(std::chrono::steady_clock::now() - start);
+    return pipeline;
 }
 
 Pipeline::Pipeline(Pipeline&& o) noexcept { *this = std::move(o); }
@@ -367,13 +400,13 @@ Pipeline& Pipeline::operator=(Pipeline&& o) noexcept {
 
 Pipeline::~Pipeline() noexcept {
     if (context_) {
-        vkDestroyPipelineLayout(*context_, layout_, nullptr);
+        vkDestroyPipelineLayout(*context_, layout_, context_->allocation_callbacks());
 
         for (u32 i = 0; i < set_layout_count_; ++i) {
-            vkDestroyDescriptorSetLayout(*context_, set_layout_[i], nullptr);
+            vkDestroyDescriptorSetLayout(*context_, set_layout_[i], context_->allocation_callbacks());
         }
 
-        vkDestroyPipeline(*context_, underlying_, nullptr);
+        vkDestroyPipeline(*context_, underlying_, context_->allocation_callbacks());
     }
 }
 
@@ -115,6 +115,23 @@ public:
     VkPipelineLayout layout() const { return layout_; }
 
     friend class Descriptor_Pool;
+    friend class Pipeline_Factory;
+
+private:
+    // only the layouts, descriptor sets can be allocated against it before `create` ran.
+    Pipeline(
+        Device_Context& context,
+        stdx::span<BindingDescriptor> binding_descriptors,
+        stdx::span<PushConstant> push_constants) noexcept;
+
+    // safe to call from any thread, it only reads the layouts.
+    underlying_type create(
+        const ShaderStagesSpecification& specifications,
+        const Render_Pass& renderpass,
+        const PipelineCreateInfo& create_info) const noexcept;
+
+    // swaps `pipeline` in, what is returned only owns the pipeline that got replaced.
+    Pipeline replace(underlying_type pipeline) noexcept;
 
 private:
     Device_Context* context_    = nullptr;
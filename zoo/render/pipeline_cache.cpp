@@ -0,0 +1,133 @@
+#include "pipeline_cache.hpp"
+#include "core/utils.hpp"
+
+#include "stdx/pipeline_cache_file.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstring>
+
+namespace zoo::render {
+
+namespace {
+
+const char* to_string(Pipeline_Cache::Load_Result result) noexcept {
+    switch (result) {
+        case Pipeline_Cache::Load_Result::cold: return "cold";
+        case Pipeline_Cache::Load_Result::warm: return "warm";
+        case Pipeline_Cache::Load_Result::rejected: return "rejected";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+Pipeline_Cache::~Pipeline_Cache() noexcept { reset(); }
+
+void Pipeline_Cache::emplace(
+    VkDevice device,
+    const VkPhysicalDeviceProperties& properties,
+    const VkAllocationCallbacks* allocation_callbacks,
+    std::string_view directory) noexcept {
+    reset();
+
+    device_               = device;
+    allocation_callbacks_ = allocation_callbacks;
+    vendor_id_            = properties.vendorID;
+    device_id_            = properties.deviceID;
+    std::memcpy(uuid_, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    pipelines_created_.store(0, std::memory_order_relaxed);
+    creation_ns_.store(0, std::memory_order_relaxed);
+
+    std::string uuid;
+    for (u8 byte : uuid_)
+        uuid += fmt::format("{:02x}", byte);
+    path_ = fmt::format("{}/pipeline_cache_{:04x}_{:04x}_{}.bin", directory, vendor_id_, device_id_, uuid);
+
+    std::string_view data;
+    load_result_ = Load_Result::cold;
+
+    auto file = core::read_file(path_);
+    if (file.has_value()) {
+        if (const char* reason = stdx::pipeline_cache_reject_reason(*file, vendor_id_, device_id_, uuid_, data)) {
+            ZOO_LOG_WARN("Ignoring pipeline cache \"{}\" : {}", path_, reason);
+            load_result_ = Load_Result::rejected;
+        } else {
+            load_result_ = Load_Result::warm;
+        }
+    }
+
+    VkPipelineCacheCreateInfo create_info{};
+    create_info.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    create_info.initialDataSize = data.size();
+    create_info.pInitialData    = data.data();
+
+    VkResult result = vkCreatePipelineCache(device_, &create_info, allocation_callbacks_, &underlying_);
+    if (result != VK_SUCCESS && create_info.initialDataSize != 0) {
+        ZOO_LOG_WARN("Driver refused pipeline cache \"{}\" : {}", path_, string_VkResult(result));
+        load_result_                = Load_Result::rejected;
+        create_info.initialDataSize = 0;
+        create_info.pInitialData    = nullptr;
+        result                      = vkCreatePipelineCache(device_, &create_info, allocation_callbacks_, &underlying_);
+    }
+
+    VK_EXPECT_SUCCESS(result, [this]([[maybe_unused]] VkResult) { underlying_ = nullptr; });
+}
+
+void Pipeline_Cache::reset() noexcept {
+    if (underlying_ == nullptr) return;
+
+    save();
+    ZOO_LOG_INFO(
+        "Pipeline cache was {}, {} pipelines created in {:.2f}ms",
+        to_string(load_result_),
+        pipelines_created(),
+        std::chrono::duration<double, std::milli>(creation_time()).count());
+
+    vkDestroyPipelineCache(device_, underlying_, allocation_callbacks_);
+    underlying_ = nullptr;
+    device_     = nullptr;
+}
+
+bool Pipeline_Cache::save() const noexcept {
+    if (underlying_ == nullptr) return false;
+
+    size_t size = 0;
+    std::string file;
+    VkResult result = vkGetPipelineCacheData(device_, underlying_, &size, nullptr);
+    if (result == VK_SUCCESS) {
+        file.resize(sizeof(stdx::pipeline_cache_header) + size);
+        result = vkGetPipelineCacheData(device_, underlying_, &size, file.data() + sizeof(stdx::pipeline_cache_header));
+    }
+
+    if (result != VK_SUCCESS) {
+        ZOO_LOG_WARN("Unable to read back pipeline cache \"{}\" : {}", path_, string_VkResult(result));
+        return false;
+    }
+    file.resize(sizeof(stdx::pipeline_cache_header) + size);
+
+    const auto header = stdx::make_pipeline_cache_header(
+        vendor_id_,
+        device_id_,
+        uuid_,
+        file.data() + sizeof(stdx::pipeline_cache_header),
+        size);
+    std::memcpy(file.data(), &header, sizeof(header));
+
+    if (!core::write_file_atomic(path_, file)) {
+        ZOO_LOG_WARN("Unable to write pipeline cache \"{}\"", path_);
+        return false;
+    }
+    return true;
+}
+
+void Pipeline_Cache::record_creation(std::chrono::nanoseconds duration) noexcept {
+    pipelines_created_.fetch_add(1, std::memory_order_relaxed);
+    creation_ns_.fetch_add(static_cast<u64>(duration.count()), std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds Pipeline_Cache::creation_time() const noexcept {
+    return std::chrono::nanoseconds{ creation_ns_.load(std::memory_order_relaxed) };
+}
+
+} // namespace zoo::render
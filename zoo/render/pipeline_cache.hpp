@@ -0,0 +1,75 @@
+#pragma once
+#include "fwd.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace zoo::render {
+
+// `VkPipelineCache` that outlives the process. every device gets its own file, keyed by vendor, device and
+// `pipelineCacheUUID`, so a driver update or a different gpu starts from an empty cache instead of feeding the driver
+// data it can't use. files that are truncated, corrupt or made for another device are ignored.
+class Pipeline_Cache {
+public:
+    static constexpr std::string_view DIRECTORY = "cache";
+
+    enum class Load_Result : u8 {
+        // no file yet.
+        cold,
+        warm,
+        // there was a file but it could not be used.
+        rejected,
+    };
+
+    Pipeline_Cache() noexcept = default;
+    ~Pipeline_Cache() noexcept;
+
+    Pipeline_Cache(const Pipeline_Cache&)            = delete;
+    Pipeline_Cache& operator=(const Pipeline_Cache&) = delete;
+
+    Pipeline_Cache(Pipeline_Cache&&)            = delete;
+    Pipeline_Cache& operator=(Pipeline_Cache&&) = delete;
+
+    // loads the file of this device from `directory` if there is a usable one.
+    void emplace(
+        VkDevice device,
+        const VkPhysicalDeviceProperties& properties,
+        const VkAllocationCallbacks* allocation_callbacks,
+        std::string_view directory = DIRECTORY) noexcept;
+
+    // saves and destroys the cache, has to happen before the device is destroyed.
+    void reset() noexcept;
+
+    bool save() const noexcept;
+
+    VkPipelineCache get() const noexcept { return underlying_; }
+    operator VkPipelineCache() const noexcept { return get(); }
+
+    // called by whoever creates a pipeline with this cache, what a warm cache saves shows up here.
+    void record_creation(std::chrono::nanoseconds duration) noexcept;
+
+    Load_Result load_result() const noexcept { return load_result_; }
+    u32 pipelines_created() const noexcept { return pipelines_created_.load(std::memory_order_relaxed); }
+    std::chrono::nanoseconds creation_time() const noexcept;
+    const std::string& path() const noexcept { return path_; }
+
+private:
+    VkDevice device_                                   = nullptr;
+    const VkAllocationCallbacks* allocation_callbacks_ = nullptr;
+    VkPipelineCache underlying_                        = nullptr;
+
+    u32 vendor_id_ = 0;
+    u32 device_id_ = 0;
+    u8 uuid_[VK_UUID_SIZE]{};
+    std::string path_;
+
+    Load_Result load_result_ = Load_Result::cold;
+
+    // pipelines can be created from any thread.
+    std::atomic<u32> pipelines_created_ = 0;
+    std::atomic<u64> creation_ns_       = 0;
+};
+
+} // namespace zoo::render
@@ -0,0 +1,173 @@
+#include "pipeline_factory.hpp"
+
+#include "stdx/thread_pool.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace zoo::render {
+
+Pipeline_Factory::~Pipeline_Factory() noexcept {
+    wait_all();
+    for (auto& slot : slots_) {
+        // never swapped in, so never used by a frame either.
+        if (slot->rebuilt != nullptr) vkDestroyPipeline(*context_, slot->rebuilt, context_->allocation_callbacks());
+    }
+}
+
+Pipeline_Handle Pipeline_Factory::request(Pipeline_Description description, Pipeline_Handle fallback) noexcept {
+    ZOO_ASSERT(description.renderpass != nullptr, "Pipelines need a render pass!");
+    ZOO_ASSERT(!fallback.valid() || fallback.index < slots_.size(), "Fallback has to be requested first!");
+
+    Slot& slot       = *slots_.emplace_back(std::make_unique<Slot>());
+    slot.description = std::move(description);
+    slot.pipeline    = Pipeline{ *context_, slot.description.bindings, slot.description.push_constants };
+    slot.fallback    = fallback;
+    slot.factory     = this;
+    slot.index       = static_cast<u32>(slots_.size() - 1);
+
+    submit(slot);
+    return { slot.index };
+}
+
+void Pipeline_Factory::rebuild(
+    Pipeline_Handle handle,
+    std::vector<u32> vertex_spirv,
+    std::vector<u32> fragment_spirv,
+    std::chrono::steady_clock::time_point requested) noexcept {
+    Slot& target                  = slot(handle);
+    target.pending_vertex_spirv   = std::move(vertex_spirv);
+    target.pending_fragment_spirv = std::move(fragment_spirv);
+    // a rebuild replacing a queued one is still waited on since the first.
+    target.pending_requested = target.pending ? std::min(target.pending_requested, requested) : requested;
+    target.pending           = true;
+
+    // one compilation per pipeline at a time, the worker owns the description while it compiles.
+    if (!target.busy.load(std::memory_order_acquire)) submit_pending(target);
+}
+
+const Pipeline* Pipeline_Factory::resolve(Pipeline_Handle handle) const noexcept {
+    // fallbacks are always requested before the pipelines using them, the chain can't loop.
+    while (handle.valid()) {
+        const Slot& current = slot(handle);
+        if (current.state.load(std::memory_order_acquire) == State::ready) return &current.pipeline;
+        handle = current.fallback;
+    }
+    return nullptr;
+}
+
+const Pipeline& Pipeline_Factory::pipeline(Pipeline_Handle handle) const noexcept { return slot(handle).pipeline; }
+
+bool Pipeline_Factory::ready(Pipeline_Handle handle) const noexcept {
+    return slot(handle).state.load(std::memory_order_acquire) == State::ready;
+}
+
+void Pipeline_Factory::wait(Pipeline_Handle handle) noexcept {
+    const Slot& target = slot(handle);
+    while (target.busy.load(std::memory_order_acquire)) {
+        if (!stdx::worker_pool().try_run_one()) std::this_thread::yield();
+    }
+}
+
+void Pipeline_Factory::wait_all() noexcept {
+    for (u32 i = 0; i < slots_.size(); ++i)
+        wait({ i });
+}
+
+void Pipeline_Factory::update() noexcept {
+    ++frame_;
+    std::erase_if(retired_, [this](const Retired& retired) { return retired.frame + frames_in_flight_ <= frame_; });
+
+    for (u32 i = 0; i < slots_.size(); ++i) {
+        Slot& current = *slots_[i];
+        if (current.busy.load(std::memory_order_acquire)) continue;
+
+        if (current.rebuilt != nullptr) {
+            Pipeline replaced = current.pipeline.replace(std::exchange(current.rebuilt, nullptr));
+            current.state.store(State::ready, std::memory_order_release);
+            if (replaced.get() != nullptr) retired_.push_back({ std::move(replaced), frame_ });
+            ZOO_LOG_INFO(
+                "Swapped in rebuilt pipeline {}, {:.2f}ms after it was requested",
+                i,
+                std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - current.rebuild_requested)
+                    .count());
+        }
+
+        if (current.pending) submit_pending(current);
+    }
+}
+
+Pipeline_Factory::Stats Pipeline_Factory::stats() const noexcept {
+    return { compiled_.load(std::memory_order_relaxed),
+             failed_.load(std::memory_order_relaxed),
+             std::chrono::nanoseconds{ compile_ns_.load(std::memory_order_relaxed) } };
+}
+
+void Pipeline_Factory::submit(Slot& slot) noexcept {
+    slot.busy.store(true, std::memory_order_relaxed);
+
+    // without any workers there is nobody to hand it to.
+    if (stdx::worker_pool().worker_count() == 0) return compile(&slot);
+    stdx::worker_pool().submit({ &Pipeline_Factory::compile, &slot });
+}
+
+void Pipeline_Factory::submit_pending(Slot& slot) noexcept {
+    if (slot.rebuilt != nullptr) {
+        // an earlier rebuild that was never swapped in.
+        vkDestroyPipeline(*context_, std::exchange(slot.rebuilt, nullptr), context_->allocation_callbacks());
+    }
+
+    slot.description.vertex_spirv   = std::move(slot.pending_vertex_spirv);
+    slot.description.fragment_spirv = std::move(slot.pending_fragment_spirv);
+    slot.rebuild_requested          = slot.pending_requested;
+    slot.pending                    = false;
+    submit(slot);
+}
+
+void Pipeline_Factory::compile(void* context) noexcept {
+    Slot& slot                = *static_cast<Slot*>(context);
+    Pipeline_Factory& factory = *slot.factory;
+    auto& description         = slot.description;
+
+    Shader vertex{ *factory.context_, description.vertex_spirv, description.entry_point };
+    Shader fragment{ *factory.context_, description.fragment_spirv, description.entry_point };
+    VertexInputDescription input{ description.vertex_stride, description.vertex_attributes, description.input_rate };
+
+    const auto start    = std::chrono::steady_clock::now();
+    VkPipeline pipeline = slot.pipeline.create(
+        ShaderStagesSpecification{ vertex, fragment, { &input, 1 } },
+        *description.renderpass,
+        description.create_info);
+
+    const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - start;
+    factory.compile_ns_.fetch_add(static_cast<u64>(duration.count()), std::memory_order_relaxed);
+    (pipeline != nullptr ? factory.compiled_ : factory.failed_).fetch_add(1, std::memory_order_relaxed);
+
+    // only the first compilation fills in the pipeline, later ones wait for `update` to swap them in.
+    const bool first = slot.state.load(std::memory_order_relaxed) == State::compiling;
+    if (pipeline == nullptr) {
+        ZOO_LOG_ERROR(
+            "Pipeline {} failed to compile, {}",
+            slot.index,
+            !first                  ? "keeping the previous one"
+            : slot.fallback.valid() ? "drawing with its fallback"
+                                    : "draws with it are skipped");
+    }
+
+    if (first) {
+        slot.pipeline.underlying_ = pipeline;
+        slot.state.store(pipeline != nullptr ? State::ready : State::failed, std::memory_order_release);
+    } else {
+        slot.rebuilt = pipeline;
+    }
+    slot.busy.store(false, std::memory_order_release);
+}
+
+Pipeline_Factory::Slot& Pipeline_Factory::slot(Pipeline_Handle handle) const noexcept {
+    ZOO_ASSERT(handle.valid() && handle.index < slots_.size(), "Unknown pipeline handle!");
+    return *slots_[handle.index];
+}
+
+} // namespace zoo::render
@@ -0,0 +1,146 @@
+#pragma once
+#include "fwd.hpp"
+#include "pipeline.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace zoo::render {
+
+// Everything a `Pipeline` is created from, owned so that it can be compiled on another thread.
+struct Pipeline_Description {
+    std::vector<u32> vertex_spirv;
+    std::vector<u32> fragment_spirv;
+    std::string entry_point = "main";
+
+    // a single vertex buffer, which is all any pipeline needs so far.
+    std::vector<VertexBufferDescription> vertex_attributes;
+    u32 vertex_stride            = 0;
+    VkVertexInputRate input_rate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    // has to outlive the factory.
+    const Render_Pass* renderpass = nullptr;
+    std::vector<BindingDescriptor> bindings;
+    std::vector<PushConstant> push_constants;
+    PipelineCreateInfo create_info = {};
+};
+
+struct Pipeline_Handle {
+    static constexpr u32 INVALID = std::numeric_limits<u32>::max();
+
+    u32 index = INVALID;
+
+    bool valid() const noexcept { return index != INVALID; }
+};
+
+// Creates pipelines without blocking the thread that asks for them. the layouts are created right away so descriptor
+// sets can be allocated at once, `vkCreateGraphicsPipelines` runs on the worker pool. until a pipeline is compiled
+// draws with it use its fallback, or are skipped when there is none. the factory itself is not thread safe, it is
+// meant to be used from the render thread.
+class Pipeline_Factory {
+public:
+    struct Stats {
+        u32 compiled = 0;
+        u32 failed   = 0;
+        // time spent in `vkCreateGraphicsPipelines` summed over every worker, none of it on the render thread.
+        std::chrono::nanoseconds compile_time = {};
+    };
+
+    // `frames_in_flight` is how many frames go by before a pipeline replaced by `rebuild` can be destroyed, the
+    // renderer's own frame count.
+    Pipeline_Factory(Device_Context& context, u32 frames_in_flight) noexcept :
+        context_(&context), frames_in_flight_(frames_in_flight) {}
+    ~Pipeline_Factory() noexcept;
+
+    Pipeline_Factory(const Pipeline_Factory&)            = delete;
+    Pipeline_Factory& operator=(const Pipeline_Factory&) = delete;
+    Pipeline_Factory(Pipeline_Factory&&)                 = delete;
+    Pipeline_Factory& operator=(Pipeline_Factory&&)      = delete;
+
+    // `fallback` is drawn with until the pipeline is compiled, it needs a compatible layout.
+    Pipeline_Handle request(Pipeline_Description description, Pipeline_Handle fallback = {}) noexcept;
+
+    // compiles `handle` again with new shaders, it keeps drawing with what it has until `update` swaps the new one in.
+    // the layout stays the same so the descriptor sets allocated against it stay valid. never blocks, while another
+    // compilation of `handle` is in flight the shaders are queued and `update` submits them once it's done, a newer
+    // rebuild replaces a queued one. `requested` is what the swap is timed from in the log.
+    void rebuild(
+        Pipeline_Handle handle,
+        std::vector<u32> vertex_spirv,
+        std::vector<u32> fragment_spirv,
+        std::chrono::steady_clock::time_point requested = std::chrono::steady_clock::now()) noexcept;
+
+    // what to bind to draw with `handle`: the pipeline once compiled, until then its fallback and `nullptr` when the
+    // draw should be skipped.
+    const Pipeline* resolve(Pipeline_Handle handle) const noexcept;
+
+    // valid from `request` on, but only for its layouts until `ready`.
+    const Pipeline& pipeline(Pipeline_Handle handle) const noexcept;
+
+    bool ready(Pipeline_Handle handle) const noexcept;
+
+    // helps out the worker pool until `handle` is compiled.
+    void wait(Pipeline_Handle handle) noexcept;
+    void wait_all() noexcept;
+
+    // call once per frame after the fence of the frame has been waited on. finished rebuilds are swapped in, queued
+    // ones are submitted and the pipelines they replaced are destroyed once every frame that could still use them
+    // retired.
+    void update() noexcept;
+
+    Stats stats() const noexcept;
+
+private:
+    enum class State : u8 { compiling, ready, failed };
+
+    struct Slot {
+        Pipeline_Description description;
+        Pipeline pipeline;
+        Pipeline_Handle fallback;
+
+        std::atomic<State> state = State::compiling;
+        // a compilation is in flight, the worker owns `description` and `rebuilt` until it is cleared.
+        std::atomic<bool> busy = false;
+        // set by a rebuild, swapped in by `update`.
+        VkPipeline rebuilt = nullptr;
+        std::chrono::steady_clock::time_point rebuild_requested;
+
+        // a rebuild asked for while `busy`, submitted by `update`. only touched by the render thread.
+        bool pending = false;
+        std::vector<u32> pending_vertex_spirv;
+        std::vector<u32> pending_fragment_spirv;
+        std::chrono::steady_clock::time_point pending_requested;
+
+        Pipeline_Factory* factory = nullptr;
+        u32 index                 = 0;
+    };
+
+    struct Retired {
+        Pipeline pipeline;
+        u64 frame;
+    };
+
+    void submit(Slot& slot) noexcept;
+    void submit_pending(Slot& slot) noexcept;
+    static void compile(void* slot) noexcept;
+
+    Slot& slot(Pipeline_Handle handle) const noexcept;
+
+private:
+    Device_Context* context_ = nullptr;
+    u32 frames_in_flight_    = 0;
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<Retired> retired_;
+    u64 frame_ = 0;
+
+    std::atomic<u32> compiled_   = 0;
+    std::atomic<u32> failed_     = 0;
+    std::atomic<u64> compile_ns_ = 0;
+};
+
+} // namespace zoo::render
@@ -0,0 +1,675 @@
+#include "render_graph.hpp"
+
+#include "stdx/hash.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace zoo::render {
+
+namespace {
+
+struct Access_Info {
+    VkImageLayout layout;
+    VkPipelineStageFlags stages;
+    VkAccessFlags access;
+    VkImageUsageFlags usage;
+    bool write;
+};
+
+// indexed by `Graph_Access`.
+constexpr Access_Info ACCESS_INFOS[] = {
+    { .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+      .stages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+      .access = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+      .usage  = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT,
+      .write  = true },
+    { .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+      .stages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+      .access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+      .usage  = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+      .write  = true },
+    { .layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL,
+      .stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+      .access = VK_ACCESS_SHADER_READ_BIT,
+      .usage  = VK_IMAGE_USAGE_SAMPLED_BIT,
+      .write  = false },
+    { .layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+      .stages = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+      .access = VK_ACCESS_SHADER_READ_BIT,
+      .usage  = VK_IMAGE_USAGE_SAMPLED_BIT,
+      .write  = false },
+    { .layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+      .stages = VK_PIPELINE_STAGE_TRANSFER_BIT,
+      .access = VK_ACCESS_TRANSFER_READ_BIT,
+      .usage  = VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+      .write  = false },
+    { .layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      .stages = VK_PIPELINE_STAGE_TRANSFER_BIT,
+      .access = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .usage  = VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+      .write  = true },
+};
+
+const Access_Info& access_info(Graph_Access access) noexcept { return ACCESS_INFOS[static_cast<size_t>(access)]; }
+
+bool is_attachment(Graph_Access access) noexcept {
+    return access == Graph_Access::color_attachment || access == Graph_Access::depth_attachment;
+}
+
+VkImageAspectFlags format_aspect(VkFormat format) noexcept {
+    switch (format) {
+        case VK_FORMAT_D16_UNORM: [[fallthrough]];
+        case VK_FORMAT_X8_D24_UNORM_PACK32: [[fallthrough]];
+        case VK_FORMAT_D32_SFLOAT: return VK_IMAGE_ASPECT_DEPTH_BIT;
+        case VK_FORMAT_D16_UNORM_S8_UINT: [[fallthrough]];
+        case VK_FORMAT_D24_UNORM_S8_UINT: [[fallthrough]];
+        case VK_FORMAT_D32_SFLOAT_S8_UINT: return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+        default: return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+
+// where a texture is while the compiled frame is walked.
+struct Texture_State {
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    // what the next access that needs a barrier waits on, and the writes it has to make available.
+    VkPipelineStageFlags src_stages = 0;
+    VkAccessFlags src_access        = 0;
+
+    // stages that already read the current contents in the current layout.
+    VkPipelineStageFlags readers = 0;
+};
+
+// returns false if `info` can follow whatever touched the texture last without a barrier, which is only the case for
+// reads of the same layout from stages that already wait on the last write. `src_stages` is what the barrier waits on.
+bool transition(
+    Texture_State& state,
+    const Access_Info& info,
+    bool discard,
+    VkImageMemoryBarrier& barrier,
+    VkPipelineStageFlags& src_stages) noexcept {
+    const bool same_layout = !discard && state.layout == info.layout;
+    if (!info.write && same_layout && (info.stages & ~state.readers) == 0) return false;
+
+    barrier = VkImageMemoryBarrier{
+        .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask       = state.src_access,
+        .dstAccessMask       = info.access,
+        .oldLayout           = discard ? VK_IMAGE_LAYOUT_UNDEFINED : state.layout,
+        .newLayout           = info.layout,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+    };
+
+    if (!info.write && same_layout) {
+        // another stage reads what was last written, it only waits on the write.
+        src_stages = state.src_stages;
+        state.readers |= info.stages;
+        return true;
+    }
+
+    // writes and layout transitions also have to wait for everyone still reading the old contents.
+    src_stages       = state.src_stages | state.readers;
+    state.layout     = info.layout;
+    state.src_stages = info.stages;
+    state.src_access = info.write ? info.access : 0;
+    state.readers    = info.write ? 0 : info.stages;
+    return true;
+}
+
+} // namespace
+
+Graph_Texture Pass_Builder::create(core::Name name, const Graph_Texture_Desc& desc) noexcept {
+    ZOO_ASSERT(desc.format != VK_FORMAT_UNDEFINED, "Transient textures need a format!");
+    ZOO_ASSERT(desc.width != 0 && desc.height != 0, "Transient textures can't be empty!");
+
+    graph_.textures_.push_back({ .name = name, .desc = desc });
+    return { static_cast<u32>(graph_.textures_.size() - 1) };
+}
+
+void Pass_Builder::write_color(Graph_Texture texture, std::optional<VkClearColorValue> clear) noexcept {
+    std::optional<VkClearValue> value;
+    if (clear) value = VkClearValue{ .color = *clear };
+    use(texture, Graph_Access::color_attachment, value);
+}
+
+void Pass_Builder::write_depth(Graph_Texture texture, std::optional<VkClearDepthStencilValue> clear) noexcept {
+    std::optional<VkClearValue> value;
+    if (clear) value = VkClearValue{ .depthStencil = *clear };
+    use(texture, Graph_Access::depth_attachment, value);
+}
+
+void Pass_Builder::read(Graph_Texture texture, Graph_Access access) noexcept {
+    ZOO_ASSERT(!access_info(access).write, "Use `write` for accesses that modify the texture!");
+    use(texture, access, std::nullopt);
+}
+
+void Pass_Builder::write(Graph_Texture texture, Graph_Access access) noexcept {
+    ZOO_ASSERT(access_info(access).write, "Use `read` for accesses that don't modify the texture!");
+    ZOO_ASSERT(!is_attachment(access), "Attachments are written with `write_color` and `write_depth`!");
+    use(texture, access, std::nullopt);
+}
+
+void Pass_Builder::side_effects() noexcept { graph_.passes_[pass_].side_effects = true; }
+
+void Pass_Builder::use(Graph_Texture texture, Graph_Access access, std::optional<VkClearValue> clear) noexcept {
+    ZOO_ASSERT(texture.valid() && texture.index < graph_.textures_.size(), "Texture was not declared this frame!");
+
+    auto& uses = graph_.passes_[pass_].uses;
+    for (const auto& use : uses)
+        ZOO_ASSERT(use.texture != texture.index, "A pass can only use a texture once!");
+
+    uses.push_back({ .texture     = texture.index,
+                     .access      = access,
+                     .clear       = clear.has_value(),
+                     .clear_value = clear.value_or(VkClearValue{}) });
+}
+
+Render_Graph::Render_Graph(Device_Context& context) noexcept : context_(&context) {}
+
+Render_Graph::~Render_Graph() noexcept { release(); }
+
+Graph_Texture Render_Graph::import(core::Name name, resources::Texture& texture, Graph_Access final_access) noexcept {
+    ZOO_ASSERT(texture.valid(), "Cannot import an empty texture!");
+
+    const VkExtent3D extent = texture.extent();
+    textures_.push_back({ .name         = name,
+                          .desc         = { .format  = texture.format(),
+                                            .width   = extent.width,
+                                            .height  = extent.height,
+                                            .samples = texture.samples() },
+                          .imported     = &texture,
+                          .final_access = final_access });
+    return { static_cast<u32>(textures_.size() - 1) };
+}
+
+Pass_Builder Render_Graph::add_pass(core::Name name, execute_fn execute) noexcept {
+    passes_.push_back({ .name = name, .execute = std::move(execute) });
+    return { *this, static_cast<u32>(passes_.size() - 1) };
+}
+
+void Render_Graph::execute(scene::Command_Buffer& command_buffer, core::Arena& scratch) noexcept {
+    const u64 hash = topology_hash();
+    if (!compiled_ || hash != compiled_hash_) {
+        compile();
+        compiled_hash_ = hash;
+    }
+
+    for (auto& pass : compiled_passes_) {
+        record_barriers(command_buffer, scratch, pass.barriers);
+
+        auto& node = passes_[pass.node];
+        if (pass.attachments.empty()) {
+            node.execute(command_buffer, *this);
+            continue;
+        }
+
+        stdx::inplace_vector<VkClearValue, MAX_ATTACHMENTS> clear_values;
+        for (u32 use : pass.attachments)
+            clear_values.push_back(node.uses[use].clear_value);
+
+        command_buffer.begin_renderpass(framebuffer(pass), { clear_values.data(), clear_values.size() });
+        node.execute(command_buffer, *this);
+        command_buffer.end_renderpass();
+    }
+    record_barriers(command_buffer, scratch, final_barriers_);
+
+    // keep the layout tracking of imported textures right for anyone transitioning them outside of the graph.
+    for (auto& node : textures_) {
+        if (node.imported == nullptr) continue;
+        node.imported->layout(access_info(node.final_access).layout);
+        node.imported->access_flags(access_info(node.final_access).access);
+    }
+
+    textures_.clear();
+    passes_.clear();
+}
+
+void Render_Graph::invalidate() noexcept { compiled_ = false; }
+
+const resources::Texture& Render_Graph::texture(Graph_Texture texture) const noexcept {
+    ZOO_ASSERT(texture.valid() && texture.index < textures_.size(), "Texture was not declared this frame!");
+    const auto& node = textures_[texture.index];
+    return node.imported != nullptr ? *node.imported : transients_[texture.index];
+}
+
+u64 Render_Graph::topology_hash() const noexcept {
+    // names, clear values and which imported texture is used don't change what gets compiled.
+    u64 hash = stdx::hash_mix(textures_.size() ^ (passes_.size() << 32));
+    auto mix = [&hash](const auto& value) { hash = stdx::hash_bytes(&value, sizeof(value), hash); };
+
+    for (const auto& node : textures_) {
+        mix(node.desc.format);
+        mix(node.desc.width);
+        mix(node.desc.height);
+        mix(node.desc.samples);
+        mix(node.imported != nullptr);
+        mix(node.final_access);
+    }
+
+    for (const auto& node : passes_) {
+        mix(node.side_effects);
+        mix(node.uses.size());
+        for (const auto& use : node.uses) {
+            mix(use.texture);
+            mix(use.access);
+            mix(use.clear);
+        }
+    }
+    return hash;
+}
+
+void Render_Graph::compile() noexcept {
+    ZOO_ASSERT(context_ != nullptr, "Render graph was never given a device!");
+
+    // frames in flight still render with what was compiled before. this only happens when the topology changes, which
+    // is rare enough that waiting for the device is cheaper than tracking every frame.
+    if (!compiled_passes_.empty()) context_->wait();
+    release();
+
+    const auto texture_count = static_cast<u32>(textures_.size());
+    const auto pass_count    = static_cast<u32>(passes_.size());
+
+    // cull, walking backwards from what leaves the graph. a pass survives if a later pass or an import needs
+    // something it writes, and then needs whatever it reads or loads itself. what it clears isn't needed before it.
+    std::vector<bool> needed(texture_count);
+    std::vector<bool> alive(pass_count);
+    for (u32 i = 0; i < texture_count; ++i)
+        needed[i] = textures_[i].imported != nullptr;
+
+    for (u32 i = pass_count; i-- > 0;) {
+        const auto& node = passes_[i];
+        bool keep        = node.side_effects;
+        for (const auto& use : node.uses)
+            keep = keep || (access_info(use.access).write && needed[use.texture]);
+        if (!keep) continue;
+
+        alive[i] = true;
+        for (const auto& use : node.uses)
+            needed[use.texture] = !access_info(use.access).write || !use.clear;
+    }
+
+    for (u32 i = 0; i < pass_count; ++i) {
+        if (alive[i]) compiled_passes_.emplace_back().node = i;
+    }
+
+    // lifetimes, in indices of `compiled_passes_`.
+    std::vector<u32> first_use(texture_count, Graph_Texture::INVALID);
+    std::vector<u32> last_use(texture_count, 0);
+    for (u32 i = 0; i < compiled_passes_.size(); ++i) {
+        for (const auto& use : passes_[compiled_passes_[i].node].uses) {
+            first_use[use.texture] = std::min(first_use[use.texture], i);
+            last_use[use.texture]  = i;
+        }
+    }
+
+    const std::vector<u32> predecessors = allocate_transients(first_use, last_use);
+
+    // imported textures start where the last frame left them.
+    std::vector<Texture_State> states(texture_count);
+    for (u32 i = 0; i < texture_count; ++i) {
+        if (textures_[i].imported == nullptr) continue;
+        const auto& info     = access_info(textures_[i].final_access);
+        states[i].layout     = info.layout;
+        states[i].src_stages = info.stages;
+        states[i].src_access = info.write ? info.access : 0;
+        states[i].readers    = info.write ? 0 : info.stages;
+    }
+
+    auto add_barrier = [&](Barrier_Batch& batch, u32 texture, const Access_Info& info, bool discard) {
+        Barrier barrier{ .texture = texture };
+        VkPipelineStageFlags src_stages = 0;
+        if (!transition(states[texture], info, discard, barrier.barrier, src_stages)) return;
+
+        barrier.barrier.subresourceRange = {
+            .aspectMask     = format_aspect(textures_[texture].desc.format),
+            .baseMipLevel   = 0,
+            .levelCount     = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount     = VK_REMAINING_ARRAY_LAYERS,
+        };
+
+        batch.src_stages |= src_stages;
+        batch.dst_stages |= info.stages;
+        batch.count++;
+        barriers_.push_back(barrier);
+    };
+
+    std::vector<u32> first_barrier(texture_count, Graph_Texture::INVALID);
+    for (u32 i = 0; i < compiled_passes_.size(); ++i) {
+        auto& pass          = compiled_passes_[i];
+        pass.barriers.first = static_cast<u32>(barriers_.size());
+        const auto& node    = passes_[pass.node];
+
+        for (const auto& use : node.uses) {
+            const auto& info     = access_info(use.access);
+            const bool transient = textures_[use.texture].imported == nullptr;
+            const bool first     = first_use[use.texture] == i;
+            if (transient && first && !use.clear && !info.write) {
+                ZOO_LOG_WARN(
+                    "{} reads {} before any pass wrote it",
+                    node.name.view(),
+                    textures_[use.texture].name.view());
+            }
+
+            if (transient && first) first_barrier[use.texture] = static_cast<u32>(barriers_.size());
+            add_barrier(pass.barriers, use.texture, info, (info.write && use.clear) || (transient && first));
+        }
+    }
+
+    final_barriers_.first = static_cast<u32>(barriers_.size());
+    for (u32 i = 0; i < texture_count; ++i) {
+        if (textures_[i].imported == nullptr) continue;
+        add_barrier(final_barriers_, i, access_info(textures_[i].final_access), false);
+    }
+
+    // a transient sharing memory starts once whatever used the memory before it is done, which is an earlier pass or
+    // the end of the previous frame. states hold where every texture ended up by now.
+    for (u32 i = 0; i < texture_count; ++i) {
+        if (first_barrier[i] == Graph_Texture::INVALID) continue;
+        const auto& previous = states[predecessors[i]];
+        barriers_[first_barrier[i]].barrier.srcAccessMask |= previous.src_access;
+        compiled_passes_[first_use[i]].barriers.src_stages |= previous.src_stages | previous.readers;
+    }
+
+    for (u32 i = 0; i < compiled_passes_.size(); ++i)
+        create_renderpass(i, first_use, last_use);
+
+    // barriers without anything to wait on still need a valid source stage.
+    auto finish_batch = [this](Barrier_Batch& batch) {
+        if (batch.count == 0) return;
+        if (batch.src_stages == 0) batch.src_stages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        stats_.barrier_batches++;
+    };
+
+    stats_.compiles++;
+    stats_.passes          = static_cast<u32>(compiled_passes_.size());
+    stats_.culled_passes   = pass_count - stats_.passes;
+    stats_.image_barriers  = static_cast<u32>(barriers_.size());
+    stats_.barrier_batches = 0;
+    for (auto& pass : compiled_passes_)
+        finish_batch(pass.barriers);
+    finish_batch(final_barriers_);
+
+    ZOO_LOG_INFO(
+        "Render graph compiled: {} passes ({} culled), {} image barriers in {} batches, {} KiB of transients in {} KiB",
+        stats_.passes,
+        stats_.culled_passes,
+        stats_.image_barriers,
+        stats_.barrier_batches,
+        stats_.transient_bytes / 1024,
+        stats_.allocated_bytes / 1024);
+
+    compiled_ = true;
+}
+
+std::vector<u32>
+    Render_Graph::allocate_transients(stdx::span<const u32> first_use, stdx::span<const u32> last_use) noexcept {
+    const auto texture_count = static_cast<u32>(textures_.size());
+    const VkDevice device    = context_->logical();
+    auto& allocator          = context_->allocator();
+
+    std::vector<u32> predecessors(texture_count);
+    std::iota(predecessors.begin(), predecessors.end(), 0u);
+    transients_.resize(texture_count);
+
+    struct Transient {
+        u32 texture;
+        VkImage image;
+        VkImageCreateInfo info;
+        VkMemoryRequirements requirements;
+    };
+
+    struct Block {
+        VkMemoryRequirements requirements;
+        std::vector<u32> transients;
+    };
+
+    std::vector<Transient> transients;
+    for (u32 i = 0; i < texture_count; ++i) {
+        if (textures_[i].imported != nullptr || first_use[i] == Graph_Texture::INVALID) continue;
+
+        VkImageUsageFlags usage = 0;
+        for (const auto& pass : compiled_passes_) {
+            for (const auto& use : passes_[pass.node].uses)
+                usage |= use.texture == i ? access_info(use.access).usage : 0;
+        }
+
+        const auto& desc = textures_[i].desc;
+        Transient transient{
+            .texture = i,
+            .info =
+                VkImageCreateInfo{
+                    .sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+                    .imageType     = VK_IMAGE_TYPE_2D,
+                    .format        = desc.format,
+                    .extent        = { desc.width, desc.height, 1 },
+                    .mipLevels     = 1,
+                    .arrayLayers   = 1,
+                    .samples       = desc.samples,
+                    .tiling        = VK_IMAGE_TILING_OPTIMAL,
+                    .usage         = usage,
+                    .sharingMode   = VK_SHARING_MODE_EXCLUSIVE,
+                    .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                },
+        };
+        VK_EXPECT_SUCCESS(vkCreateImage(device, &transient.info, context_->allocation_callbacks(), &transient.image));
+        vkGetImageMemoryRequirements(device, transient.image, &transient.requirements);
+        transients.push_back(transient);
+    }
+
+    // greedy interval packing, biggest first. a transient joins the first block whose textures are all dead while it
+    // is alive, blocks grow to their largest texture.
+    std::vector<u32> order(transients.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](u32 lhs, u32 rhs) {
+        return transients[lhs].requirements.size > transients[rhs].requirements.size;
+    });
+
+    std::vector<Block> blocks;
+    for (u32 candidate : order) {
+        const auto& transient = transients[candidate];
+        const u32 first       = first_use[transient.texture];
+        const u32 last        = last_use[transient.texture];
+
+        auto fits = [&](const Block& block) {
+            if ((block.requirements.memoryTypeBits & transient.requirements.memoryTypeBits) == 0) return false;
+            return std::none_of(block.transients.begin(), block.transients.end(), [&](u32 other) {
+                const u32 texture = transients[other].texture;
+                return first_use[texture] <= last && first <= last_use[texture];
+            });
+        };
+
+        auto block = std::find_if(blocks.begin(), blocks.end(), fits);
+        if (block == blocks.end()) {
+            blocks.push_back({ transient.requirements, { candidate } });
+            continue;
+        }
+
+        block->requirements.size           = std::max(block->requirements.size, transient.requirements.size);
+        block->requirements.alignment      = std::max(block->requirements.alignment, transient.requirements.alignment);
+        block->requirements.memoryTypeBits &= transient.requirements.memoryTypeBits;
+        block->transients.push_back(candidate);
+    }
+
+    stats_.transient_textures = static_cast<u32>(transients.size());
+    stats_.memory_blocks      = static_cast<u32>(blocks.size());
+    stats_.transient_bytes    = 0;
+    stats_.allocated_bytes    = 0;
+    for (const auto& transient : transients)
+        stats_.transient_bytes += transient.requirements.size;
+
+    for (auto& block : blocks) {
+        VmaAllocationCreateInfo create_info{
+            .usage         = VMA_MEMORY_USAGE_GPU_ONLY,
+            .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            .pool          = allocator.pool(resources::Memory_Pool::render_target),
+        };
+
+        VmaAllocation allocation = nullptr;
+        VkResult result = vmaAllocateMemory(allocator, &block.requirements, &create_info, &allocation, nullptr);
+        if (result != VK_SUCCESS && create_info.pool != nullptr) {
+            ZOO_LOG_WARN("Transient memory could not be allocated from the render target pool, using default heaps");
+            create_info.pool = nullptr;
+            result           = vmaAllocateMemory(allocator, &block.requirements, &create_info, &allocation, nullptr);
+        }
+        VK_EXPECT_SUCCESS(result);
+        memory_blocks_.push_back(allocation);
+        stats_.allocated_bytes += block.requirements.size;
+
+        std::sort(block.transients.begin(), block.transients.end(), [&](u32 lhs, u32 rhs) {
+            return first_use[transients[lhs].texture] < first_use[transients[rhs].texture];
+        });
+
+        for (size_t i = 0; i < block.transients.size(); ++i) {
+            auto& transient = transients[block.transients[i]];
+            VK_EXPECT_SUCCESS(vmaBindImageMemory(allocator, allocation, transient.image));
+
+            // the memory belongs to the block, the texture only owns its image and view.
+            transients_[transient.texture] = resources::Texture{
+                textures_[transient.texture].name, transient.image, transient.info, allocator, nullptr, {}
+            };
+
+            const size_t previous = (i + block.transients.size() - 1) % block.transients.size();
+            predecessors[transient.texture] = transients[block.transients[previous]].texture;
+        }
+    }
+
+    return predecessors;
+}
+
+void Render_Graph::create_renderpass(
+    u32 index,
+    stdx::span<const u32> first_use,
+    stdx::span<const u32> last_use) noexcept {
+    auto& pass       = compiled_passes_[index];
+    const auto& node = passes_[pass.node];
+
+    for (u32 i = 0; i < node.uses.size(); ++i) {
+        if (node.uses[i].access == Graph_Access::color_attachment) pass.attachments.push_back(i);
+    }
+    const u32 color_count = static_cast<u32>(pass.attachments.size());
+    for (u32 i = 0; i < node.uses.size(); ++i) {
+        if (node.uses[i].access == Graph_Access::depth_attachment) {
+            ZOO_ASSERT(pass.attachments.size() == color_count, "There can only be 1 depth attachment!");
+            pass.attachments.push_back(i);
+        }
+    }
+    if (pass.attachments.empty()) return;
+
+    VkAttachmentDescription attachments[MAX_ATTACHMENTS]{};
+    VkAttachmentReference references[MAX_ATTACHMENTS]{};
+    for (u32 i = 0; i < pass.attachments.size(); ++i) {
+        const auto& use     = node.uses[pass.attachments[i]];
+        const auto& texture = textures_[use.texture];
+        const auto layout   = access_info(use.access).layout;
+
+        // transients come out of aliased memory, there is nothing worth loading on their first use.
+        VkAttachmentLoadOp load_op = VK_ATTACHMENT_LOAD_OP_LOAD;
+        if (use.clear) load_op = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        else if (texture.imported == nullptr && first_use[use.texture] == index)
+            load_op = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+
+        // nobody looks at the contents after the last use of a transient, don't write them back.
+        const bool keep = texture.imported != nullptr || last_use[use.texture] > index;
+
+        attachments[i] = VkAttachmentDescription{
+            .format         = texture.desc.format,
+            .samples        = texture.desc.samples,
+            .loadOp         = load_op,
+            .storeOp        = keep ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            .stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+            .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+            // the graph transitions everything with its own barriers, the render pass never changes layouts.
+            .initialLayout = layout,
+            .finalLayout   = layout,
+        };
+        references[i] = VkAttachmentReference{ .attachment = i, .layout = layout };
+
+        if (i == 0) {
+            pass.width  = texture.desc.width;
+            pass.height = texture.desc.height;
+        }
+        ZOO_ASSERT(
+            texture.desc.width == pass.width && texture.desc.height == pass.height,
+            "Attachments of a pass need to be the same size!");
+    }
+
+    const bool has_depth = pass.attachments.size() != color_count;
+    VkSubpassDescription subpass{
+        .pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS,
+        .colorAttachmentCount    = color_count,
+        .pColorAttachments       = +references,
+        .pDepthStencilAttachment = has_depth ? &references[color_count] : nullptr,
+    };
+
+    VkRenderPassCreateInfo renderpass_info{
+        .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+        .attachmentCount = static_cast<u32>(pass.attachments.size()),
+        .pAttachments    = +attachments,
+        .subpassCount    = 1,
+        .pSubpasses      = &subpass,
+    };
+
+    VkRenderPass renderpass{};
+    VK_EXPECT_SUCCESS(vkCreateRenderPass(*context_, &renderpass_info, context_->allocation_callbacks(), &renderpass));
+    pass.renderpass.emplace(*context_, renderpass);
+}
+
+void Render_Graph::record_barriers(
+    scene::Command_Buffer& command_buffer,
+    core::Arena& scratch,
+    const Barrier_Batch& batch) noexcept {
+    if (batch.count == 0) return;
+
+    // only needed until they are recorded.
+    core::Scoped_Arena scope{ scratch };
+    auto* barriers = scratch.allocate<VkImageMemoryBarrier>(batch.count);
+    ZOO_ASSERT(barriers != nullptr, "Frame arena is out of memory!");
+
+    // images are patched in every frame, imported textures are not the same ones from frame to frame.
+    for (u32 i = 0; i < batch.count; ++i) {
+        barriers[i]       = barriers_[batch.first + i].barrier;
+        barriers[i].image = texture({ barriers_[batch.first + i].texture }).handle();
+    }
+    command_buffer.pipeline_barrier(batch.src_stages, batch.dst_stages, { barriers, batch.count });
+}
+
+const Framebuffer& Render_Graph::framebuffer(Compiled_Pass& pass) noexcept {
+    const auto& node = passes_[pass.node];
+
+    stdx::inplace_vector<VkImageView, MAX_ATTACHMENTS> views;
+    stdx::inplace_vector<const resources::TextureView*, MAX_ATTACHMENTS> targets;
+    for (u32 use : pass.attachments) {
+        const auto& view = texture({ node.uses[use].texture }).view();
+        views.push_back(view);
+        targets.push_back(&view);
+    }
+
+    for (const auto& cached : pass.framebuffers) {
+        if (cached.views == views) return cached.framebuffer;
+    }
+
+    pass.framebuffers.push_back(
+        { views,
+          Framebuffer{ *context_, pass.renderpass, { targets.data(), targets.size() }, pass.width, pass.height } });
+    return pass.framebuffers.back().framebuffer;
+}
+
+void Render_Graph::release() noexcept {
+    // textures before the memory they are bound to.
+    compiled_passes_.clear();
+    barriers_.clear();
+    final_barriers_ = {};
+    transients_.clear();
+
+    if (context_ != nullptr) {
+        for (VmaAllocation block : memory_blocks_)
+            vmaFreeMemory(context_->allocator(), block);
+    }
+    memory_blocks_.clear();
+    compiled_ = false;
+}
+
+} // namespace zoo::render
@@ -0,0 +1,224 @@
+#pragma once
+#include "core/allocator.hpp"
+#include "core/fwd.hpp"
+#include "core/name.hpp"
+
+#include "device_context.hpp"
+#include "framebuffer.hpp"
+#include "fwd.hpp"
+#include "render_pass.hpp"
+#include "resources/texture.hpp"
+#include "scene/command_buffer.hpp"
+
+#include "stdx/inplace_function.hpp"
+#include "stdx/inplace_vector.hpp"
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace zoo::render {
+
+class Render_Graph;
+
+// virtual texture, only meaningful to the graph it was declared in and only for the frame it was declared in.
+struct Graph_Texture {
+    static constexpr u32 INVALID = std::numeric_limits<u32>::max();
+
+    u32 index = INVALID;
+
+    bool valid() const noexcept { return index != INVALID; }
+};
+
+struct Graph_Texture_Desc {
+    VkFormat format               = VK_FORMAT_UNDEFINED;
+    u32 width                     = 0;
+    u32 height                    = 0;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+};
+
+// how a pass uses a texture, decides the layout it has to be in and what barriers wait on.
+enum class Graph_Access : u8 {
+    color_attachment,
+    depth_attachment,
+    depth_read,
+    sampled,
+    transfer_src,
+    transfer_dst,
+};
+
+// declares what one pass reads and writes, handed out by `Render_Graph::add_pass`.
+class Pass_Builder {
+public:
+    // texture that only lives inside the graph, its memory is shared with other transients that are never alive at
+    // the same time.
+    Graph_Texture create(core::Name name, const Graph_Texture_Desc& desc) noexcept;
+
+    // attachments are cleared when a clear value is given, otherwise their previous contents are loaded.
+    void write_color(Graph_Texture texture, std::optional<VkClearColorValue> clear = std::nullopt) noexcept;
+    void write_depth(Graph_Texture texture, std::optional<VkClearDepthStencilValue> clear = std::nullopt) noexcept;
+
+    void read(Graph_Texture texture, Graph_Access access = Graph_Access::sampled) noexcept;
+    void write(Graph_Texture texture, Graph_Access access) noexcept;
+
+    // keeps the pass alive even if nothing it writes is used afterwards.
+    void side_effects() noexcept;
+
+private:
+    friend class Render_Graph;
+
+    Pass_Builder(Render_Graph& graph, u32 pass) noexcept : graph_(graph), pass_(pass) {}
+
+    void use(Graph_Texture texture, Graph_Access access, std::optional<VkClearValue> clear) noexcept;
+
+private:
+    Render_Graph& graph_;
+    u32 pass_;
+};
+
+// passes are declared every frame and run in the order they were added. the graph culls passes whose results are
+// never used, places and batches the barriers between them, creates their render passes and framebuffers and backs
+// transient textures with memory that is aliased between textures whose lifetimes don't overlap.
+// all of that only happens again when the declared topology changes, e.g. on resize.
+class Render_Graph {
+public:
+    using execute_fn = stdx::inplace_function<void(scene::Command_Buffer&, const Render_Graph&), 64>;
+
+    static constexpr u32 MAX_PASS_TEXTURES = 8;
+    static constexpr u32 MAX_ATTACHMENTS   = 5;
+
+    struct Stats {
+        u32 compiles           = 0;
+        u32 passes             = 0;
+        u32 culled_passes      = 0;
+        u32 barrier_batches    = 0;
+        u32 image_barriers     = 0;
+        u32 transient_textures = 0;
+        u32 memory_blocks      = 0;
+
+        // what the transients would take on their own vs what was actually allocated for them.
+        VkDeviceSize transient_bytes = 0;
+        VkDeviceSize allocated_bytes = 0;
+    };
+
+    Render_Graph() noexcept = default;
+    explicit Render_Graph(Device_Context& context) noexcept;
+
+    // the device has to be idle, or at least done with every frame this graph recorded.
+    ~Render_Graph() noexcept;
+
+    Render_Graph(const Render_Graph&)            = delete;
+    Render_Graph& operator=(const Render_Graph&) = delete;
+
+    // `texture` is owned elsewhere and outlives the frame. `execute` leaves it in the layout of `final_access` and the
+    // next frame expects to find it there again.
+    Graph_Texture import(core::Name name, resources::Texture& texture, Graph_Access final_access) noexcept;
+
+    Pass_Builder add_pass(core::Name name, execute_fn execute) noexcept;
+
+    // compiles if the topology changed since the last frame, records every pass that survived culling into
+    // `command_buffer` and forgets this frame's declarations. the barriers are patched in `scratch`, usually the arena
+    // of the frame.
+    void execute(scene::Command_Buffer& command_buffer, core::Arena& scratch) noexcept;
+
+    // drops the compiled graph, needed when an imported texture was recreated without the topology changing.
+    void invalidate() noexcept;
+
+    // physical texture behind `texture`, for pass callbacks that need to bind what they read.
+    const resources::Texture& texture(Graph_Texture texture) const noexcept;
+
+    const Stats& stats() const noexcept { return stats_; }
+
+private:
+    friend class Pass_Builder;
+
+    struct Texture_Use {
+        u32 texture         = Graph_Texture::INVALID;
+        Graph_Access access = Graph_Access::sampled;
+        bool clear          = false;
+        VkClearValue clear_value{};
+    };
+
+    struct Texture_Node {
+        core::Name name              = {};
+        Graph_Texture_Desc desc      = {};
+        resources::Texture* imported = nullptr;
+        Graph_Access final_access    = Graph_Access::sampled;
+    };
+
+    struct Pass_Node {
+        core::Name name    = {};
+        execute_fn execute = {};
+        stdx::inplace_vector<Texture_Use, MAX_PASS_TEXTURES> uses;
+        bool side_effects = false;
+    };
+
+    struct Barrier {
+        u32 texture = Graph_Texture::INVALID;
+        VkImageMemoryBarrier barrier{};
+    };
+
+    // one `vkCmdPipelineBarrier`, the barriers are `barriers_[first, first + count)`.
+    struct Barrier_Batch {
+        VkPipelineStageFlags src_stages = 0;
+        VkPipelineStageFlags dst_stages = 0;
+        u32 first                       = 0;
+        u32 count                       = 0;
+    };
+
+    struct Cached_Framebuffer {
+        stdx::inplace_vector<VkImageView, MAX_ATTACHMENTS> views;
+        Framebuffer framebuffer;
+    };
+
+    struct Compiled_Pass {
+        u32 node               = 0;
+        Barrier_Batch barriers = {};
+
+        // empty for passes without attachments, which are indices into the uses of the pass, colors first.
+        Render_Pass renderpass;
+        stdx::inplace_vector<u32, MAX_ATTACHMENTS> attachments;
+        u32 width  = 0;
+        u32 height = 0;
+
+        // one per set of imported textures the pass has rendered to, e.g. one per frame in flight.
+        std::vector<Cached_Framebuffer> framebuffers;
+    };
+
+    u64 topology_hash() const noexcept;
+
+    void compile() noexcept;
+    void release() noexcept;
+
+    // returns the texture that used the memory of each transient before it, itself if it has a block on its own.
+    std::vector<u32> allocate_transients(stdx::span<const u32> first_use, stdx::span<const u32> last_use) noexcept;
+    void create_renderpass(u32 index, stdx::span<const u32> first_use, stdx::span<const u32> last_use) noexcept;
+
+    void record_barriers(
+        scene::Command_Buffer& command_buffer,
+        core::Arena& scratch,
+        const Barrier_Batch& batch) noexcept;
+    const Framebuffer& framebuffer(Compiled_Pass& pass) noexcept;
+
+private:
+    Device_Context* context_ = nullptr;
+
+    // declared this frame.
+    std::vector<Texture_Node> textures_;
+    std::vector<Pass_Node> passes_;
+
+    // compiled, kept until the topology changes.
+    bool compiled_     = false;
+    u64 compiled_hash_ = 0;
+    std::vector<Compiled_Pass> compiled_passes_;
+    std::vector<Barrier> barriers_;
+    Barrier_Batch final_barriers_ = {};
+
+    // indexed like `textures_`, imported ones stay empty.
+    std::vector<resources::Texture> transients_;
+    std::vector<VmaAllocation> memory_blocks_;
+
+    Stats stats_ = {};
+};
+
+} // namespace zoo::render
@@ -71,7 +71,7 @@ VkRenderPass create_vk_renderpass(Device_Context& context, VkFormat format, VkFo
     renderpass_info.pDependencies   = dependencies.data();
 
     VkRenderPass renderpass{};
-    VK_EXPECT_SUCCESS(vkCreateRenderPass(context, &renderpass_info, nullptr, &renderpass));
+    VK_EXPECT_SUCCESS(vkCreateRenderPass(context, &renderpass_info, context.allocation_callbacks(), &renderpass));
 
     return renderpass;
 }
@@ -134,7 +134,7 @@ VkRenderPass create_renderpass(Device_Context& context, stdx::span<AttachmentDes
     };
 
     VkRenderPass renderpass{};
-    VK_EXPECT_SUCCESS(vkCreateRenderPass(context, &renderpass_info, nullptr, &renderpass));
+    VK_EXPECT_SUCCESS(vkCreateRenderPass(context, &renderpass_info, context.allocation_callbacks(), &renderpass));
     return renderpass;
 }
 
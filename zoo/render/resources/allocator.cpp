@@ -2,25 +2,158 @@
 #include "render/defines.hpp"
 #include "render/fwd.hpp"
 
+#include <optional>
+
 namespace zoo::render::resources {
 
+namespace {
+
+constexpr VkDeviceSize STAGING_BLOCK_SIZE = VkDeviceSize{ 64 } << 20;
+constexpr VkDeviceSize FRAME_BLOCK_SIZE   = VkDeviceSize{ 16 } << 20;
+
+// vma picks the memory type from a representative resource, every resource that goes into the pool must be
+// compatible with it. `Buffer::Builder` and `Texture::Builder` fall back to the default heaps when it is not.
+std::optional<u32> find_buffer_memory_type(
+    VmaAllocator allocator,
+    VkBufferUsageFlags usage,
+    VmaMemoryUsage memory_usage,
+    VmaAllocationCreateFlags flags) noexcept {
+    VkBufferCreateInfo buffer_info{};
+    buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_info.size  = 0x1000;
+    buffer_info.usage = usage;
+
+    VmaAllocationCreateInfo alloc_info{};
+    alloc_info.usage = memory_usage;
+    alloc_info.flags = flags;
+
+    u32 memory_type_index = 0;
+    if (vmaFindMemoryTypeIndexForBufferInfo(allocator, &buffer_info, &alloc_info, &memory_type_index) != VK_SUCCESS)
+        return std::nullopt;
+    return memory_type_index;
+}
+
+std::optional<u32> find_image_memory_type(VmaAllocator allocator, VkImageUsageFlags usage) noexcept {
+    VkImageCreateInfo image_info{};
+    image_info.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image_info.imageType   = VK_IMAGE_TYPE_2D;
+    image_info.format      = VK_FORMAT_R8G8B8A8_UNORM;
+    image_info.extent      = { 16, 16, 1 };
+    image_info.mipLevels   = 1;
+    image_info.arrayLayers = 1;
+    image_info.samples     = VK_SAMPLE_COUNT_1_BIT;
+    image_info.tiling      = VK_IMAGE_TILING_OPTIMAL;
+    image_info.usage       = usage;
+
+    VmaAllocationCreateInfo alloc_info{};
+    alloc_info.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+    u32 memory_type_index = 0;
+    if (vmaFindMemoryTypeIndexForImageInfo(allocator, &image_info, &alloc_info, &memory_type_index) != VK_SUCCESS)
+        return std::nullopt;
+    return memory_type_index;
+}
+
+} // namespace
+
 Allocator::Allocator() noexcept : underlying_{ nullptr } {}
 
 Allocator::~Allocator() noexcept {
     if (underlying_ != nullptr) reset();
 }
 
-void Allocator::emplace(VkInstance instance, VkDevice device, VkPhysicalDevice pd) noexcept {
-    create_info_                  = VmaAllocatorCreateInfo{};
-    create_info_.vulkanApiVersion = Defines::vk_version;
-    create_info_.physicalDevice   = pd;
-    create_info_.device           = device;
-    create_info_.instance         = instance;
+void Allocator::emplace(
+    VkInstance instance,
+    VkDevice device,
+    VkPhysicalDevice pd,
+    const VkAllocationCallbacks* allocation_callbacks,
+    bool memory_budget) noexcept {
+    create_info_                      = VmaAllocatorCreateInfo{};
+    create_info_.vulkanApiVersion     = Defines::vk_version;
+    create_info_.physicalDevice       = pd;
+    create_info_.device               = device;
+    create_info_.instance             = instance;
+    create_info_.pAllocationCallbacks = allocation_callbacks;
+    if (memory_budget) create_info_.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+
     VK_EXPECT_SUCCESS(vmaCreateAllocator(&create_info_, &underlying_));
+    if (underlying_ != nullptr) {
+        create_pools();
+        budget_.emplace(underlying_);
+    }
+}
+
+void Allocator::create_pools() noexcept {
+    const auto create = [&](Memory_Pool pool,
+                            std::optional<u32> memory_type,
+                            VmaPoolCreateFlags flags,
+                            VkDeviceSize block_size) {
+        if (!memory_type) {
+            ZOO_LOG_WARN("No memory type found for pool {}, using the default heaps instead", memory_pool_name(pool));
+            return;
+        }
+
+        VmaPoolCreateInfo pool_info{};
+        pool_info.memoryTypeIndex = *memory_type;
+        pool_info.flags           = flags;
+        pool_info.blockSize       = block_size;
+        pools_[static_cast<size_t>(pool)].emplace(underlying_, pool_info, memory_pool_name(pool));
+    };
+
+    // uploads are created, copied and destroyed in order, which is exactly what the linear algorithm is good at.
+    create(
+        Memory_Pool::staging,
+        find_buffer_memory_type(
+            underlying_,
+            VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT),
+        VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT,
+        STAGING_BLOCK_SIZE);
+
+    // frame buffers live across many frames and are freed out of order, the linear algorithm would never reuse their
+    // space and keep growing by whole blocks.
+    create(
+        Memory_Pool::frame,
+        find_buffer_memory_type(
+            underlying_,
+            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            VMA_MEMORY_USAGE_AUTO,
+            VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT),
+        0,
+        FRAME_BLOCK_SIZE);
+
+    create(
+        Memory_Pool::render_target,
+        find_image_memory_type(underlying_, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT),
+        0,
+        0);
+
+    create(
+        Memory_Pool::general,
+        find_buffer_memory_type(
+            underlying_,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+            0),
+        0,
+        0);
 }
 
+VmaPool Allocator::pool(Memory_Pool pool) const noexcept {
+    if (pool == Memory_Pool::none) return nullptr;
+    return pools_[static_cast<size_t>(pool)].get();
+}
+
+Pool_Allocator& Allocator::pool_allocator(Memory_Pool pool) noexcept { return pools_[static_cast<size_t>(pool)]; }
+
 void Allocator::reset() noexcept {
     if (underlying_ != nullptr) {
+        budget_.reset();
+        for (auto& pool : pools_)
+            pool.reset();
         vmaDestroyAllocator(underlying_);
         underlying_ = nullptr;
     }
@@ -1,8 +1,26 @@
 #pragma once
+#include "memory_budget.hpp"
+#include "pool_allocator.hpp"
 #include "vma/vk_mem_alloc.h"
 
 namespace zoo::render::resources {
 
+// vma user data of allocations made by `Buffer` and `Texture`, points back at the owning resource so that the
+// `Defragmenter` can patch it after moving the allocation. the low bit tells the two apart.
+enum class Resource_Kind : uintptr_t { buffer = 0, texture = 1 };
+
+inline void* encode_resource(void* resource, Resource_Kind kind) noexcept {
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(resource) | static_cast<uintptr_t>(kind));
+}
+
+inline Resource_Kind decode_resource_kind(void* user_data) noexcept {
+    return static_cast<Resource_Kind>(reinterpret_cast<uintptr_t>(user_data) & 1);
+}
+
+inline void* decode_resource(void* user_data) noexcept {
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(user_data) & ~uintptr_t{ 1 });
+}
+
 class Allocator {
 public:
     Allocator() noexcept;
@@ -14,7 +32,14 @@ public:
     Allocator(Allocator&& other) noexcept            = delete;
     Allocator& operator=(Allocator&& other) noexcept = delete;
 
-    void emplace(VkInstance instance, VkDevice device, VkPhysicalDevice pd) noexcept;
+    // `memory_budget` when `VK_EXT_memory_budget` was enabled on `device`. `allocation_callbacks` are the ones `device`
+    // was created with, vma uses them for its own bookkeeping and the buffers and images it creates.
+    void emplace(
+        VkInstance instance,
+        VkDevice device,
+        VkPhysicalDevice pd,
+        const VkAllocationCallbacks* allocation_callbacks,
+        bool memory_budget = false) noexcept;
 
     void reset() noexcept;
 
@@ -24,10 +49,24 @@ public:
     operator VmaAllocator() const noexcept { return get(); };
 
     VkDevice device() const noexcept { return create_info_.device; }
+    const VkAllocationCallbacks* allocation_callbacks() const noexcept { return create_info_.pAllocationCallbacks; }
+
+    // `nullptr` for `Memory_Pool::none` or when the pool could not be created, vma then uses its default heaps.
+    VmaPool pool(Memory_Pool pool) const noexcept;
+    Pool_Allocator& pool_allocator(Memory_Pool pool) noexcept;
+
+    Memory_Budget& budget() noexcept { return budget_; }
+    const Memory_Budget& budget() const noexcept { return budget_; }
+
+private:
+    void create_pools() noexcept;
 
 private:
     VmaAllocatorCreateInfo create_info_;
     VmaAllocator underlying_;
+
+    Pool_Allocator pools_[static_cast<size_t>(Memory_Pool::count)];
+    Memory_Budget budget_;
 };
 
 } // namespace zoo::render::resources
@@ -10,14 +10,31 @@ Buffer Builder::build(const Allocator& allocator) noexcept {
     buffer_info.size  = count_ * obj_size_;
     buffer_info.usage = usage_;
 
+    // the defragmenter relocates resources in the general pool with a gpu copy.
+    if (memory_pool_ == Memory_Pool::general) buffer_info.usage |= RELOCATABLE_USAGE;
+
     VmaAllocationCreateInfo alloc_info{};
     alloc_info.usage = memory_usage_;
     alloc_info.flags = memory_create_flags_;
+    alloc_info.pool  = allocator.pool(memory_pool_);
 
     VmaAllocation allocation{};
-    VK_EXPECT_SUCCESS(vmaCreateBuffer(allocator, &buffer_info, &alloc_info, &buffer_, &allocation, &allocation_info_));
-
-    return Buffer(name_, buffer_, usage_, obj_size_, count_, allocator, allocation, allocation_info_);
+    const auto create = [&]() {
+        return vmaCreateBuffer(allocator, &buffer_info, &alloc_info, &buffer_, &allocation, &allocation_info_);
+    };
+
+    VkResult result = create();
+    if (result != VK_SUCCESS && alloc_info.pool != nullptr) {
+        ZOO_LOG_WARN(
+            "Buffer {} could not be allocated from pool {}, falling back to default heaps",
+            name_.view(),
+            memory_pool_name(memory_pool_));
+        alloc_info.pool = nullptr;
+        result          = create();
+    }
+    VK_EXPECT_SUCCESS(result);
+
+    return Buffer(name_, buffer_, buffer_info.usage, obj_size_, count_, allocator, allocation, allocation_info_);
 }
 
 Builder& Builder::count(size_t count) noexcept {
@@ -40,7 +57,12 @@ Builder& Builder::allocation_flag(VmaAllocationCreateFlags flags) noexcept {
     return *this;
 }
 
-Builder::Builder(std::string_view name, size_t size) noexcept {
+Builder& Builder::pool(Memory_Pool pool) noexcept {
+    memory_pool_ = pool;
+    return *this;
+}
+
+Builder::Builder(core::Name name, size_t size) noexcept {
     name_     = name;
     obj_size_ = size;
 }
@@ -48,7 +70,7 @@ Builder::Builder(std::string_view name, size_t size) noexcept {
 } // namespace buffer
 
 Buffer::Buffer(
-    std::string name,
+    core::Name name,
     VkBuffer buffer,
     VkBufferUsageFlags usage,
     size_t obj_size,
@@ -58,11 +80,13 @@ Buffer::Buffer(
     VmaAllocationInfo allocation_info) noexcept :
     name_{ name },
     buffer_{ buffer }, usage_{ usage }, obj_size_{ obj_size }, count_{ count }, allocator_{ allocator },
-    allocation_{ allocation }, allocation_info_{ allocation_info } {}
+    allocation_{ allocation }, allocation_info_{ allocation_info } {
+    track_allocation();
+}
 
 Buffer::~Buffer() noexcept { release_allocation(); }
 
-buffer::Builder Buffer::start_build(std::string_view name, size_t size) noexcept { return { name, size }; }
+buffer::Builder Buffer::start_build(core::Name name, size_t size) noexcept { return { name, size }; }
 
 void* Buffer::map() noexcept {
     void* data = nullptr;
@@ -87,7 +111,7 @@ Buffer::Buffer(Buffer&& o) noexcept { *this = std::move(o); }
 Buffer& Buffer::operator=(Buffer&& o) noexcept {
     release_allocation();
 
-    name_ = std::move(o.name_);
+    name_ = o.name_;
 
     buffer_ = o.buffer_;
     usage_  = o.usage_;
@@ -100,6 +124,7 @@ Buffer& Buffer::operator=(Buffer&& o) noexcept {
     allocation_info_ = o.allocation_info_;
 
     o.reset_members();
+    track_allocation();
 
     return *this;
 }
@@ -111,8 +136,18 @@ void Buffer::release_allocation() noexcept {
     if (allocator_ && buffer_ && allocation_) vmaDestroyBuffer(allocator_, buffer_, allocation_);
 }
 
+void Buffer::track_allocation() noexcept {
+    if (allocator_ && allocation_)
+        vmaSetAllocationUserData(allocator_, allocation_, encode_resource(this, Resource_Kind::buffer));
+}
+
+VkBuffer Buffer::relocate(VkBuffer buffer) noexcept {
+    std::swap(buffer_, buffer);
+    return buffer;
+}
+
 void Buffer::reset_members() noexcept {
-    name_            = "DEINITIALIZED_BUFFER";
+    name_            = {};
     buffer_          = nullptr;
     usage_           = {};
     obj_size_        = 0;
@@ -1,5 +1,6 @@
 #pragma once
 #include "allocator.hpp"
+#include "core/name.hpp"
 #include "render/fwd.hpp"
 
 #include <stdx/function_ref.hpp>
@@ -7,19 +8,26 @@
 namespace zoo::render::resources {
 
 class Buffer;
+class Defragmenter;
 
 namespace buffer {
 
 class Builder {
 public:
+    static constexpr VkBufferUsageFlags RELOCATABLE_USAGE =
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
     Buffer build(const Allocator& allocator) noexcept;
 
-    Builder(std::string_view name, size_t size) noexcept;
+    Builder(core::Name name, size_t size) noexcept;
     Builder& count(size_t count) noexcept;
     Builder& usage(VkBufferUsageFlags usage) noexcept;
     Builder& allocation_type(VmaMemoryUsage usage) noexcept;
     Builder& allocation_flag(VmaAllocationCreateFlags flags) noexcept;
 
+    // memory type of the pool wins over `allocation_type`, falls back to the default heaps if the buffer doesn't fit.
+    Builder& pool(Memory_Pool pool) noexcept;
+
 private:
     VkBuffer buffer_                              = {};
     VkBufferUsageFlags usage_                     = {};
@@ -28,7 +36,8 @@ private:
     VmaAllocationInfo allocation_info_            = {};
     VmaMemoryUsage memory_usage_                  = VMA_MEMORY_USAGE_AUTO;
     VmaAllocationCreateFlags memory_create_flags_ = {};
-    std::string name_                             = {};
+    Memory_Pool memory_pool_                      = Memory_Pool::none;
+    core::Name name_                              = {};
 };
 
 } // namespace buffer
@@ -46,14 +55,14 @@ public:
     using builder_type = buffer::Builder;
 
     template <typename Type>
-    static builder_type start_build(std::string_view name) noexcept {
+    static builder_type start_build(core::Name name) noexcept {
         return start_build(name, sizeof(Type));
     }
 
-    static builder_type start_build(std::string_view name, size_t size) noexcept;
+    static builder_type start_build(core::Name name, size_t size) noexcept;
 
     explicit Buffer(
-        std::string name,
+        core::Name name,
         VkBuffer buffer,
         VkBufferUsageFlags usage,
         size_t obj_size,
@@ -94,6 +103,8 @@ public:
     inline size_t object_size() const noexcept { return obj_size_; }
     inline size_t count() const noexcept { return count_; }
 
+    core::Name name() const noexcept { return name_; }
+
     operator bool() const noexcept { return valid(); }
     bool valid() const noexcept { return buffer_ != nullptr; }
 
@@ -101,10 +112,17 @@ private:
     void release_allocation() noexcept;
     void reset_members() noexcept;
 
+    // keeps the vma user data pointing at this object, needs to be called whenever the allocation changes owner.
+    void track_allocation() noexcept;
+
+    // swaps in `buffer`, which is bound to wherever the defragmenter moved our allocation. returns the old handle.
+    VkBuffer relocate(VkBuffer buffer) noexcept;
+
 private:
     friend class BufferView;
+    friend class Defragmenter;
     // simply for debugging.
-    std::string name_ = "BUFFER_NOT_INITIALIZED";
+    core::Name name_ = {};
 
     VkBuffer buffer_          = nullptr;
     VkBufferUsageFlags usage_ = {};
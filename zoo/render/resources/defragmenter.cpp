@@ -0,0 +1,387 @@
+#include "defragmenter.hpp"
+#include "render/device_context.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace zoo::render::resources {
+
+namespace {
+
+VkImageMemoryBarrier image_barrier(
+    VkImage image,
+    const VkImageCreateInfo& info,
+    VkImageLayout old_layout,
+    VkImageLayout new_layout,
+    VkAccessFlags src_access,
+    VkAccessFlags dst_access) noexcept {
+    VkImageMemoryBarrier barrier{};
+    barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout                       = old_layout;
+    barrier.newLayout                       = new_layout;
+    barrier.srcAccessMask                   = src_access;
+    barrier.dstAccessMask                   = dst_access;
+    barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image                           = image;
+    barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel   = 0;
+    barrier.subresourceRange.levelCount     = info.mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount     = info.arrayLayers;
+    return barrier;
+}
+
+} // namespace
+
+Defragmenter::Defragmenter(Device_Context& context) noexcept :
+    context_(&context), command_buffer_(context.vk_command_buffer_from_pool(Operation::transfer)),
+    fence_(context, false) {}
+
+Defragmenter::~Defragmenter() noexcept { stop(); }
+
+void Defragmenter::on_relocate(relocate_callback cb) noexcept { relocate_cbs_.emplace_back(std::move(cb)); }
+
+bool Defragmenter::start(Memory_Pool pool) noexcept {
+    if (context_ == nullptr || active()) return false;
+
+    auto& allocator = context_->allocator();
+    pool_           = pool;
+
+    VmaDefragmentationInfo info{};
+    info.flags                 = VMA_DEFRAGMENTATION_FLAG_ALGORITHM_BALANCED_BIT;
+    info.pool                  = allocator.pool(pool_);
+    info.maxBytesPerPass       = MAX_BYTES_PER_PASS;
+    info.maxAllocationsPerPass = MAX_MOVES_PER_PASS;
+
+    if (pool_ != Memory_Pool::none && info.pool == nullptr) return false;
+
+    VK_EXPECT_SUCCESS(vmaBeginDefragmentation(allocator, &info, &defragmentation_));
+    stage_ = Stage::idle;
+    return defragmentation_ != nullptr;
+}
+
+void Defragmenter::stop() noexcept {
+    if (!active()) return;
+
+    if (stage_ == Stage::copy) {
+        fence_.wait();
+        publish_pass();
+    }
+
+    // frames still in flight may reference the old resources.
+    if (stage_ == Stage::drain) {
+        context_->wait();
+        end_pass();
+    }
+
+    finish();
+}
+
+void Defragmenter::update() noexcept {
+    if (!active()) return;
+
+    switch (stage_) {
+        case Stage::idle: begin_pass(); break;
+        case Stage::copy:
+            if (fence_.is_signaled() == sync::Fence::signaled) publish_pass();
+            break;
+        case Stage::drain:
+            if (++frames_since_publish_ >= FRAMES_IN_FLIGHT) end_pass();
+            break;
+    }
+}
+
+void Defragmenter::begin_pass() noexcept {
+    auto& allocator = context_->allocator();
+    const auto time = std::chrono::high_resolution_clock::now();
+
+    current_pass_            = {};
+    block_bytes_before_pass_ = block_bytes();
+
+    const VkResult result = vmaBeginDefragmentationPass(allocator, defragmentation_, &pass_);
+    if (result == VK_SUCCESS) {
+        // nothing left to move.
+        finish();
+        return;
+    }
+    if (result != VK_INCOMPLETE) {
+        ZOO_LOG_ERROR("vmaBeginDefragmentationPass failed with {}", string_VkResult(result));
+        finish();
+        return;
+    }
+
+    moves_.clear();
+    moves_.reserve(pass_.moveCount);
+
+    VkCommandBufferBeginInfo begin_info{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    VK_EXPECT_SUCCESS(vkBeginCommandBuffer(command_buffer_, &begin_info));
+
+    for (u32 i = 0; i < pass_.moveCount; ++i) {
+        auto& vma_move = pass_.pMoves[i];
+
+        VmaAllocationInfo allocation_info{};
+        vmaGetAllocationInfo(allocator, vma_move.srcAllocation, &allocation_info);
+
+        Move move{ .move = &vma_move, .relocation = {}, .buffer = nullptr, .image = nullptr, .view = nullptr };
+        move.relocation = { decode_resource_kind(allocation_info.pUserData),
+                            decode_resource(allocation_info.pUserData) };
+
+        bool prepared = false;
+        if (move.relocation.resource != nullptr) {
+            switch (move.relocation.kind) {
+                case Resource_Kind::buffer:
+                    prepared = prepare_buffer(move, *static_cast<Buffer*>(move.relocation.resource));
+                    break;
+                case Resource_Kind::texture:
+                    prepared = prepare_texture(move, *static_cast<Texture*>(move.relocation.resource));
+                    break;
+            }
+        }
+
+        if (!prepared) {
+            vma_move.operation = VMA_DEFRAGMENTATION_MOVE_OPERATION_IGNORE;
+            ++current_pass_.skipped;
+            continue;
+        }
+
+        current_pass_.bytes_moved += allocation_info.size;
+        ++current_pass_.moved;
+        moves_.emplace_back(move);
+    }
+
+    // make the copies visible to whatever reads the resources next.
+    VkMemoryBarrier barrier{};
+    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+    vkCmdPipelineBarrier(
+        command_buffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        1,
+        &barrier,
+        0,
+        nullptr,
+        0,
+        nullptr);
+    VK_EXPECT_SUCCESS(vkEndCommandBuffer(command_buffer_));
+
+    current_pass_.record_ms =
+        std::chrono::duration<f64, std::milli>(std::chrono::high_resolution_clock::now() - time).count();
+
+    if (moves_.empty()) {
+        // every allocation vma wanted to move is pinned, further passes would propose the same moves.
+        vmaEndDefragmentationPass(allocator, defragmentation_, &pass_);
+        finish();
+        return;
+    }
+
+    VkSubmitInfo submit_info{};
+    submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers    = &command_buffer_;
+
+    fence_.reset();
+    VK_EXPECT_SUCCESS(vkQueueSubmit(context_->retrieve(Operation::transfer), 1, &submit_info, fence_));
+    stage_ = Stage::copy;
+}
+
+void Defragmenter::publish_pass() noexcept {
+    for (auto& move : moves_) {
+        switch (move.relocation.kind) {
+            case Resource_Kind::buffer:
+                move.buffer = static_cast<Buffer*>(move.relocation.resource)->relocate(move.buffer);
+                break;
+            case Resource_Kind::texture: {
+                auto [image, view] = static_cast<Texture*>(move.relocation.resource)->relocate(move.image);
+                move.image         = image;
+                move.view          = view;
+            } break;
+        }
+
+        for (auto& cb : relocate_cbs_)
+            cb(move.relocation);
+    }
+
+    frames_since_publish_ = 0;
+    stage_                = Stage::drain;
+}
+
+void Defragmenter::end_pass() noexcept {
+    // `move` now holds the old handles, nothing can reference them anymore.
+    for (auto& move : moves_) {
+        if (move.view != nullptr) vkDestroyImageView(*context_, move.view, context_->allocation_callbacks());
+        if (move.image != nullptr) vkDestroyImage(*context_, move.image, context_->allocation_callbacks());
+        if (move.buffer != nullptr) vkDestroyBuffer(*context_, move.buffer, context_->allocation_callbacks());
+    }
+    moves_.clear();
+
+    const VkResult result = vmaEndDefragmentationPass(context_->allocator(), defragmentation_, &pass_);
+
+    current_pass_.bytes_freed = static_cast<s64>(block_bytes_before_pass_) - static_cast<s64>(block_bytes());
+    last_pass_ = current_pass_;
+    ZOO_LOG_INFO(
+        "Defragmentation pass on {} : moved {} ({} bytes), skipped {}, freed {} bytes, recorded in {:.3f}ms",
+        memory_pool_name(pool_),
+        last_pass_.moved,
+        last_pass_.bytes_moved,
+        last_pass_.skipped,
+        last_pass_.bytes_freed,
+        last_pass_.record_ms);
+
+    stage_ = Stage::idle;
+    if (result == VK_SUCCESS) finish();
+}
+
+void Defragmenter::finish() noexcept {
+    if (defragmentation_ != nullptr) {
+        VmaDefragmentationStats stats{};
+        vmaEndDefragmentation(context_->allocator(), defragmentation_, &stats);
+        ZOO_LOG_INFO(
+            "Defragmentation of {} done : moved {} allocations ({} bytes), freed {} bytes and {} blocks",
+            memory_pool_name(pool_),
+            stats.allocationsMoved,
+            stats.bytesMoved,
+            stats.bytesFreed,
+            stats.deviceMemoryBlocksFreed);
+    }
+    defragmentation_ = nullptr;
+    pass_            = {};
+    stage_           = Stage::idle;
+}
+
+bool Defragmenter::prepare_buffer(Move& move, Buffer& buffer) noexcept {
+    if ((buffer.usage_ & buffer::Builder::RELOCATABLE_USAGE) != buffer::Builder::RELOCATABLE_USAGE) return false;
+
+    VkBufferCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size  = buffer.allocated_size();
+    info.usage = buffer.usage_;
+
+    if (vkCreateBuffer(*context_, &info, context_->allocation_callbacks(), &move.buffer) != VK_SUCCESS) return false;
+    if (vmaBindBufferMemory(context_->allocator(), move.move->dstTmpAllocation, move.buffer) != VK_SUCCESS) {
+        vkDestroyBuffer(*context_, move.buffer, context_->allocation_callbacks());
+        move.buffer = nullptr;
+        return false;
+    }
+
+    record_buffer_copy(move, buffer);
+    return true;
+}
+
+bool Defragmenter::prepare_texture(Move& move, Texture& texture) noexcept {
+    const auto usage = texture.create_info_.usage;
+    if ((usage & texture::Builder::RELOCATABLE_USAGE) != texture::Builder::RELOCATABLE_USAGE) return false;
+
+    // attachments are referenced by framebuffers we can't patch, they are recreated on resize anyway.
+    if (usage & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT)) return false;
+
+    // nothing was uploaded yet and there is no layout to go back to after the copy.
+    const auto layout = texture.layout();
+    if (layout == VK_IMAGE_LAYOUT_UNDEFINED || layout == VK_IMAGE_LAYOUT_PREINITIALIZED) return false;
+
+    VkImageCreateInfo info = texture.create_info_;
+    info.initialLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    if (vkCreateImage(*context_, &info, context_->allocation_callbacks(), &move.image) != VK_SUCCESS) return false;
+    if (vmaBindImageMemory(context_->allocator(), move.move->dstTmpAllocation, move.image) != VK_SUCCESS) {
+        vkDestroyImage(*context_, move.image, context_->allocation_callbacks());
+        move.image = nullptr;
+        return false;
+    }
+
+    record_texture_copy(move, texture);
+    return true;
+}
+
+void Defragmenter::record_buffer_copy(const Move& move, const Buffer& buffer) noexcept {
+    VkBufferCopy copy{ .srcOffset = 0, .dstOffset = 0, .size = buffer.allocated_size() };
+    vkCmdCopyBuffer(command_buffer_, buffer.handle(), move.buffer, 1, &copy);
+}
+
+void Defragmenter::record_texture_copy(const Move& move, const Texture& texture) noexcept {
+    const auto& info  = texture.create_info_;
+    const auto layout = texture.layout();
+    const auto access = texture.access_flags();
+    const auto old    = texture.handle();
+
+    VkImageMemoryBarrier to_copy[] = {
+        image_barrier(old, info, layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, access, VK_ACCESS_TRANSFER_READ_BIT),
+        image_barrier(
+            move.image,
+            info,
+            VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            0,
+            VK_ACCESS_TRANSFER_WRITE_BIT),
+    };
+    vkCmdPipelineBarrier(
+        command_buffer_,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        static_cast<u32>(std::size(to_copy)),
+        to_copy);
+
+    // one region per mip, every array layer at once.
+    VkImageCopy regions[16] = {};
+    const u32 region_count  = std::min<u32>(info.mipLevels, static_cast<u32>(std::size(regions)));
+    for (u32 mip = 0; mip < region_count; ++mip) {
+        auto& region          = regions[mip];
+        region.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mip, 0, info.arrayLayers };
+        region.dstSubresource = region.srcSubresource;
+        region.extent         = { std::max(info.extent.width >> mip, 1u),
+                                  std::max(info.extent.height >> mip, 1u),
+                                  std::max(info.extent.depth >> mip, 1u) };
+    }
+    vkCmdCopyImage(
+        command_buffer_,
+        old,
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        move.image,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        region_count,
+        regions);
+
+    // both images go back to the layout the texture claims to be in, frames recorded before the switch still sample
+    // the old one.
+    VkImageMemoryBarrier to_layout[] = {
+        image_barrier(old, info, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, layout, VK_ACCESS_TRANSFER_READ_BIT, access),
+        image_barrier(
+            move.image,
+            info,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            layout,
+            VK_ACCESS_TRANSFER_WRITE_BIT,
+            access),
+    };
+    vkCmdPipelineBarrier(
+        command_buffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        static_cast<u32>(std::size(to_layout)),
+        to_layout);
+}
+
+VkDeviceSize Defragmenter::block_bytes() const noexcept {
+    if (pool_ != Memory_Pool::none) return context_->allocator().pool_allocator(pool_).statistics().blockBytes;
+
+    VmaTotalStatistics stats{};
+    vmaCalculateStatistics(context_->allocator(), &stats);
+    return stats.total.statistics.blockBytes;
+}
+
+} // namespace zoo::render::resources
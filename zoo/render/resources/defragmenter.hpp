@@ -0,0 +1,110 @@
+#pragma once
+#include "render/fwd.hpp"
+#include "render/sync/fence.hpp"
+
+#include "allocator.hpp"
+#include "buffer.hpp"
+#include "texture.hpp"
+
+#include <functional>
+
+namespace zoo::render::resources {
+
+// Incremental compaction of a vma pool on top of vma's defragmentation api. each pass moves a bounded amount of
+// memory and goes through three stages, `update` advances to the next one once per frame:
+//  - copy    : new resources are bound to the destination of every move and the copies are submitted.
+//  - drain   : copies finished, `Buffer`/`Texture` now point at the new resources and `on_relocate` listeners rewrite
+//              their descriptors. the old resources stay alive until every frame that may still use them retired.
+//  - release : old resources are destroyed and the pass is ended, which gives the old memory back to vma.
+// only resources that are never written by the gpu after upload should live in a defragmented pool, and they must not
+// be destroyed while a pass is moving them.
+class Defragmenter {
+public:
+    static constexpr VkDeviceSize MAX_BYTES_PER_PASS = VkDeviceSize{ 32 } << 20;
+    static constexpr u32 MAX_MOVES_PER_PASS          = 64;
+
+    // frames that need to go by before resources replaced by a pass can be destroyed.
+    static constexpr u32 FRAMES_IN_FLIGHT = 3;
+
+    struct Pass_Stats {
+        u32 moved                = 0;
+        u32 skipped              = 0;
+        VkDeviceSize bytes_moved = 0; // the cost of the pass in gpu copies.
+        s64 bytes_freed          = 0; // device memory handed back to the driver once the pass ended.
+        f64 record_ms            = 0; // cpu time spent creating resources and recording the copies.
+    };
+
+    struct Relocation {
+        Resource_Kind kind;
+        void* resource; // `Buffer*` or `Texture*` depending on `kind`.
+    };
+
+    using relocate_callback = std::function<void(const Relocation&)>;
+
+    // starts compacting `pool`, does nothing if a defragmentation is already running.
+    bool start(Memory_Pool pool = Memory_Pool::general) noexcept;
+
+    // waits for the pass in flight and stops, the current pass is finished so no resource is left half moved.
+    void stop() noexcept;
+
+    // call once per frame after the fence of the frame has been waited on.
+    void update() noexcept;
+
+    bool active() const noexcept { return context_ != nullptr && defragmentation_ != nullptr; }
+
+    const Pass_Stats& last_pass() const noexcept { return last_pass_; }
+
+    void on_relocate(relocate_callback cb) noexcept;
+
+    Defragmenter(Device_Context& context) noexcept;
+    Defragmenter() noexcept = default;
+    ~Defragmenter() noexcept;
+
+    Defragmenter(const Defragmenter&)            = delete;
+    Defragmenter& operator=(const Defragmenter&) = delete;
+    Defragmenter(Defragmenter&&)                 = delete;
+    Defragmenter& operator=(Defragmenter&&)      = delete;
+
+private:
+    enum class Stage { idle, copy, drain };
+
+    struct Move {
+        VmaDefragmentationMove* move;
+        Relocation relocation;
+        VkBuffer buffer;
+        VkImage image;
+        VkImageView view;
+    };
+
+    void begin_pass() noexcept;
+    void publish_pass() noexcept;
+    void end_pass() noexcept;
+    void finish() noexcept;
+
+    bool prepare_buffer(Move& move, Buffer& buffer) noexcept;
+    bool prepare_texture(Move& move, Texture& texture) noexcept;
+    void record_buffer_copy(const Move& move, const Buffer& buffer) noexcept;
+    void record_texture_copy(const Move& move, const Texture& texture) noexcept;
+
+    VkDeviceSize block_bytes() const noexcept;
+
+private:
+    Device_Context* context_ = nullptr;
+    Memory_Pool pool_        = Memory_Pool::none;
+
+    VmaDefragmentationContext defragmentation_ = nullptr;
+    VmaDefragmentationPassMoveInfo pass_       = {};
+    Stage stage_                               = Stage::idle;
+    u32 frames_since_publish_                  = 0;
+    VkDeviceSize block_bytes_before_pass_      = 0;
+
+    VkCommandBuffer command_buffer_ = nullptr;
+    sync::Fence fence_              = {};
+
+    std::vector<Move> moves_                     = {};
+    std::vector<relocate_callback> relocate_cbs_ = {};
+    Pass_Stats current_pass_                     = {};
+    Pass_Stats last_pass_                        = {};
+};
+
+} // namespace zoo::render::resources
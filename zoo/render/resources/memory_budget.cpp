@@ -0,0 +1,132 @@
+#include "memory_budget.hpp"
+#include "render/fwd.hpp"
+
+#include <algorithm>
+
+namespace zoo::render::resources {
+
+void Memory_Budget::emplace(VmaAllocator allocator) noexcept {
+    allocator_ = allocator;
+
+    const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+    vmaGetMemoryProperties(allocator_, &properties);
+    heap_count_ = properties->memoryHeapCount;
+    for (u32 i = 0; i < heap_count_; ++i)
+        heaps_[i].flags = properties->memoryHeaps[i].flags;
+
+    update();
+}
+
+void Memory_Budget::reset() noexcept {
+    streamables_.clear();
+    free_ids_.clear();
+    candidates_.clear();
+    allocator_  = nullptr;
+    heap_count_ = 0;
+}
+
+f32 Memory_Budget::pressure(u32 index) const noexcept {
+    const auto& heap = heaps_[index];
+    return heap.budget == 0 ? 0.0f : static_cast<f32>(static_cast<f64>(heap.usage) / static_cast<f64>(heap.budget));
+}
+
+u32 Memory_Budget::heap_index(VmaAllocation allocation) const noexcept {
+    VmaAllocationInfo allocation_info{};
+    vmaGetAllocationInfo(allocator_, allocation, &allocation_info);
+
+    const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+    vmaGetMemoryProperties(allocator_, &properties);
+    return properties->memoryTypes[allocation_info.memoryType].heapIndex;
+}
+
+void Memory_Budget::update() noexcept {
+    if (allocator_ == nullptr) return;
+
+    // lets vma refresh its budget estimate instead of querying the driver on every allocation.
+    vmaSetCurrentFrameIndex(allocator_, static_cast<u32>(++frame_));
+
+    VmaBudget budgets[VK_MAX_MEMORY_HEAPS] = {};
+    vmaGetHeapBudgets(allocator_, budgets);
+
+    for (u32 i = 0; i < heap_count_; ++i) {
+        heaps_[i].usage  = budgets[i].usage;
+        heaps_[i].budget = budgets[i].budget;
+
+        const bool over_budget = pressure(i) > EVICTION_THRESHOLD;
+        if (over_budget && !over_budget_[i]) {
+            ZOO_LOG_WARN(
+                "Memory heap {} is at {} of {} bytes, evicting streamable resources",
+                i,
+                heaps_[i].usage,
+                heaps_[i].budget);
+        }
+        over_budget_[i] = over_budget;
+
+        if (over_budget) evict(i);
+    }
+}
+
+Memory_Budget::streamable_id Memory_Budget::track(VmaAllocation allocation, evict_callback evict) noexcept {
+    ZOO_ASSERT(allocator_ != nullptr, "Memory_Budget used before emplace!");
+
+    VmaAllocationInfo allocation_info{};
+    vmaGetAllocationInfo(allocator_, allocation, &allocation_info);
+
+    Streamable streamable{ .allocation = allocation,
+                           .size       = allocation_info.size,
+                           .heap       = heap_index(allocation),
+                           .last_used  = frame_,
+                           .evict      = std::move(evict) };
+
+    if (!free_ids_.empty()) {
+        const streamable_id id = free_ids_.back();
+        free_ids_.pop_back();
+        streamables_[id] = std::move(streamable);
+        return id;
+    }
+
+    streamables_.emplace_back(std::move(streamable));
+    return static_cast<streamable_id>(streamables_.size() - 1);
+}
+
+void Memory_Budget::untrack(streamable_id id) noexcept {
+    if (id >= streamables_.size() || streamables_[id].allocation == nullptr) return;
+    streamables_[id] = {};
+    free_ids_.emplace_back(id);
+}
+
+void Memory_Budget::touch(streamable_id id) noexcept {
+    if (id < streamables_.size()) streamables_[id].last_used = frame_;
+}
+
+void Memory_Budget::evict(u32 heap_index) noexcept {
+    auto& heap = heaps_[heap_index];
+
+    auto& candidates = candidates_;
+    candidates.clear();
+    for (streamable_id id = 0; id < streamables_.size(); ++id) {
+        const auto& streamable = streamables_[id];
+        if (streamable.allocation != nullptr && streamable.heap == heap_index && streamable.last_used < frame_)
+            candidates.emplace_back(id);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [&](streamable_id lhs, streamable_id rhs) {
+        return streamables_[lhs].last_used < streamables_[rhs].last_used;
+    });
+
+    const auto target = static_cast<VkDeviceSize>(static_cast<f64>(heap.budget) * EVICTION_TARGET);
+    for (streamable_id id : candidates) {
+        if (heap.usage <= target) break;
+        if (streamables_[id].allocation == nullptr) continue;
+
+        // the callback may track or untrack other resources, don't hold on to a reference.
+        auto evict      = std::move(streamables_[id].evict);
+        const auto size = streamables_[id].size;
+        untrack(id);
+        if (evict) evict();
+
+        heap.usage = heap.usage > size ? heap.usage - size : 0;
+    }
+}
+
+} // namespace zoo::render::resources
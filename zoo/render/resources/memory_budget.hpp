@@ -0,0 +1,78 @@
+#pragma once
+#include "core/fwd.hpp"
+#include "vma/vk_mem_alloc.h"
+
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace zoo::render::resources {
+
+// Per heap view of device memory usage against the budget reported by `VK_EXT_memory_budget` (vma estimates the
+// budget when the extension is missing). When a heap goes over `EVICTION_THRESHOLD` of its budget the least recently
+// used streamable resources on that heap are evicted until usage drops below `EVICTION_TARGET`.
+class Memory_Budget {
+public:
+    static constexpr f32 EVICTION_THRESHOLD = 0.9f;
+    static constexpr f32 EVICTION_TARGET    = 0.8f;
+
+    using streamable_id  = u32;
+    using evict_callback = std::function<void()>;
+
+    static constexpr streamable_id INVALID_STREAMABLE = std::numeric_limits<streamable_id>::max();
+
+    struct Heap {
+        VkDeviceSize usage      = 0;
+        VkDeviceSize budget     = 0;
+        VkMemoryHeapFlags flags = 0;
+    };
+
+    void emplace(VmaAllocator allocator) noexcept;
+    void reset() noexcept;
+
+    // polls `vmaGetHeapBudgets` and evicts if needed, call once per frame.
+    void update() noexcept;
+
+    u32 heap_count() const noexcept { return heap_count_; }
+    const Heap& heap(u32 index) const noexcept { return heaps_[index]; }
+
+    // usage over budget of a heap, above 1 means the heap is oversubscribed.
+    f32 pressure(u32 index) const noexcept;
+
+    // the heap `allocation` was made on.
+    u32 heap_index(VmaAllocation allocation) const noexcept;
+
+    // `evict` has to release the allocation, it is called from `update` and must defer the destruction itself if the
+    // resource may still be used by a frame in flight. the resource is untracked once evicted.
+    streamable_id track(VmaAllocation allocation, evict_callback evict) noexcept;
+    void untrack(streamable_id id) noexcept;
+
+    // marks the resource as used by the current frame, resources touched this frame are never evicted.
+    void touch(streamable_id id) noexcept;
+
+private:
+    void evict(u32 heap_index) noexcept;
+
+private:
+    struct Streamable {
+        VmaAllocation allocation = nullptr;
+        VkDeviceSize size        = 0;
+        u32 heap                 = 0;
+        u64 last_used            = 0;
+        evict_callback evict     = {};
+    };
+
+    VmaAllocator allocator_ = nullptr;
+    u64 frame_              = 0;
+
+    Heap heaps_[VK_MAX_MEMORY_HEAPS]       = {};
+    bool over_budget_[VK_MAX_MEMORY_HEAPS] = {};
+    u32 heap_count_                        = 0;
+
+    std::vector<Streamable> streamables_ = {};
+    std::vector<streamable_id> free_ids_ = {};
+    // reused by `evict` so that evicting doesn't allocate once it has seen its largest candidate list.
+    std::vector<streamable_id> candidates_ = {};
+};
+
+} // namespace zoo::render::resources
@@ -1,6 +1,9 @@
 #include "mesh.hpp"
 
+#include "core/allocator.hpp"
 #include "render/fwd.hpp"
+#include <numeric>
+#include <stdx/parallel.hpp>
 #include <tiny_obj_loader.h>
 
 #include "render/scene/upload_context.hpp"
@@ -10,8 +13,12 @@ namespace zoo::render::resources {
 
 namespace {
 
+// vertices handed to a worker at a time when unpacking a mesh.
+constexpr size_t VERTEX_GRAIN = 4096;
+
 // lifted from vkguide.dev
 MeshData load_mesh_data(std::string_view dir_name, std::string_view file_name) {
+    ZOO_MEMORY_TAG(core::Memory_Tag::mesh);
 
     // attrib will contain the vertex arrays of the file
     tinyobj::attrib_t attrib;
@@ -40,16 +47,25 @@ MeshData load_mesh_data(std::string_view dir_name, std::string_view file_name) {
         ZOO_LOG_ERROR("[load_mesh] : {}", err);
     }
 
-    std::vector<Vertex> vertices{};
-    std::vector<uint32_t> indices{};
+    size_t vertex_count = 0;
+    for (const auto& shape : shapes)
+        vertex_count += shape.mesh.indices.size();
+
+    // every index gets its own vertex, so where each shape lands is known up front and vertices can be filled in
+    // parallel.
+    std::vector<Vertex> vertices(vertex_count);
+    std::vector<uint32_t> indices(vertex_count);
+    std::iota(indices.begin(), indices.end(), uint32_t{ 0 });
 
-    // TODO: optimize this part out.
+    Vertex* shape_vertices = vertices.data();
     for (const auto& shape : shapes) {
-        for (const auto& index : shape.mesh.indices) {
-            Vertex vertex{};
-            vertex.pos = { attrib.vertices[3 * index.vertex_index + 0],
-                           attrib.vertices[3 * index.vertex_index + 1],
-                           attrib.vertices[3 * index.vertex_index + 2] };
+        const auto& shape_indices = shape.mesh.indices;
+        stdx::parallel_for(stdx::irange(size_t{ 0 }, shape_indices.size()), VERTEX_GRAIN, [&](size_t i) {
+            const auto& index = shape_indices[i];
+            Vertex& vertex    = shape_vertices[i];
+            vertex.pos        = { attrib.vertices[3 * index.vertex_index + 0],
+                                  attrib.vertices[3 * index.vertex_index + 1],
+                                  attrib.vertices[3 * index.vertex_index + 2] };
 
             vertex.normal = { attrib.normals[3 * index.normal_index + 0],
                               attrib.normals[3 * index.normal_index + 1],
@@ -59,13 +75,11 @@ MeshData load_mesh_data(std::string_view dir_name, std::string_view file_name) {
             vertex.color = vertex.normal; //  { 1.0, 1.0, 1.0 };
             vertex.uv    = { attrib.texcoords[2 * index.texcoord_index + 0],
                              1.0f - attrib.texcoords[2 * index.texcoord_index + 1] };
-
-            vertices.push_back(vertex);
-            indices.push_back(uint32_t(indices.size()));
-        }
+        });
+        shape_vertices += shape_indices.size();
     }
 
-    return { vertices, indices };
+    return { std::move(vertices), std::move(indices) };
 }
 
 } // namespace
@@ -87,11 +101,12 @@ render::resources::Buffer create_gpu_native_buffer(
     VkBufferUsageFlags usage) {
 
     // TODO: add optional range.
-    auto scratch_buffer = render::resources::Buffer::start_build<T>(fmt::format("ScratchBuffer : {}", name))
+    auto scratch_buffer = render::resources::Buffer::start_build<T>(core::format_name("ScratchBuffer : {}", name))
                               .count(static_cast<u32>(variable.size()))
                               .usage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
                               .allocation_type(VMA_MEMORY_USAGE_AUTO_PREFER_HOST)
                               .allocation_flag(VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT)
+                              .pool(render::resources::Memory_Pool::staging)
                               .build(allocator);
 
     scratch_buffer.template map<T>([&variable](T* data) { std::copy(std::begin(variable), std::end(variable), data); });
@@ -100,6 +115,7 @@ render::resources::Buffer create_gpu_native_buffer(
                                  .count(static_cast<u32>(variable.size()))
                                  .usage(VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage)
                                  .allocation_type(VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE)
+                                 .pool(render::resources::Memory_Pool::general)
                                  .build(allocator);
 
     upload_context.copy(scratch_buffer, gpu_native_buffer);
@@ -0,0 +1,44 @@
+#include "pool_allocator.hpp"
+#include "render/fwd.hpp"
+
+namespace zoo::render::resources {
+
+const char* memory_pool_name(Memory_Pool pool) noexcept {
+    switch (pool) {
+        case Memory_Pool::none: return "none";
+        case Memory_Pool::staging: return "staging";
+        case Memory_Pool::frame: return "frame";
+        case Memory_Pool::render_target: return "render_target";
+        case Memory_Pool::general: return "general";
+        default: return "unknown";
+    }
+}
+
+Pool_Allocator::Pool_Allocator() noexcept = default;
+
+Pool_Allocator::~Pool_Allocator() noexcept {
+    if (underlying_ != nullptr) reset();
+}
+
+void Pool_Allocator::emplace(VmaAllocator allocator, const VmaPoolCreateInfo& create_info, const char* name) noexcept {
+    ZOO_ASSERT(underlying_ == nullptr, "Pool_Allocator::emplace called twice without reset!");
+    allocator_ = allocator;
+    VK_EXPECT_SUCCESS(vmaCreatePool(allocator_, &create_info, &underlying_));
+    if (underlying_ != nullptr) vmaSetPoolName(allocator_, underlying_, name);
+}
+
+void Pool_Allocator::reset() noexcept {
+    if (underlying_ != nullptr) {
+        vmaDestroyPool(allocator_, underlying_);
+        underlying_ = nullptr;
+    }
+    allocator_ = nullptr;
+}
+
+VmaStatistics Pool_Allocator::statistics() const noexcept {
+    VmaStatistics stats{};
+    if (underlying_ != nullptr) vmaGetPoolStatistics(allocator_, underlying_, &stats);
+    return stats;
+}
+
+} // namespace zoo::render::resources
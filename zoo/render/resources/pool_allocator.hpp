@@ -1,12 +1,26 @@
 #pragma once
-#include "allocator.hpp"
+#include "core/fwd.hpp"
 #include "vma/vk_mem_alloc.h"
 
 namespace zoo::render::resources {
 
+// what a resource is used for, decides which `Pool_Allocator` it is sub-allocated from.
+enum class Memory_Pool : u8 {
+    none,          // default vma heaps.
+    staging,       // short lived upload buffers, linear.
+    frame,         // per frame uniform/storage and dynamic host visible buffers.
+    render_target, // color/depth attachments.
+    general,       // device local mesh and texture data.
+    count
+};
+
+const char* memory_pool_name(Memory_Pool pool) noexcept;
+
+// owns a single `VmaPool`. all allocations within the pool share one memory type, which is found once when the pool
+// is created so vma does not have to search every heap on each allocation.
 class Pool_Allocator {
 public:
-    Pool_Allocator(const Allocator& allocator) noexcept;
+    Pool_Allocator() noexcept;
     ~Pool_Allocator() noexcept;
 
     Pool_Allocator(const Pool_Allocator& other)            = delete;
@@ -15,9 +29,20 @@ public:
     Pool_Allocator(Pool_Allocator&& other) noexcept            = delete;
     Pool_Allocator& operator=(Pool_Allocator&& other) noexcept = delete;
 
+    void emplace(VmaAllocator allocator, const VmaPoolCreateInfo& create_info, const char* name) noexcept;
+
+    void reset() noexcept;
+
+    operator bool() const noexcept { return underlying_ != nullptr; }
+
+    VmaPool get() const noexcept { return underlying_; }
+    operator VmaPool() const noexcept { return get(); }
+
+    VmaStatistics statistics() const noexcept;
+
 private:
-    VmaPoolCreateInfo create_info_;
-    VmaPool underlying_;
+    VmaAllocator allocator_ = nullptr;
+    VmaPool underlying_     = nullptr;
 };
 
 } // namespace zoo::render::resources
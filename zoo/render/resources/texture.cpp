@@ -19,12 +19,12 @@ VkImageViewType vk_image_type_to_image_view_type(VkImageType image_type) noexcep
 
 VkImageAspectFlags vk_image_usage_to_aspect_mask(VkImageUsageFlags usage_flags) noexcept {
     VkImageAspectFlags aspect_mask = VK_IMAGE_ASPECT_NONE;
-    if (usage_flags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT || usage_flags & VK_IMAGE_USAGE_SAMPLED_BIT) {
-        aspect_mask |= VK_IMAGE_ASPECT_COLOR_BIT;
-    }
     if (usage_flags & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) {
         // TODO: add stencil
+        // depth buffers that are also sampled still only have a depth aspect.
         aspect_mask |= VK_IMAGE_ASPECT_DEPTH_BIT;
+    } else if (usage_flags & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT || usage_flags & VK_IMAGE_USAGE_SAMPLED_BIT) {
+        aspect_mask |= VK_IMAGE_ASPECT_COLOR_BIT;
     }
 
     ZOO_ASSERT(aspect_mask != VK_IMAGE_ASPECT_NONE);
@@ -43,7 +43,7 @@ size_t get_format_size(VkFormat format) noexcept {
 
 namespace texture {
 
-Builder::Builder(std::string_view name) noexcept { name_ = name; }
+Builder::Builder(core::Name name) noexcept { name_ = name; }
 
 Builder& Builder::allocation_type(VmaMemoryUsage usage) noexcept {
     memory_usage_ = usage;
@@ -55,6 +55,11 @@ Builder& Builder::allocation_required_flags(VkMemoryPropertyFlags flags) noexcep
     return *this;
 }
 
+Builder& Builder::pool(Memory_Pool pool) noexcept {
+    memory_pool_ = pool;
+    return *this;
+}
+
 Builder& Builder::mip(uint32_t level) noexcept {
     mip_level_ = level;
     return *this;
@@ -101,7 +106,7 @@ Texture Builder::build(const Allocator& allocator) noexcept {
     info.imageType = image_type_;
 
     if (format_ == VK_FORMAT_UNDEFINED) {
-        ZOO_LOG_ERROR("Format created for texture is undefined, {}", name_);
+        ZOO_LOG_ERROR("Format created for texture is undefined, {}", name_.view());
     }
 
     info.format      = format_;
@@ -114,50 +119,68 @@ Texture Builder::build(const Allocator& allocator) noexcept {
     info.samples = samples_;
     info.tiling  = tiling_;
 
+    // the defragmenter relocates resources in the general pool with a gpu copy.
+    if (memory_pool_ == Memory_Pool::general) info.usage |= RELOCATABLE_USAGE;
+
     VmaAllocationCreateInfo alloc_info{};
     alloc_info.usage         = memory_usage_;
     alloc_info.requiredFlags = memory_properties_flags_;
+    alloc_info.pool          = allocator.pool(memory_pool_);
 
     VkImage image            = {};
     VmaAllocation allocation = {};
-    VK_EXPECT_SUCCESS(vmaCreateImage(allocator, &info, &alloc_info, &image, &allocation, &allocation_info_));
+    VkResult result          = vmaCreateImage(allocator, &info, &alloc_info, &image, &allocation, &allocation_info_);
+    if (result != VK_SUCCESS && alloc_info.pool != nullptr) {
+        ZOO_LOG_WARN(
+            "Texture {} could not be allocated from pool {}, falling back to default heaps",
+            name_.view(),
+            memory_pool_name(memory_pool_));
+        alloc_info.pool = nullptr;
+        result          = vmaCreateImage(allocator, &info, &alloc_info, &image, &allocation, &allocation_info_);
+    }
+    VK_EXPECT_SUCCESS(result);
 
-    return Texture{ name_, image, info, allocator.device(), allocator, allocation, allocation_info_ };
+    return Texture{ name_, image, info, allocator, allocation, allocation_info_ };
 }
 
 } // namespace texture
 
 Texture::Texture(
-    std::string name,
+    core::Name name,
     VkImage image,
     VkImageCreateInfo create_info,
-    VkDevice device,
-    VmaAllocator allocator,
+    const Allocator& allocator,
     VmaAllocation allocation,
     VmaAllocationInfo allocation_info) noexcept :
     name_(name),
-    image_(image), create_info_(create_info), device_(device), allocator_(allocator), allocation_(allocation),
-    allocation_info_(allocation_info), view_(*this, create_image_view_info()) {}
+    image_(image), create_info_(create_info), device_(allocator.device()),
+    allocation_callbacks_(allocator.allocation_callbacks()), allocator_(allocator), allocation_(allocation),
+    allocation_info_(allocation_info), view_(*this, create_image_view_info()) {
+    track_allocation();
+}
 
 Texture::Texture(Texture&& other) noexcept :
-    name_(std::move(other.name_)), image_(std::move(other.image_)), create_info_(std::move(other.create_info_)),
-    device_(std::move(other.device_)), allocator_(std::move(other.allocator_)),
-    allocation_(std::move(other.allocation_)), allocation_info_(std::move(other.allocation_info_)),
-    view_(std::move(other.view_)) {
+    name_(other.name_), image_(std::move(other.image_)), create_info_(std::move(other.create_info_)),
+    device_(std::move(other.device_)), allocation_callbacks_(other.allocation_callbacks_),
+    allocator_(std::move(other.allocator_)), allocation_(std::move(other.allocation_)),
+    allocation_info_(std::move(other.allocation_info_)), view_(std::move(other.view_)) {
     other.invalidate();
+    track_allocation();
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept {
     destroy();
-    name_            = std::move(other.name_);
-    image_           = std::move(other.image_);
-    create_info_     = std::move(other.create_info_);
-    device_          = std::move(other.device_);
-    allocator_       = std::move(other.allocator_);
-    allocation_      = std::move(other.allocation_);
-    allocation_info_ = std::move(other.allocation_info_);
-    view_            = std::move(other.view_);
+    name_                 = other.name_;
+    image_                = std::move(other.image_);
+    create_info_          = std::move(other.create_info_);
+    device_               = std::move(other.device_);
+    allocation_callbacks_ = other.allocation_callbacks_;
+    allocator_            = std::move(other.allocator_);
+    allocation_           = std::move(other.allocation_);
+    allocation_info_      = std::move(other.allocation_info_);
+    view_                 = std::move(other.view_);
     other.invalidate();
+    track_allocation();
     return *this;
 }
 
@@ -189,7 +212,21 @@ VkImageViewCreateInfo Texture::create_image_view_info() const noexcept {
 
     return info;
 }
-Texture::builder_type Texture::start_build(std::string_view name) noexcept { return { name }; }
+void Texture::track_allocation() noexcept {
+    if (allocator_ != nullptr && allocation_ != nullptr && image_ != nullptr)
+        vmaSetAllocationUserData(allocator_, allocation_, encode_resource(this, Resource_Kind::texture));
+}
+
+std::pair<VkImage, VkImageView> Texture::relocate(VkImage image) noexcept {
+    VkImageView old_view = view_;
+    view_.invalidate();
+
+    std::swap(image_, image);
+    view_ = TextureView{ *this, create_image_view_info() };
+    return { image, old_view };
+}
+
+Texture::builder_type Texture::start_build(core::Name name) noexcept { return { name }; }
 
 VkImageLayout Texture::layout() const noexcept { return create_info_.initialLayout; }
 void Texture::layout(VkImageLayout layout) noexcept { create_info_.initialLayout = layout; }
@@ -202,6 +239,8 @@ u32 Texture::mip_level() const noexcept { return create_info_.mipLevels; }
 u32 Texture::array_count() const noexcept { return create_info_.arrayLayers; }
 
 VkExtent3D Texture::extent() const noexcept { return create_info_.extent; }
+VkFormat Texture::format() const noexcept { return create_info_.format; }
+VkSampleCountFlagBits Texture::samples() const noexcept { return create_info_.samples; }
 
 size_t Texture::allocated_size() const noexcept {
     return create_info_.extent.width * create_info_.extent.height * create_info_.extent.depth *
@@ -215,18 +254,21 @@ bool Texture::valid() const noexcept { return image_ != nullptr; }
 void Texture::invalidate() noexcept { image_ = nullptr; }
 
 TextureView::TextureView(const Texture& reference, VkImageViewCreateInfo create_info) noexcept :
-    name_(reference.name()), device_(reference.device()), create_info_(create_info), view_(nullptr) {
-    VK_EXPECT_SUCCESS(vkCreateImageView(reference.device(), &create_info_, nullptr, &view_));
-}
+    TextureView(reference.name(), reference.device(), reference.allocation_callbacks(), create_info) {}
 
-TextureView::TextureView(std::string name, VkDevice device, VkImageViewCreateInfo create_info) noexcept :
-    name_(std::move(name)), device_(device), create_info_(create_info), view_(nullptr) {
-    VK_EXPECT_SUCCESS(vkCreateImageView(device_, &create_info_, nullptr, &view_));
+TextureView::TextureView(
+    core::Name name,
+    VkDevice device,
+    const VkAllocationCallbacks* allocation_callbacks,
+    VkImageViewCreateInfo create_info) noexcept :
+    name_(name),
+    device_(device), allocation_callbacks_(allocation_callbacks), create_info_(create_info), view_(nullptr) {
+    VK_EXPECT_SUCCESS(vkCreateImageView(device_, &create_info_, allocation_callbacks_, &view_));
 }
 
 void TextureView::destroy() noexcept {
     if (view_ != nullptr) {
-        vkDestroyImageView(device_, view_, nullptr);
+        vkDestroyImageView(device_, view_, allocation_callbacks_);
         view_ = nullptr;
     }
 }
@@ -234,20 +276,21 @@ void TextureView::destroy() noexcept {
 TextureView::~TextureView() noexcept { destroy(); }
 
 TextureView::TextureView(TextureView&& other) noexcept :
-    name_(std::move(other.name_)), device_(std::move(other.device_)), create_info_(std::move(other.create_info_)),
-    view_(std::move(other.view_)) {
+    name_(other.name_), device_(std::move(other.device_)), allocation_callbacks_(other.allocation_callbacks_),
+    create_info_(std::move(other.create_info_)), view_(std::move(other.view_)) {
     other.invalidate();
 }
 
 TextureView& TextureView::operator=(TextureView&& other) noexcept {
     // don't set this to null because we don't want a `nullptr`
     destroy();
-    name_ = std::move(other.name_);
+    name_ = other.name_;
 
     // TODO: will this break if another device comes to play?
-    device_      = std::move(other.device_);
-    create_info_ = std::move(other.create_info_);
-    view_        = std::move(other.view_);
+    device_               = std::move(other.device_);
+    allocation_callbacks_ = other.allocation_callbacks_;
+    create_info_          = std::move(other.create_info_);
+    view_                 = std::move(other.view_);
     other.invalidate();
     return *this;
 }
@@ -273,10 +316,11 @@ TextureSampler Builder::build(Device_Context& context) noexcept {
     };
 
     VkSampler sampler = nullptr;
-    vkCreateSampler(context, &info, nullptr, &sampler);
+    vkCreateSampler(context, &info, context.allocation_callbacks(), &sampler);
 
     return {
         context,
+        context.allocation_callbacks(),
         sampler,
         info // FOR DEBUG
     };
@@ -327,29 +371,36 @@ Builder& Builder::max_anisotrophy(f32 value) noexcept {
 
 }; // namespace texture_sampler
 
-TextureSampler::TextureSampler(VkDevice device, VkSampler sampler, VkSamplerCreateInfo create_info) noexcept :
-    device_(device), sampler_(sampler), create_info_(create_info) {}
+TextureSampler::TextureSampler(
+    VkDevice device,
+    const VkAllocationCallbacks* allocation_callbacks,
+    VkSampler sampler,
+    VkSamplerCreateInfo create_info) noexcept :
+    device_(device),
+    allocation_callbacks_(allocation_callbacks), sampler_(sampler), create_info_(create_info) {}
 
 TextureSampler::TextureSampler(TextureSampler&& o) noexcept { *this = std::move(o); }
 
 TextureSampler& TextureSampler::operator=(TextureSampler&& o) noexcept {
     if (device_ && sampler_) {
-        vkDestroySampler(device_, sampler_, nullptr);
+        vkDestroySampler(device_, sampler_, allocation_callbacks_);
     }
 
-    device_      = o.device_;
-    sampler_     = o.sampler_;
-    create_info_ = o.create_info_;
+    device_               = o.device_;
+    allocation_callbacks_ = o.allocation_callbacks_;
+    sampler_              = o.sampler_;
+    create_info_          = o.create_info_;
 
-    o.device_      = nullptr;
-    o.sampler_     = nullptr;
-    o.create_info_ = {};
+    o.device_               = nullptr;
+    o.allocation_callbacks_ = nullptr;
+    o.sampler_              = nullptr;
+    o.create_info_          = {};
 
     return *this;
 }
 TextureSampler::~TextureSampler() noexcept {
     if (device_ && sampler_) {
-        vkDestroySampler(device_, sampler_, nullptr);
+        vkDestroySampler(device_, sampler_, allocation_callbacks_);
     }
 }
 
@@ -3,18 +3,24 @@
 #include "render/fwd.hpp"
 
 #include "allocator.hpp"
+#include "core/name.hpp"
 #include "render/device_context.hpp"
 #include <stdx/function_ref.hpp>
 
 namespace zoo::render::resources {
 
 class Texture;
+class Defragmenter;
 
 /// This may break if another device appears.
 class TextureView {
 public:
     TextureView(const Texture& reference, VkImageViewCreateInfo create_info) noexcept;
-    TextureView(std::string name, VkDevice device, VkImageViewCreateInfo create_info) noexcept;
+    TextureView(
+        core::Name name,
+        VkDevice device,
+        const VkAllocationCallbacks* allocation_callbacks,
+        VkImageViewCreateInfo create_info) noexcept;
 
     TextureView() = default;
     ~TextureView() noexcept;
@@ -33,8 +39,9 @@ public:
     operator VkImageView() const noexcept { return view_; }
 
 private:
-    std::string_view name_ = "ZOO_UNINITIALIZED_TEXTURE_VIEW";
-    VkDevice device_       = VK_NULL_HANDLE;
+    core::Name name_                                   = {};
+    VkDevice device_                                   = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocation_callbacks_ = nullptr;
 
     VkImageViewCreateInfo create_info_ = {};
     VkImageView view_                  = VK_NULL_HANDLE;
@@ -44,13 +51,19 @@ namespace texture {
 
 class Builder {
 public:
-    Builder(std::string_view name) noexcept;
+    static constexpr VkImageUsageFlags RELOCATABLE_USAGE =
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    Builder(core::Name name) noexcept;
 
     Texture build(const Allocator& allocator) noexcept;
 
     Builder& allocation_type(VmaMemoryUsage usage) noexcept;
     Builder& allocation_required_flags(VkMemoryPropertyFlags flags) noexcept;
 
+    // memory type of the pool wins over `allocation_type`, falls back to the default heaps if the image doesn't fit.
+    Builder& pool(Memory_Pool pool) noexcept;
+
     Builder& mip(uint32_t level) noexcept;
     Builder& array(uint32_t level) noexcept;
     Builder& format(VkFormat format) noexcept;
@@ -62,10 +75,11 @@ public:
     Builder& extent(VkExtent3D extent) noexcept;
 
 private:
-    std::string name_;
+    core::Name name_ = {};
 
     VmaAllocationInfo allocation_info_ = {};
     VmaMemoryUsage memory_usage_       = VMA_MEMORY_USAGE_AUTO;
+    Memory_Pool memory_pool_           = Memory_Pool::none;
 
     VkImageType image_type_ = VK_IMAGE_TYPE_2D;
     VkFormat format_        = VK_FORMAT_UNDEFINED; // Needs to be set.
@@ -87,14 +101,13 @@ class Texture {
 public:
     using builder_type = texture::Builder;
 
-    static builder_type start_build(std::string_view name) noexcept;
+    static builder_type start_build(core::Name name) noexcept;
 
     explicit Texture(
-        std::string name,
+        core::Name name,
         VkImage image,
         VkImageCreateInfo create_info,
-        VkDevice device,
-        VmaAllocator allocator,
+        const Allocator& allocator,
         VmaAllocation allocation,
         VmaAllocationInfo allocation_info) noexcept;
 
@@ -114,9 +127,10 @@ public:
     TextureView& view() noexcept;
     const TextureView& view() const noexcept;
 
-    std::string_view name() const noexcept { return name_; }
+    core::Name name() const noexcept { return name_; }
 
     VkDevice device() const noexcept { return device_; }
+    const VkAllocationCallbacks* allocation_callbacks() const noexcept { return allocation_callbacks_; }
 
     void invalidate() noexcept;
     bool valid() const noexcept;
@@ -133,23 +147,38 @@ public:
     u32 mip_level() const noexcept;
     u32 array_count() const noexcept;
     VkExtent3D extent() const noexcept;
+    VkFormat format() const noexcept;
+    VkSampleCountFlagBits samples() const noexcept;
 
     VkImage handle() const noexcept;
 
+    // stays the same when the defragmenter moves the image, only the memory behind it changes.
+    VmaAllocation allocation() const noexcept { return allocation_; }
+
 private:
     VkImageViewCreateInfo create_image_view_info() const noexcept;
 
+    // keeps the vma user data pointing at this object, needs to be called whenever the allocation changes owner.
+    void track_allocation() noexcept;
+
+    // swaps in `image`, which is bound to wherever the defragmenter moved our allocation, and recreates the view.
+    // returns the old handles, they are still in use by frames in flight.
+    std::pair<VkImage, VkImageView> relocate(VkImage image) noexcept;
+
 private:
-    std::string name_ = "ZOO_UNINITIALIZED_TEXTURE";
+    friend class Defragmenter;
+
+    core::Name name_ = {};
 
     VkImage image_                 = VK_NULL_HANDLE;
     VkImageCreateInfo create_info_ = {};
     VkAccessFlags access_flags_    = {};
 
-    VkDevice device_                   = VK_NULL_HANDLE;
-    VmaAllocator allocator_            = VK_NULL_HANDLE;
-    VmaAllocation allocation_          = VK_NULL_HANDLE;
-    VmaAllocationInfo allocation_info_ = {};
+    VkDevice device_                                   = VK_NULL_HANDLE;
+    const VkAllocationCallbacks* allocation_callbacks_ = nullptr;
+    VmaAllocator allocator_                            = VK_NULL_HANDLE;
+    VmaAllocation allocation_                          = VK_NULL_HANDLE;
+    VmaAllocationInfo allocation_info_                 = {};
 
     TextureView view_;
 };
@@ -198,7 +227,11 @@ public:
     static builder_type start_build() noexcept;
 
     TextureSampler() noexcept = default;
-    TextureSampler(VkDevice device, VkSampler sampler, VkSamplerCreateInfo create_info) noexcept;
+    TextureSampler(
+        VkDevice device,
+        const VkAllocationCallbacks* allocation_callbacks,
+        VkSampler sampler,
+        VkSamplerCreateInfo create_info) noexcept;
 
     TextureSampler(const TextureSampler&) noexcept            = delete;
     TextureSampler& operator=(const TextureSampler&) noexcept = delete;
@@ -211,9 +244,10 @@ public:
     VkSampler get() const noexcept { return sampler_; }
 
 private:
-    VkDevice device_                 = nullptr;
-    VkSampler sampler_               = nullptr;
-    VkSamplerCreateInfo create_info_ = {};
+    VkDevice device_                                   = nullptr;
+    const VkAllocationCallbacks* allocation_callbacks_ = nullptr;
+    VkSampler sampler_                                 = nullptr;
+    VkSamplerCreateInfo create_info_                   = {};
 };
 
 } // namespace zoo::render::resources
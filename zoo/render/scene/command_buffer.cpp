@@ -52,28 +52,30 @@ void Command_Buffer::bind_resources(const Resource_Bindings& binding, stdx::span
 void Command_Buffer::bind_resources(stdx::span<const Resource_Binding_Context> bindings) noexcept {
     ZOO_ASSERT(pipeline_bind_context_.layout);
 
-    binding_cache_.sets.clear();
-    binding_cache_.offsets.clear();
-    
+    auto& cache        = binding_cache_;
+    cache.set_count    = 0;
+    cache.offset_count = 0;
+
     for (const auto& binds : bindings) {
-        std::copy(
-            binds.binding.sets(),
-            binds.binding.sets() + binds.binding.count(),
-            std::back_inserter(binding_cache_.sets));
-        std::copy(binds.offset.begin(), binds.offset.end(), std::back_inserter(binding_cache_.offsets));
+        ZOO_ASSERT(cache.set_count + binds.binding.count() <= MAX_BOUND_DESCRIPTOR_SETS, "Too many descriptor sets!");
+        ZOO_ASSERT(cache.offset_count + binds.offset.size() <= MAX_BOUND_DESCRIPTOR_SETS, "Too many dynamic offsets!");
+        std::copy(binds.binding.sets(), binds.binding.sets() + binds.binding.count(), cache.sets + cache.set_count);
+        std::copy(binds.offset.begin(), binds.offset.end(), cache.offsets + cache.offset_count);
+        cache.set_count += binds.binding.count();
+        cache.offset_count += static_cast<u32>(binds.offset.size());
     }
 
-    ZOO_ASSERT(binding_cache_.sets.size() == binding_cache_.offsets.size());
+    ZOO_ASSERT(cache.set_count == cache.offset_count);
     // TODO: change this when compute exists bind point
     vkCmdBindDescriptorSets(
         underlying_,
         VK_PIPELINE_BIND_POINT_GRAPHICS,
         pipeline_bind_context_.layout,
         0,
-        static_cast<u32>(binding_cache_.sets.size()),
-        binding_cache_.sets.data(),
-        static_cast<u32>(binding_cache_.offsets.size()),
-        binding_cache_.offsets.data());
+        cache.set_count,
+        cache.sets,
+        cache.offset_count,
+        cache.offsets);
 }
 
 Present_Context::Present_Context(
@@ -134,7 +136,7 @@ void Command_Buffer::end_record() noexcept {
 
 void Command_Buffer::draw(uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance) noexcept {
     assure_status(RecordStatus::begin);
-    if (vertex_buffer_bind_context_.buffers_.empty()) {
+    if (vertex_buffer_bind_context_.bound_ == 0) {
         ZOO_LOG_ERROR("`draw` called without `bind_vertex_buffers`");
         return;
     }
@@ -157,7 +159,7 @@ void Command_Buffer::draw_indexed(
     uint32_t first_vertex,
     uint32_t first_instance) noexcept {
     assure_status(RecordStatus::begin);
-    if (vertex_buffer_bind_context_.buffers_.empty()) {
+    if (vertex_buffer_bind_context_.bound_ == 0) {
         ZOO_LOG_ERROR("`draw_indexed` called without `bind_vertex_buffers`");
         return;
     }
@@ -183,25 +185,24 @@ void Command_Buffer::bind_pipeline(const render::Pipeline& pipeline) noexcept {
 
 void Command_Buffer::bind_vertex_buffers(stdx::span<const render::resources::Buffer> buffers) noexcept {
     assure_status(RecordStatus::begin);
-    const auto size = buffers.size();
-    auto& vbbuffers = vertex_buffer_bind_context_.buffers_;
-    vbbuffers.clear();
-    vbbuffers.reserve(size);
+    const auto size = static_cast<u32>(buffers.size());
+    ZOO_ASSERT(size <= MAX_VERTEX_BUFFER_BINDINGS, "Too many vertex buffers bound at once!");
 
+    auto& vbbuffers = vertex_buffer_bind_context_.buffers_;
     auto& vboffsets = vertex_buffer_bind_context_.offsets_;
-    vboffsets.clear();
-    vboffsets.reserve(size);
-
-    auto& vbcounts = vertex_buffer_bind_context_.count_;
-    vbcounts       = std::numeric_limits<size_t>::max();
+    auto& vbcounts  = vertex_buffer_bind_context_.count_;
+    vbcounts        = std::numeric_limits<size_t>::max();
 
+    u32 i = 0;
     for (const auto& x : buffers) {
-        vbbuffers.emplace_back(x.handle());
-        vboffsets.emplace_back(x.offset());
-        vbcounts = std::min(vbcounts, x.count());
+        vbbuffers[i] = x.handle();
+        vboffsets[i] = x.offset();
+        vbcounts     = std::min(vbcounts, x.count());
+        ++i;
     }
+    vertex_buffer_bind_context_.bound_ = size;
 
-    vkCmdBindVertexBuffers(underlying_, 0, static_cast<uint32_t>(size), vbbuffers.data(), vboffsets.data());
+    vkCmdBindVertexBuffers(underlying_, 0, size, +vbbuffers, +vboffsets);
 }
 
 void Command_Buffer::bind_index_buffer(const render::resources::Buffer& ib) noexcept {
@@ -291,8 +292,7 @@ void Command_Buffer::exec(const VkRenderPassBeginInfo& begin_info, stdx::functio
 void Command_Buffer::clear_context() noexcept {
     // clear vertex buffer
     vertex_buffer_bind_context_.count_ = 0;
-    vertex_buffer_bind_context_.buffers_.clear();
-    vertex_buffer_bind_context_.offsets_.clear();
+    vertex_buffer_bind_context_.bound_ = 0;
 
     // clear index buffer
     index_buffer_bind_context_.buffer_     = nullptr;
@@ -403,6 +403,24 @@ void Command_Buffer::copy(const render::resources::Buffer& from, render::resourc
     vkCmdCopyBufferToImage(underlying_, from.handle(), to.handle(), image_layout, 1, &copy);
 }
 
+void Command_Buffer::pipeline_barrier(
+    VkPipelineStageFlags src_stages,
+    VkPipelineStageFlags dst_stages,
+    stdx::span<const VkImageMemoryBarrier> barriers) noexcept {
+    assure_status(RecordStatus::begin);
+    vkCmdPipelineBarrier(
+        underlying_,
+        src_stages,
+        dst_stages,
+        0,
+        0,
+        nullptr,
+        0,
+        nullptr,
+        static_cast<u32>(barriers.size()),
+        barriers.data());
+}
+
 void Command_Buffer::transition(
     render::resources::Texture& texture,
     VkImageLayout old_layout,
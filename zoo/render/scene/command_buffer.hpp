@@ -85,6 +85,12 @@ public:
     void transition_to_copy(resources::Texture& texture) noexcept;
     void transition_to_shader_read(resources::Texture& texture) noexcept;
 
+    // every barrier in one `vkCmdPipelineBarrier`, the caller keeps track of layouts.
+    void pipeline_barrier(
+        VkPipelineStageFlags src_stages,
+        VkPipelineStageFlags dst_stages,
+        stdx::span<const VkImageMemoryBarrier> barriers) noexcept;
+
     void transition(
         render::resources::Texture& texture,
         VkImageLayout old_layout                  = VK_IMAGE_LAYOUT_UNDEFINED,
@@ -124,10 +130,15 @@ private:
     Device_Context* context_    = nullptr;
     underlying_type underlying_ = nullptr;
 
+    // recorded every frame, keep these inline so binding never touches the heap.
+    static constexpr u32 MAX_VERTEX_BUFFER_BINDINGS = 8;
+    static constexpr u32 MAX_BOUND_DESCRIPTOR_SETS  = 8;
+
     struct VertexBufferBindContext {
-        std::vector<VkBuffer> buffers_     = {};
-        std::vector<VkDeviceSize> offsets_ = {};
-        size_t count_                      = {};
+        VkBuffer buffers_[MAX_VERTEX_BUFFER_BINDINGS]     = {};
+        VkDeviceSize offsets_[MAX_VERTEX_BUFFER_BINDINGS] = {};
+        u32 bound_                                        = {};
+        size_t count_                                     = {};
     } vertex_buffer_bind_context_;
 
     struct IndexBufferBindContext {
@@ -143,8 +154,10 @@ private:
     } pipeline_bind_context_;
 
     struct Bindings_Cache {
-        std::vector<VkDescriptorSet> sets;
-        std::vector<u32> offsets;
+        VkDescriptorSet sets[MAX_BOUND_DESCRIPTOR_SETS] = {};
+        u32 offsets[MAX_BOUND_DESCRIPTOR_SETS]          = {};
+        u32 set_count                                   = {};
+        u32 offset_count                                = {};
     } binding_cache_;
 
     Operation op_type_          = Operation::unknown;
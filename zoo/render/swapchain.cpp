@@ -139,10 +139,16 @@ bool Swapchain::create_swapchain_and_resources() noexcept {
     size_.x = static_cast<s32>(extent.width);
     size_.y = static_cast<s32>(extent.height);
 
-    uint32_t image_count = std::clamp(
-        description_.capabilities.minImageCount + 1,
-        description_.capabilities.minImageCount,
-        description_.capabilities.maxImageCount);
+    // a max of 0 means the surface has no limit, we still can't go past what fits inline.
+    uint32_t max_image_count = static_cast<uint32_t>(MAX_IMAGE_COUNT);
+    if (description_.capabilities.maxImageCount != 0)
+        max_image_count = std::min(max_image_count, description_.capabilities.maxImageCount);
+
+    // a surface that needs more images than fit inline can't be used, the bounds are kept ordered for `std::clamp`
+    // regardless.
+    const uint32_t min_image_count = description_.capabilities.minImageCount;
+    ZOO_ASSERT(min_image_count <= MAX_IMAGE_COUNT, "Surface needs more swapchain images than we can hold!");
+    uint32_t image_count = std::clamp(min_image_count + 1, min_image_count, std::max(min_image_count, max_image_count));
 
     VkSwapchainCreateInfoKHR create_info{ .sType                 = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR,
                                           .pNext                 = nullptr,
@@ -165,16 +171,17 @@ bool Swapchain::create_swapchain_and_resources() noexcept {
 
     bool failed = false;
     VK_EXPECT_SUCCESS(
-        vkCreateSwapchainKHR(context_, &create_info, nullptr, &underlying_),
+        vkCreateSwapchainKHR(context_, &create_info, context_.allocation_callbacks(), &underlying_),
         [&failed](VkResult /* result */) { failed = true; });
 
     // required to safely destroy after creating new swapchain.
     if (create_info.oldSwapchain != nullptr) {
-        vkDestroySwapchainKHR(context_, create_info.oldSwapchain, nullptr);
+        vkDestroySwapchainKHR(context_, create_info.oldSwapchain, context_.allocation_callbacks());
     }
 
     // retrieve images
     vkGetSwapchainImagesKHR(context_, underlying_, &image_count, nullptr);
+    ZOO_ASSERT(image_count <= MAX_IMAGE_COUNT, "Swapchain has more images than we can hold!");
     images_.resize(image_count);
     vkGetSwapchainImagesKHR(context_, underlying_, &image_count, images_.data());
 
@@ -243,7 +250,7 @@ void Swapchain::cleanup_resources() noexcept {
 void Swapchain::cleanup_swapchain_and_resources() noexcept {
     // not waiting here because cleanup waits
     cleanup_resources();
-    vkDestroySwapchainKHR(context_, underlying_, nullptr);
+    vkDestroySwapchainKHR(context_, underlying_, context_.allocation_callbacks());
     underlying_ = nullptr;
 }
 
@@ -374,7 +381,8 @@ scene::Present_Context Swapchain::current_present_context() const noexcept {
              sync_objects_[current_sync_objects_index_].render_done };
 }
 
-void Swapchain::on_resize(std::function<void(Swapchain&, u32, u32)> cb) noexcept {
+void Swapchain::on_resize(resize_callback_type cb) noexcept {
+    ZOO_ASSERT(!resize_cbs_.full(), "Too many resize callbacks, raise MAX_RESIZE_CALLBACKS!");
     resize_cbs_.emplace_back(std::move(cb));
 }
 
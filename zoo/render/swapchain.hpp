@@ -13,6 +13,9 @@
 #include "sync/fence.hpp"
 #include "sync/semaphore.hpp"
 
+#include "stdx/inplace_function.hpp"
+#include "stdx/inplace_vector.hpp"
+
 // forward declare
 struct GLFWwindow;
 
@@ -23,6 +26,12 @@ public:
     using underlying_type        = VkSwapchainKHR;
     using surface_type           = VkSurfaceKHR;
     using underlying_window_type = GLFWwindow*;
+    using resize_callback_type   = stdx::inplace_function<void(Swapchain&, u32, u32)>;
+
+    // swapchains rarely have more than 3 images, everything per image lives inside the swapchain so recreating it on
+    // resize never touches the heap.
+    static constexpr size_t MAX_IMAGE_COUNT      = 8;
+    static constexpr size_t MAX_RESIZE_CALLBACKS = 8;
 
     // initialize with the device
     Swapchain(render::Engine& engine, underlying_window_type glfw_window, s32 x, s32 y) noexcept;
@@ -31,7 +40,7 @@ public:
 
     void resize(s32 width, s32 height) noexcept;
 
-    void on_resize(std::function<void(Swapchain&, u32, u32)> cb) noexcept;
+    void on_resize(resize_callback_type cb) noexcept;
     void reset() noexcept;
 
     [[nodiscard]] VkFormat format() const noexcept { return description_.surface_format.format; }
@@ -78,7 +87,7 @@ private:
     underlying_type underlying_ = nullptr;
     Device_Context& context_;
 
-    std::vector<std::function<void(Swapchain&, u32, u32)>> resize_cbs_;
+    stdx::inplace_vector<resize_callback_type, MAX_RESIZE_CALLBACKS> resize_cbs_;
 
     WindowSize size_ = {};
     // std::optional<WindowSize> new_size_ = {};
@@ -94,12 +103,11 @@ private:
         sync::Semaphore render_done;
     };
 
-    // @TODO: change these all to arrays.
-    std::vector<VkImage> images_;
-    std::vector<SyncObjects> sync_objects_;
+    stdx::inplace_vector<VkImage, MAX_IMAGE_COUNT> images_;
+    stdx::inplace_vector<SyncObjects, MAX_IMAGE_COUNT> sync_objects_;
     size_t current_sync_objects_index_ = {};
 
-    std::vector<resources::TextureView> views_;
+    stdx::inplace_vector<resources::TextureView, MAX_IMAGE_COUNT> views_;
 
     u32 current_frame_ = 0;
 
@@ -3,13 +3,13 @@
 
 namespace zoo::render::sync {
 
-VkFence create_fence(VkDevice device, bool signaled) noexcept {
+VkFence create_fence(Device_Context& context, bool signaled) noexcept {
     VkFenceCreateInfo fence_info{};
     VkFence fence_obj{};
     fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     // TODO: figure out if we really need to signal at the start.
     if (signaled) fence_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-    VK_EXPECT_SUCCESS(vkCreateFence(device, &fence_info, nullptr, std::addressof(fence_obj)));
+    VK_EXPECT_SUCCESS(vkCreateFence(context, &fence_info, context.allocation_callbacks(), std::addressof(fence_obj)));
     return fence_obj;
 }
 
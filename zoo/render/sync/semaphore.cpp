@@ -5,11 +5,12 @@ namespace zoo::render::sync {
 
 namespace {
 
-VkSemaphore create_semaphore(VkDevice device) noexcept {
+VkSemaphore create_semaphore(Device_Context& context) noexcept {
     VkSemaphoreCreateInfo semaphore_info{};
     VkSemaphore semaphore_obj{};
     semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-    VK_EXPECT_SUCCESS(vkCreateSemaphore(device, &semaphore_info, nullptr, std::addressof(semaphore_obj)));
+    VK_EXPECT_SUCCESS(
+        vkCreateSemaphore(context, &semaphore_info, context.allocation_callbacks(), std::addressof(semaphore_obj)));
     return semaphore_obj;
 }
 
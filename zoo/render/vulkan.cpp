@@ -1,4 +1,5 @@
 #include "vulkan.hpp"
+#include "host_allocator.hpp"
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
@@ -43,54 +44,8 @@ std::vector<const char*> get_extensions() noexcept {
     return extensions;
 }
 
-const char* get_scope_string(VkSystemAllocationScope scope) {
-    switch (scope) {
-        case VK_SYSTEM_ALLOCATION_SCOPE_COMMAND: return "COMMAND";
-        case VK_SYSTEM_ALLOCATION_SCOPE_OBJECT: return "OBJECT";
-        case VK_SYSTEM_ALLOCATION_SCOPE_CACHE: return "CACHE";
-        case VK_SYSTEM_ALLOCATION_SCOPE_DEVICE: return "DEVICE";
-        case VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE: return "INSTANCE";
-        default: return "UNKNOWN";
-    }
-}
-
-// @TODO: Implement CPU allocator. ALLOCATION CALLBACKS
-void* allocation_fn(void* user_data, size_t size, size_t alignment, VkSystemAllocationScope allocation_scope) {
-    const char* scope = get_scope_string(allocation_scope);
-    ZOO_LOG_INFO("Logging allocation function[{}]size : {}, alignment : {}", scope, size, alignment);
-    return malloc(size);
-}
-
-void* reallocation_fn(
-    void* user_data,
-    void* original,
-    size_t size,
-    size_t alignment,
-    VkSystemAllocationScope allocation_scope) {
-    const char* scope = get_scope_string(allocation_scope);
-    ZOO_LOG_INFO("Logging reallocation function[{}]size : {}, alignment : {}", scope, size, alignment);
-    return realloc(original, size);
-}
-
-void free_fn(void* user_data, void* memory) { return free(memory); }
-
-void internal_allocation_notification_fn(
-    void* user_data,
-    size_t size,
-    VkInternalAllocationType allocation_type,
-    VkSystemAllocationScope allocation_scope) {
-    const char* scope = get_scope_string(allocation_scope);
-    ZOO_LOG_INFO("Logging internal_allocation_notification_fn [{}]size : {}, alignment", scope, size);
-}
-
-void internal_free_notification_fn(
-    void* user_data,
-    size_t size,
-    VkInternalAllocationType allocation_type,
-    VkSystemAllocationScope allocation_scope) {
-    const char* scope = get_scope_string(allocation_scope);
-    ZOO_LOG_INFO("Logging free_notification function[{}] : size : {}", scope, size);
-}
+// shared by every render context, vulkan may call into it from any thread.
+render::Host_Allocator host_allocator;
 
 VkInstance create_instance(const VkAllocationCallbacks& allocation_callbacks) noexcept {
     VkApplicationInfo app_info{ .sType              = VK_STRUCTURE_TYPE_APPLICATION_INFO,
@@ -488,12 +443,12 @@ void create_or_recreate_swapchain(
     vkGetSwapchainImagesKHR(device, window.swapchain, &window.num_images, placeholder);
 
     for (u32 i = 0; i < window.num_images; ++i) {
-        auto index        = image_registry.pool.create();
-        auto& data        = image_registry.pool[index];
+        auto handle       = image_registry.pool.emplace();
+        auto& data        = image_registry.pool[handle];
         data.image.vk     = placeholder[i];
-        data.image.handle = index;
+        data.image.handle = handle;
         data.image.mem    = VK_NULL_HANDLE;
-        window.images[i]  = index;
+        window.images[i]  = handle;
     }
     //@BOOKMARK
 }
@@ -518,12 +473,7 @@ void create_image_registry([[maybe_unused]] Image_Registry& registry) {
 
 Render_Context allocate_render_context(Window& window) noexcept {
     Render_Context render_context;
-    render_context.allocation_callbacks = { .pUserData             = nullptr,
-                                            .pfnAllocation         = allocation_fn,
-                                            .pfnReallocation       = reallocation_fn,
-                                            .pfnFree               = free_fn,
-                                            .pfnInternalAllocation = internal_allocation_notification_fn,
-                                            .pfnInternalFree       = internal_free_notification_fn };
+    render_context.allocation_callbacks = host_allocator.callbacks();
 
     render_context.instance = create_instance(render_context.allocation_callbacks);
     render_context.debug =
@@ -1,5 +1,6 @@
 #include "core/window.hpp"
 #include "fwd.hpp"
+#include "utility/registry.hpp"
 
 struct GLFWwindow;
 
@@ -15,7 +16,7 @@ constexpr static auto null_resource = std::numeric_limits<u32>::max();
 struct Image {
     VkImage vk;
     VmaAllocation mem = VK_NULL_HANDLE; // will be null for swapchain images.
-    u32 handle;
+    Handle handle;
 };
 
 struct Window_Data {
@@ -29,42 +30,90 @@ struct Window_Data {
     u32 num_images;
 
     VkSurfaceFormatKHR surface_format;
-    u32 images[MAX_IMAGES];
+    Handle images[MAX_IMAGES];
 };
 
 
 struct Image_View {
     VkImageView image_view;
-    u32 handle;
+    Handle handle;
 };
 
+// Fixed capacity slot map. values are kept packed at the front of `values` so walking `begin()` to `end()` only
+// touches live values, handles carry a generation so a handle to an erased value is never resolved again.
 template <typename T, u32 N>
-struct Pool {
-    u32 sparse[N];
-    T direct[N];
-    u32 objects_count = 0;
+struct Slot_Map {
+    static_assert(N < Handle::INDEX_MASK, "Slot_Map is too large for a Handle index");
+
+    // a live slot points at its value, a free slot points at the next free slot.
+    struct Slot {
+        u32 index      = null_resource;
+        u32 generation = 0;
+    };
+
+    T values[N]       = {};
+    u32 value_slot[N] = {}; // slot of every value, used to patch up the moved value on erase.
+    Slot slots[N]     = {};
+    u32 count         = 0;
+    u32 slot_count    = 0;
     u32 free_list     = null_resource;
 
-    Pool() { memset(sparse, null_resource, N); }
+    template <typename... Args>
+    Handle emplace(Args&&... args) {
+        ZOO_ASSERT(count < N, "Slot_Map is full!");
+        u32 slot = free_list;
+        if (slot != null_resource) {
+            free_list = slots[slot].index;
+        } else {
+            slot = slot_count++;
+        }
+
+        values[count]     = T{ std::forward<Args>(args)... };
+        value_slot[count] = slot;
+        slots[slot].index = count++;
+        return { slot, slots[slot].generation };
+    }
 
-    u32 create() {
-        if (free_list != null_resource) {
-            auto next = free_list;
-            free_list = sparse[free_list];
-            return next;
+    void erase(Handle handle) {
+        ZOO_ASSERT(contains(handle), "Erasing a handle that is not in the Slot_Map!");
+        const u32 slot = handle.index();
+        const u32 hole = slots[slot].index;
+        const u32 last = --count;
+
+        // swap remove so that the values stay packed.
+        if (hole != last) {
+            values[hole]                  = std::move(values[last]);
+            value_slot[hole]              = value_slot[last];
+            slots[value_slot[hole]].index = hole;
         }
-        return objects_count++;
+
+        // a fixed number of slots can't afford to retire any, the generation wraps around instead.
+        slots[slot].generation = (slots[slot].generation + 1) & Handle::MAX_GENERATION;
+        slots[slot].index      = free_list;
+        free_list              = slot;
+    }
+
+    bool contains(Handle handle) const {
+        const u32 slot = handle.index();
+        return slot < slot_count && slots[slot].generation == handle.generation() && slots[slot].index < count &&
+               value_slot[slots[slot].index] == slot;
+    }
+
+    T& operator[](Handle handle) {
+        ZOO_ASSERT(contains(handle), "Handle is not in the Slot_Map!");
+        return values[slots[handle.index()].index];
     }
 
-    void erase(u32 index) {
-        sparse[index] = free_list;
-        free_list = index;
-        --objects_count;
+    const T& operator[](Handle handle) const {
+        ZOO_ASSERT(contains(handle), "Handle is not in the Slot_Map!");
+        return values[slots[handle.index()].index];
     }
 
-    T& operator[](u32 index) { return direct[sparse[index]]; }
-    const T& operator[](u32 index) const { return direct[sparse[index]]; }
-    u32 count() const { return objects_count; }
+    T* begin() { return values; }
+    T* end() { return values + count; }
+    const T* begin() const { return values; }
+    const T* end() const { return values + count; }
+    u32 size() const { return count; }
 };
 
 struct Image_Registry {
@@ -77,7 +126,7 @@ struct Image_Registry {
     };
 
     // VmaPool memory_pool; // for memory allocation.
-    Pool<Node, MAX_IMAGES> pool;
+    Slot_Map<Node, MAX_IMAGES> pool;
 };
 
 struct Render_Context {
@@ -0,0 +1,24 @@
+#include "embedded_shaders.hpp"
+
+namespace zoo::tools {
+
+namespace {
+
+struct Embedded_Shader {
+    std::string_view path;
+    const u32* words;
+    size_t word_count;
+};
+
+#include "embedded_shaders.inl"
+
+} // namespace
+
+stdx::span<const u32> find_embedded_shader(std::string_view path) noexcept {
+    for (const auto& shader : EMBEDDED_SHADERS) {
+        if (shader.path == path) return { shader.words, shader.word_count };
+    }
+    return {};
+}
+
+} // namespace zoo::tools
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "core/fwd.hpp"
+#include "stdx/span.hpp"
+
+#include <string_view>
+
+namespace zoo::tools {
+
+// spir-v compiled by the build from every shader under `static/shaders`, see `lua/shaders.lua`. `path` is the path
+// the shader would otherwise be read from, empty when the build did not embed it.
+stdx::span<const u32> find_embedded_shader(std::string_view path) noexcept;
+
+} // namespace zoo::tools
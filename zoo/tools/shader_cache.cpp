@@ -0,0 +1,111 @@
+#include "shader_cache.hpp"
+#include "core/log.hpp"
+#include "core/utils.hpp"
+#include "shader_compiler.hpp"
+
+#include "stdx/hash.hpp"
+
+#include <spdlog/fmt/fmt.h>
+#include <vulkan/vulkan_core.h>
+
+#include <cstring>
+
+namespace zoo::tools {
+
+namespace {
+
+constexpr u32 FILE_MAGIC = 0x07'23'02'03; // spir-v magic, byte swapped.
+
+// bump when the way shaders are compiled changes without any of the key inputs changing.
+constexpr u32 CACHE_VERSION = 1;
+
+struct File_Header {
+    u32 magic      = FILE_MAGIC;
+    u32 version    = CACHE_VERSION;
+    u64 key        = 0;
+    u64 word_count = 0;
+    u64 hash       = 0;
+};
+
+u64 hash_string(std::string_view str, u64 seed) noexcept { return stdx::hash_bytes(str.data(), str.size(), seed); }
+
+template <typename T>
+u64 hash_value(const T& value, u64 seed) noexcept {
+    return stdx::hash_bytes(&value, sizeof(value), seed);
+}
+
+} // namespace
+
+u64 Shader_Cache::key(const Shader_Work& work, shaderc_optimization_level level) noexcept {
+    // shaderc has no version of its own, the spir-v version it targets and the sdk it shipped with stand in for it.
+    u32 spirv_version  = 0;
+    u32 spirv_revision = 0;
+    shaderc_get_spv_version(&spirv_version, &spirv_revision);
+
+    u64 seed = hash_value(CACHE_VERSION, 0);
+    seed     = hash_value(spirv_version, seed);
+    seed     = hash_value(spirv_revision, seed);
+    seed     = hash_value(VK_HEADER_VERSION_COMPLETE, seed);
+    seed     = hash_value(work.kind, seed);
+    seed     = hash_value(level, seed);
+    seed     = hash_string(work.name, seed);
+    seed     = hash_string(work.bytes, seed);
+    for (const auto& define : work.defines) {
+        seed = hash_string(define.name, seed);
+        seed = hash_string(define.value, seed);
+    }
+    return seed;
+}
+
+std::optional<std::vector<u32>> Shader_Cache::find(u64 key) noexcept {
+    auto file = core::read_file(path(key));
+    if (!file) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    File_Header header{};
+    const auto reject = [&](const char* reason) -> std::optional<std::vector<u32>> {
+        ZOO_LOG_WARN("Ignoring cached shader \"{}\" : {}", path(key), reason);
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    };
+
+    if (file->size() < sizeof(header)) return reject("truncated header");
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != FILE_MAGIC || header.version != CACHE_VERSION) return reject("unknown format");
+    if (header.key != key) return reject("key mismatch");
+    if (header.word_count * sizeof(u32) != file->size() - sizeof(header)) return reject("truncated spir-v");
+
+    const char* words = file->data() + sizeof(header);
+    if (stdx::hash_bytes(words, header.word_count * sizeof(u32)) != header.hash) return reject("corrupt spir-v");
+
+    std::vector<u32> spirv(header.word_count);
+    std::memcpy(spirv.data(), words, header.word_count * sizeof(u32));
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return spirv;
+}
+
+void Shader_Cache::store(u64 key, const std::vector<u32>& spirv) noexcept {
+    File_Header header{};
+    header.key        = key;
+    header.word_count = spirv.size();
+    header.hash       = stdx::hash_bytes(spirv.data(), spirv.size() * sizeof(u32));
+
+    std::string file(sizeof(header) + spirv.size() * sizeof(u32), '\0');
+    std::memcpy(file.data(), &header, sizeof(header));
+    std::memcpy(file.data() + sizeof(header), spirv.data(), spirv.size() * sizeof(u32));
+
+    if (!core::write_file_atomic(path(key), file)) ZOO_LOG_WARN("Unable to cache shader \"{}\"", path(key));
+}
+
+Shader_Cache::Stats Shader_Cache::stats() const noexcept {
+    return { hits_.load(std::memory_order_relaxed),
+             misses_.load(std::memory_order_relaxed),
+             rejected_.load(std::memory_order_relaxed) };
+}
+
+std::string Shader_Cache::path(u64 key) const noexcept { return fmt::format("{}/{:016x}.spv", directory_, key); }
+
+} // namespace zoo::tools
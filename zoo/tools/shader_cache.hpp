@@ -0,0 +1,50 @@
+#pragma once
+
+#include "core/fwd.hpp"
+#include <shaderc/shaderc.hpp>
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zoo::tools {
+
+struct Shader_Work;
+
+// spir-v from earlier runs, one file per compilation named after its key. the key covers everything that changes the
+// output, so a changed source or define simply misses. files that don't check out are treated as missing.
+// safe to use from several threads at once.
+class Shader_Cache {
+public:
+    static constexpr std::string_view DIRECTORY = "cache/shaders";
+
+    struct Stats {
+        u32 hits     = 0;
+        u32 misses   = 0;
+        u32 rejected = 0;
+    };
+
+    explicit Shader_Cache(std::string_view directory = DIRECTORY) noexcept : directory_(directory) {}
+
+    // source, defines, kind, optimization level and compiler version.
+    static u64 key(const Shader_Work& work, shaderc_optimization_level level) noexcept;
+
+    std::optional<std::vector<u32>> find(u64 key) noexcept;
+    void store(u64 key, const std::vector<u32>& spirv) noexcept;
+
+    Stats stats() const noexcept;
+
+private:
+    std::string path(u64 key) const noexcept;
+
+private:
+    std::string directory_;
+
+    std::atomic<u32> hits_     = 0;
+    std::atomic<u32> misses_   = 0;
+    std::atomic<u32> rejected_ = 0;
+};
+
+} // namespace zoo::tools
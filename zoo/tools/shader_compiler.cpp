@@ -1,24 +1,80 @@
 #include "shader_compiler.hpp"
+#include "core/allocator.hpp"
 #include "core/fwd.hpp"
 #include "spdlog/spdlog.h"
 
+#include "stdx/parallel.hpp"
+
+#include <optional>
+
 namespace zoo::tools {
 
+std::string shader_name(std::string_view path) noexcept {
+    const size_t slash = path.find_last_of("/\\");
+    return std::string{ slash == std::string_view::npos ? path : path.substr(slash + 1) };
+}
+
 stdx::expected<std::vector<u32>, std::runtime_error> Shader_Compiler::compile(const Shader_Work& work) noexcept {
+    shaderc::Compiler& compiler = acquire();
+    Shader_Result result        = compile(compiler, work);
+    release(compiler);
+    return std::move(result.spirv);
+}
+
+std::vector<Shader_Result> Shader_Compiler::compile_batch(stdx::span<const Shader_Work> works) noexcept {
+    // shaderc takes milliseconds per shader, every shader is worth a task of its own.
+    std::vector<std::optional<Shader_Result>> slots(works.size());
+    stdx::parallel_for(stdx::irange(size_t{ 0 }, works.size()), 1, [&](size_t i) {
+        shaderc::Compiler& compiler = acquire();
+        slots[i].emplace(compile(compiler, works[i]));
+        release(compiler);
+    });
+
+    std::vector<Shader_Result> results;
+    results.reserve(slots.size());
+    for (auto& slot : slots)
+        results.push_back(std::move(*slot));
+    return results;
+}
+
+Shader_Result Shader_Compiler::compile(shaderc::Compiler& compiler, const Shader_Work& work) noexcept {
+    ZOO_MEMORY_TAG(core::Memory_Tag::shader);
+    const auto start = std::chrono::steady_clock::now();
+    const auto since = [start]() { return std::chrono::steady_clock::now() - start; };
+
+    const u64 key = Shader_Cache::key(work, OPTIMIZATION_LEVEL);
+    if (auto spirv = cache_.find(key)) return { std::move(*spirv), since(), true };
+
     shaderc::CompileOptions options;
     for (const auto& defines : work.defines) {
         options.AddMacroDefinition(defines.name, defines.value);
     }
+    options.SetOptimizationLevel(OPTIMIZATION_LEVEL);
 
     shaderc::SpvCompilationResult module =
-        compiler_.CompileGlslToSpv(work.bytes, work.kind, work.name.c_str(), options);
-
-    options.SetOptimizationLevel(shaderc_optimization_level_performance);
+        compiler.CompileGlslToSpv(work.bytes, work.kind, work.name.c_str(), options);
 
     if (module.GetCompilationStatus() != shaderc_compilation_status_success) {
-        return stdx::unexpected{ std::runtime_error(module.GetErrorMessage()) };
+        return { stdx::unexpected{ std::runtime_error(module.GetErrorMessage()) }, since(), false };
     }
 
-    return std::vector<uint32_t>{ module.cbegin(), module.cend() };
+    std::vector<u32> spirv{ module.cbegin(), module.cend() };
+    cache_.store(key, spirv);
+    return { std::move(spirv), since(), false };
 }
+
+shaderc::Compiler& Shader_Compiler::acquire() noexcept {
+    std::lock_guard lock{ mutex_ };
+    if (idle_.empty()) return *compilers_.emplace_back(std::make_unique<shaderc::Compiler>());
+
+    shaderc::Compiler* compiler = idle_.back();
+    idle_.pop_back();
+    return *compiler;
+}
+
+void Shader_Compiler::release(shaderc::Compiler& compiler) noexcept {
+    std::lock_guard lock{ mutex_ };
+    idle_.push_back(&compiler);
+}
+
 } // namespace zoo::tools
@@ -1,10 +1,18 @@
 #pragma once
 
 #include "core/fwd.hpp"
+#include "shader_cache.hpp"
 #include "stdx/expected.hpp"
 #include "stdx/span.hpp"
 #include <shaderc/shaderc.hpp>
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace zoo::tools {
 
 struct Shader_Def_Type {
@@ -19,12 +27,44 @@ struct Shader_Work {
     stdx::span<Shader_Def_Type> defines = {};
 };
 
+// the name a shader file is compiled under, its file name. the name is part of the cache key, so everything compiling
+// the same file has to go through this to share cache entries.
+std::string shader_name(std::string_view path) noexcept;
+
+struct Shader_Result {
+    stdx::expected<std::vector<u32>, std::runtime_error> spirv;
+    // wall time of this one shader, whichever thread it ran on.
+    std::chrono::nanoseconds duration = {};
+    bool cached                       = false;
+};
+
 class Shader_Compiler {
 public:
     using define_type = Shader_Def_Type;
+
+    static constexpr shaderc_optimization_level OPTIMIZATION_LEVEL = shaderc_optimization_level_performance;
+
+    // shaderc only runs when `work` is not in the cache yet.
     stdx::expected<std::vector<u32>, std::runtime_error> compile(const Shader_Work& work) noexcept;
 
+    // compiles `works` on the worker pool, every thread borrows a shaderc compiler of its own for as long as it is
+    // compiling. the results line up with `works`.
+    std::vector<Shader_Result> compile_batch(stdx::span<const Shader_Work> works) noexcept;
+
+    const Shader_Cache& cache() const noexcept { return cache_; }
+
+private:
+    Shader_Result compile(shaderc::Compiler& compiler, const Shader_Work& work) noexcept;
+
+    shaderc::Compiler& acquire() noexcept;
+    void release(shaderc::Compiler& compiler) noexcept;
+
 private:
-    shaderc::Compiler compiler_;
+    Shader_Cache cache_;
+
+    // one per thread that has compiled so far, handed out again once that thread is done.
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<shaderc::Compiler>> compilers_;
+    std::vector<shaderc::Compiler*> idle_;
 };
 } // namespace zoo::tools
@@ -0,0 +1,57 @@
+#include "shader_reloader.hpp"
+#include "core/log.hpp"
+#include "core/utils.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace zoo::tools {
+
+bool Shader_Reloader::start(std::string_view directory) noexcept {
+    return watcher_.start(directory, [this](const std::string& path) { reload(path); });
+}
+
+std::vector<Shader_Reloader::Reload> Shader_Reloader::take() noexcept {
+    std::lock_guard lock{ mutex_ };
+    return std::exchange(ready_, {});
+}
+
+std::optional<shaderc_shader_kind> Shader_Reloader::kind(std::string_view path) noexcept {
+    const auto extension = path.substr(std::min(path.rfind('.'), path.size()));
+    if (extension == ".vert") return shaderc_vertex_shader;
+    if (extension == ".frag") return shaderc_fragment_shader;
+    if (extension == ".comp") return shaderc_compute_shader;
+    if (extension == ".geom") return shaderc_geometry_shader;
+    if (extension == ".tesc") return shaderc_tess_control_shader;
+    if (extension == ".tese") return shaderc_tess_evaluation_shader;
+    return std::nullopt;
+}
+
+void Shader_Reloader::reload(const std::string& path) noexcept {
+    const auto shader_kind = kind(path);
+    if (!shader_kind) return;
+
+    const auto noticed = std::chrono::steady_clock::now();
+    auto bytes         = core::read_file(path);
+    if (!bytes) {
+        ZOO_LOG_WARN("Unable to reload \"{}\" : {}", path, bytes.error().what());
+        return;
+    }
+
+    // named like the shaders compiled at startup so that switching back to an earlier version hits the cache.
+    auto spirv = compiler_.compile({ *shader_kind, shader_name(path), std::move(*bytes) });
+    if (!spirv) {
+        ZOO_LOG_ERROR("Unable to reload \"{}\" : {}", path, spirv.error().what());
+        return;
+    }
+
+    Reload result{ path, std::move(*spirv), std::chrono::steady_clock::now() - noticed, noticed };
+    std::lock_guard lock{ mutex_ };
+    auto it = std::find_if(ready_.begin(), ready_.end(), [&](const Reload& ready) { return ready.path == path; });
+    if (it != ready_.end())
+        *it = std::move(result);
+    else
+        ready_.push_back(std::move(result));
+}
+
+} // namespace zoo::tools
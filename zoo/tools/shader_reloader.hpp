@@ -0,0 +1,51 @@
+#pragma once
+
+#include "core/file_watcher.hpp"
+#include "core/fwd.hpp"
+#include "shader_compiler.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zoo::tools {
+
+// Recompiles shaders as they change on disk. compiling happens on the thread of the watcher, whoever renders picks
+// the results up with `take` once it is safe to swap pipelines. shaders that fail to compile are logged and never
+// handed out, pipelines keep the spir-v they had.
+class Shader_Reloader {
+public:
+    struct Reload {
+        std::string path;
+        std::vector<u32> spirv;
+        std::chrono::nanoseconds compile_time = {};
+        // when the change was noticed, the time it takes to show up on screen starts here.
+        std::chrono::steady_clock::time_point noticed = {};
+    };
+
+    bool start(std::string_view directory) noexcept;
+    void stop() noexcept { watcher_.stop(); }
+
+    // every shader that compiled since the last call, at most one per path.
+    std::vector<Reload> take() noexcept;
+
+    // by extension, `std::nullopt` for files that aren't shaders.
+    static std::optional<shaderc_shader_kind> kind(std::string_view path) noexcept;
+
+private:
+    void reload(const std::string& path) noexcept;
+
+private:
+    Shader_Compiler compiler_;
+
+    std::mutex mutex_;
+    std::vector<Reload> ready_;
+
+    // last so that its thread is joined before anything it uses is destroyed.
+    core::File_Watcher watcher_;
+};
+
+} // namespace zoo::tools
@@ -2,6 +2,10 @@
 
 #include "aligned_storage.hpp"
 #include "singleton.hpp"
+#include <bit>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <utility>
 
 #include "core/fwd.hpp"
@@ -31,12 +35,7 @@ struct Bucket {
         new (storage + idx) Type{ std::forward<Args&&>(args)... };
     }
 
-    template <typename... Args>
-    void destroy_at(s32 idx) {
-        using decayed_type = std::decay_t<value_type>;
-        // call destructor
-        (storage + idx)->~decayed_type();
-    }
+    void destroy_at(s32 idx) { std::destroy_at(std::launder(&initialized(idx))); }
 };
 
 // This is a managed array that never resizes.
@@ -197,50 +196,252 @@ private:
     s32 size_;
 };
 
-// Not ready for use.
+// Dynamic array that grows by linking fixed size buckets. Elements never move once emplaced so pointers to them stay
+// valid until they are erased, erased slots are reused by later emplaces.
+// Every bucket is allocated aligned to its own size so `erase` finds the owning bucket from the element address in
+// O(1), pick `N` so that a bucket ends up close to a power of two bytes.
 template <typename Type, s32 N>
 class Bucket_Array {
-    // use a linked list to make the bucket array
+    static_assert(N > 0, "Bucket_Array needs at least one element per bucket");
+
     using Bucket_Type = Bucket<Type, N>;
 
+    static constexpr s32 WORD_BITS  = 64;
+    static constexpr s32 WORD_COUNT = (N + WORD_BITS - 1) / WORD_BITS;
+
+    // `data.count` is the number of live elements in the bucket.
     struct Bucket_Node {
         Bucket_Type data;
-        Bucket_Node* next;
-        Bucket_Node* prev;
+        u64 live[WORD_COUNT];
+        Bucket_Node* next;      // every bucket, in allocation order.
+        Bucket_Node* next_free; // buckets that still have a free slot.
+    };
+
+    static constexpr size_t BUCKET_ALIGNMENT = std::bit_ceil(sizeof(Bucket_Node));
+
+    template <typename Value_Type, typename Node_Type>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type        = std::remove_const_t<Value_Type>;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = Value_Type*;
+        using reference         = Value_Type&;
+
+        Iterator() noexcept = default;
+        Iterator(Node_Type* node, s32 idx) noexcept : node_(node), idx_(idx) {}
+
+        // iterator -> const_iterator.
+        template <typename Other_Value, typename Other_Node>
+        Iterator(const Iterator<Other_Value, Other_Node>& other) noexcept : node_(other.node_), idx_(other.idx_) {}
+
+        reference operator*() const noexcept { return node_->data.initialized(idx_); }
+        pointer operator->() const noexcept { return &node_->data.initialized(idx_); }
+
+        Iterator& operator++() noexcept {
+            auto [node, idx] = next_live(node_, idx_ + 1);
+            node_            = node;
+            idx_             = idx;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator self = *this;
+            ++(*this);
+            return self;
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.node_ == rhs.node_ && lhs.idx_ == rhs.idx_;
+        }
+
+    private:
+        template <typename, typename>
+        friend class Iterator;
+        friend class Bucket_Array;
+
+        Node_Type* node_ = nullptr;
+        s32 idx_         = 0;
     };
 
 public:
-    void resize(s32 size) noexcept {
-        auto bucket_size                     = size / N;
-        [[maybe_unused]] auto size_in_bucket = size % N;
-
-        auto* bucket = head;
-        for (s32 i = 0; i < bucket_size; ++i) {
-            if (bucket->next == nullptr) {
-                // allocate.
-            }
-            bucket = bucket->next;
+    using value_type     = Type;
+    using iterator       = Iterator<Type, Bucket_Node>;
+    using const_iterator = Iterator<const Type, const Bucket_Node>;
+
+    template <typename... Args>
+    Type& emplace(Args&&... args) noexcept {
+        if (free_ == nullptr) free_ = allocate_bucket();
+
+        Bucket_Node* node = free_;
+        const s32 idx     = first_free_slot(node);
+        node->data.construct_at(idx, std::forward<Args&&>(args)...);
+        node->live[idx / WORD_BITS] |= u64{ 1 } << (idx % WORD_BITS);
+
+        // full buckets are always at the front of the free list.
+        if (++node->data.count == N) free_ = node->next_free;
+        ++count_;
+        return node->data.initialized(idx);
+    }
+
+    void push(Type&& value) noexcept { emplace(std::move(value)); }
+
+    void erase(Type* element) noexcept {
+        ZOO_ASSERT(element != nullptr, "Cannot erase a nullptr from a Bucket_Array");
+        Bucket_Node* node = bucket_of(element);
+        erase_at(node, slot_of(node, element));
+    }
+
+    iterator erase(const_iterator it) noexcept {
+        auto* node    = const_cast<Bucket_Node*>(it.node_);
+        const s32 idx = it.idx_;
+        erase_at(node, idx);
+        auto [next, next_idx] = next_live(node, idx + 1);
+        return { next, next_idx };
+    }
+
+    // destroys every element but keeps the buckets around for reuse.
+    void clear() noexcept {
+        free_ = nullptr;
+        for (Bucket_Node* node = head_; node != nullptr; node = node->next) {
+            destroy_bucket(node);
+            node->next_free = free_;
+            free_           = node;
+        }
+        count_ = 0;
+    }
+
+    s32 size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    s32 capacity() const noexcept { return bucket_count_ * N; }
+
+    iterator begin() noexcept {
+        auto [node, idx] = next_live(head_, 0);
+        return { node, idx };
+    }
+    iterator end() noexcept { return {}; }
+
+    const_iterator begin() const noexcept {
+        auto [node, idx] = next_live(head_, 0);
+        return { node, idx };
+    }
+    const_iterator end() const noexcept { return {}; }
+
+public: // all the operators and constructors
+    Bucket_Array() noexcept = default;
+    ~Bucket_Array() noexcept { release(); }
+
+    Bucket_Array(const Bucket_Array&)            = delete;
+    Bucket_Array& operator=(const Bucket_Array&) = delete;
+
+    Bucket_Array(Bucket_Array&& other) noexcept { *this = std::move(other); }
+
+    Bucket_Array& operator=(Bucket_Array&& other) noexcept {
+        if (this == &other) return *this;
+        release();
+        head_         = std::exchange(other.head_, nullptr);
+        free_         = std::exchange(other.free_, nullptr);
+        count_        = std::exchange(other.count_, 0);
+        bucket_count_ = std::exchange(other.bucket_count_, 0);
+        return *this;
+    }
+
+private:
+    Bucket_Node* allocate_bucket() noexcept {
+        void* memory = ::operator new(BUCKET_ALIGNMENT, std::align_val_t{ BUCKET_ALIGNMENT }, std::nothrow);
+        ZOO_ASSERT(memory != nullptr, "Bucket_Array ran out of memory");
+
+        auto* node      = new (memory) Bucket_Node{};
+        node->next      = head_;
+        node->next_free = free_;
+        head_           = node;
+        ++bucket_count_;
+        return node;
+    }
+
+    void erase_at(Bucket_Node* node, s32 idx) noexcept {
+        ZOO_ASSERT(is_live(node, idx), "Erasing an element that is not in the Bucket_Array");
+        node->data.destroy_at(idx);
+        node->live[idx / WORD_BITS] &= ~(u64{ 1 } << (idx % WORD_BITS));
+
+        // the bucket was full so it is not in the free list yet.
+        if (node->data.count-- == N) {
+            node->next_free = free_;
+            free_           = node;
+        }
+        --count_;
+    }
+
+    void destroy_bucket(Bucket_Node* node) noexcept {
+        for (s32 idx = next_live_in(node, 0).second; idx < N; idx = next_live_in(node, idx + 1).second)
+            node->data.destroy_at(idx);
+        for (auto& word : node->live)
+            word = 0;
+        node->data.count = 0;
+    }
+
+    void release() noexcept {
+        for (Bucket_Node* node = head_; node != nullptr;) {
+            Bucket_Node* next = node->next;
+            destroy_bucket(node);
+            node->~Bucket_Node();
+            ::operator delete(node, std::align_val_t{ BUCKET_ALIGNMENT });
+            node = next;
+        }
+        head_         = nullptr;
+        free_         = nullptr;
+        count_        = 0;
+        bucket_count_ = 0;
+    }
+
+    static Bucket_Node* bucket_of(const Type* element) noexcept {
+        return reinterpret_cast<Bucket_Node*>(reinterpret_cast<uintptr_t>(element) & ~(BUCKET_ALIGNMENT - 1));
+    }
+
+    static s32 slot_of(const Bucket_Node* node, const Type* element) noexcept {
+        auto* storage = reinterpret_cast<const typename Bucket_Type::uninitialized_type*>(element);
+        return static_cast<s32>(storage - node->data.storage);
+    }
+
+    static bool is_live(const Bucket_Node* node, s32 idx) noexcept {
+        return (node->live[idx / WORD_BITS] >> (idx % WORD_BITS)) & 1;
+    }
+
+    static s32 first_free_slot(const Bucket_Node* node) noexcept {
+        for (s32 word = 0; word < WORD_COUNT; ++word) {
+            if (node->live[word] != ~u64{ 0 }) return word * WORD_BITS + std::countr_one(node->live[word]);
         }
+        ZOO_ASSERT(false, "Bucket in the free list has no free slot");
+        return N;
     }
 
-    void deinit(Bucket_Type& bucket) {
-        // TODO: fix this!!
-        (void)bucket;
+    // first live slot at or after `idx` in `node`, `N` if there is none.
+    template <typename Node_Type>
+    static std::pair<Node_Type*, s32> next_live_in(Node_Type* node, s32 idx) noexcept {
+        for (s32 word = idx / WORD_BITS; word < WORD_COUNT; ++word) {
+            u64 bits = node->live[word];
+            if (word == idx / WORD_BITS) bits &= ~u64{ 0 } << (idx % WORD_BITS);
+            if (bits != 0) return { node, word * WORD_BITS + std::countr_zero(bits) };
+        }
+        return { node, N };
     }
 
-    ~Bucket_Array() noexcept {
-        auto bucket = head;
-        while (bucket) {
-            auto b_temp = bucket;
-            bucket      = bucket->next;
-            deinit(b_temp->data);
-            delete b_temp;
+    // walks the buckets until a live slot shows up, returns the end iterator position if there is none.
+    template <typename Node_Type>
+    static std::pair<Node_Type*, s32> next_live(Node_Type* node, s32 idx) noexcept {
+        for (; node != nullptr; node = node->next, idx = 0) {
+            if (node->data.count == 0 || idx >= N) continue;
+            auto found = next_live_in(node, idx);
+            if (found.second < N) return found;
         }
+        return { nullptr, 0 };
     }
 
 private:
-    Bucket_Node* head;
-    s32 count;
+    Bucket_Node* head_ = nullptr;
+    Bucket_Node* free_ = nullptr;
+    s32 count_         = 0;
+    s32 bucket_count_  = 0;
 };
 
 } // namespace zoo
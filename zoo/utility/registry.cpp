@@ -3,31 +3,40 @@
 namespace zoo {
 
 Registry::handle Registry::create() noexcept {
-    if (start_ == invalid) {
-        auto next = sparse_.size();
-        sparse_.push_back(next);
-        return next;
+    ++alive_;
+    if (free_head_ == MAX_SIZE) {
+        const auto index = static_cast<u32>(slots_.size());
+        ZOO_ASSERT(index < MAX_SIZE, "Registry ran out of handles!");
+        return slots_.emplace_back(index, 0);
     }
 
-    ZOO_ASSERT(start_ < sparse_.size());
-    auto next     = start_;
-    start_        = sparse_[start_];
-    sparse_[next] = invalid;
-    return next;
+    const u32 index   = free_head_;
+    const Handle next = slots_[index];
+    free_head_        = next.index();
+    slots_[index]     = { index, next.generation() };
+    return slots_[index];
 }
 
-void Registry::destroy(handle idx) noexcept {
-    ZOO_ASSERT(idx != invalid && idx < sparse_.size());
-    sparse_[idx] = start_;
-    start_       = idx;
-}
+void Registry::destroy(handle h) noexcept {
+    ZOO_ASSERT(valid(h), "Destroying a handle that is not alive!");
+    --alive_;
 
-bool Registry::all_freed() const noexcept {
-    index_type i = 0;
-    for (const auto& s : sparse_) {
-        if (s == invalid && i++ != 0) return false; // only one can be invalid ( which is tail )
+    // a slot that ran out of generations is retired instead of wrapping around and reviving old handles.
+    if (h.generation() == Handle::MAX_GENERATION) {
+        slots_[h.index()] = { MAX_SIZE, Handle::MAX_GENERATION };
+        return;
     }
-    return true;
+
+    slots_[h.index()] = { free_head_, h.generation() + 1 };
+    free_head_        = h.index();
+}
+
+bool Registry::valid(handle h) const noexcept { return h.index() < slots_.size() && slots_[h.index()] == h; }
+
+void Registry::clear() noexcept {
+    slots_.clear();
+    free_head_ = MAX_SIZE;
+    alive_     = 0;
 }
 
 } // namespace zoo
@@ -5,21 +5,54 @@
 
 namespace zoo {
 
+// 32 bit handle made of a slot index and the generation of that slot.
+class Handle {
+public:
+    static constexpr u32 INDEX_BITS      = 20;
+    static constexpr u32 GENERATION_BITS = 32 - INDEX_BITS;
+    static constexpr u32 INDEX_MASK      = (u32{ 1 } << INDEX_BITS) - 1;
+    static constexpr u32 MAX_GENERATION  = (u32{ 1 } << GENERATION_BITS) - 1;
+
+    constexpr Handle() noexcept = default;
+    constexpr Handle(u32 index, u32 generation) noexcept : value_((generation << INDEX_BITS) | index) {}
+
+    constexpr u32 index() const noexcept { return value_ & INDEX_MASK; }
+    constexpr u32 generation() const noexcept { return value_ >> INDEX_BITS; }
+    constexpr u32 value() const noexcept { return value_; }
+
+    constexpr bool operator==(const Handle& other) const noexcept = default;
+
+private:
+    u32 value_ = std::numeric_limits<u32>::max();
+};
+
+// Hands out handles with O(1) create, destroy and lookup. destroying a handle bumps the generation of its slot, so a
+// stale handle stops being `valid` instead of aliasing whatever reuses the slot next.
 class Registry {
 public:
-    using size_type  = size_t;
-    using index_type = size_type;
-    using handle     = index_type;
+    using size_type = size_t;
+    using handle    = Handle;
+
+    static constexpr Handle invalid = {};
+    static constexpr u32 MAX_SIZE   = Handle::INDEX_MASK;
 
     handle create() noexcept;
-    void destroy(handle idx) noexcept;
-    [[nodiscard]] bool all_freed() const noexcept;
+    void destroy(handle h) noexcept;
+
+    // O(1), false for handles that were destroyed or never came from this registry.
+    [[nodiscard]] bool valid(handle h) const noexcept;
+
+    [[nodiscard]] size_type size() const noexcept { return alive_; }
+    [[nodiscard]] bool all_freed() const noexcept { return alive_ == 0; }
 
-    static constexpr auto invalid = std::numeric_limits<handle>::max();
+    void clear() noexcept;
 
 private:
-    std::vector<handle> sparse_ = {};
-    handle start_               = invalid;
+    // a live slot holds its own handle. a free slot holds the next free index together with the generation the slot
+    // gets when it is reused, which makes the free list intrusive.
+    std::vector<Handle> slots_ = {};
+    u32 free_head_             = MAX_SIZE;
+    u32 alive_                 = 0;
 };
 
 } // namespace zoo
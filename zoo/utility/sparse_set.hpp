@@ -0,0 +1,119 @@
+#pragma once
+#include "core/fwd.hpp"
+#include "registry.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace zoo {
+
+// Maps `Registry` handles to densely packed values. values and their handles sit in two parallel arrays with no
+// holes, so iterating is a linear walk, while a paged sparse array indexed by the handle index finds a value in O(1).
+// erasing swaps the last value into the hole, pointers and iteration order are not stable across erases.
+template <typename Type>
+class Sparse_Set {
+public:
+    using handle     = Registry::handle;
+    using value_type = Type;
+    using iterator   = Type*;
+
+    static constexpr u32 PAGE_SIZE = 4096;
+
+    template <typename... Args>
+    Type& emplace(handle h, Args&&... args) noexcept {
+        ZOO_ASSERT(!contains(h), "Handle already has a value in the Sparse_Set!");
+        u32& slot = sparse_slot(h.index());
+        slot      = static_cast<u32>(dense_.size());
+        handles_.push_back(h);
+        return dense_.emplace_back(std::forward<Args>(args)...);
+    }
+
+    void erase(handle h) noexcept {
+        ZOO_ASSERT(contains(h), "Erasing a handle that is not in the Sparse_Set!");
+        const u32 position = sparse_slot(h.index());
+        const u32 last     = static_cast<u32>(dense_.size() - 1);
+
+        if (position != last) {
+            dense_[position]                        = std::move(dense_[last]);
+            handles_[position]                      = handles_[last];
+            sparse_slot(handles_[position].index()) = position;
+        }
+        sparse_slot(h.index()) = INVALID_POSITION;
+        dense_.pop_back();
+        handles_.pop_back();
+    }
+
+    // also checks the generation, so stale handles are never found.
+    [[nodiscard]] bool contains(handle h) const noexcept {
+        const u32 position = find_position(h.index());
+        return position != INVALID_POSITION && handles_[position] == h;
+    }
+
+    Type* find(handle h) noexcept {
+        return contains(h) ? &dense_[find_position(h.index())] : nullptr;
+    }
+
+    const Type* find(handle h) const noexcept {
+        return contains(h) ? &dense_[find_position(h.index())] : nullptr;
+    }
+
+    Type& get(handle h) noexcept {
+        ZOO_ASSERT(contains(h), "Handle is not in the Sparse_Set!");
+        return dense_[find_position(h.index())];
+    }
+
+    const Type& get(handle h) const noexcept {
+        ZOO_ASSERT(contains(h), "Handle is not in the Sparse_Set!");
+        return dense_[find_position(h.index())];
+    }
+
+    void clear() noexcept {
+        for (const handle h : handles_)
+            sparse_slot(h.index()) = INVALID_POSITION;
+        dense_.clear();
+        handles_.clear();
+    }
+
+    size_t size() const noexcept { return dense_.size(); }
+    bool empty() const noexcept { return dense_.empty(); }
+
+    // handle of every value, in the same order as the values.
+    const std::vector<handle>& handles() const noexcept { return handles_; }
+
+    Type* data() noexcept { return dense_.data(); }
+    const Type* data() const noexcept { return dense_.data(); }
+
+    Type* begin() noexcept { return dense_.data(); }
+    Type* end() noexcept { return dense_.data() + dense_.size(); }
+    const Type* begin() const noexcept { return dense_.data(); }
+    const Type* end() const noexcept { return dense_.data() + dense_.size(); }
+
+private:
+    static constexpr u32 INVALID_POSITION = ~u32{ 0 };
+
+    u32 find_position(u32 index) const noexcept {
+        const u32 page = index / PAGE_SIZE;
+        if (page >= pages_.size() || pages_[page] == nullptr) return INVALID_POSITION;
+        return pages_[page][index % PAGE_SIZE];
+    }
+
+    // pages are only allocated once a handle from their range is inserted.
+    u32& sparse_slot(u32 index) noexcept {
+        const u32 page = index / PAGE_SIZE;
+        if (page >= pages_.size()) pages_.resize(page + 1);
+        if (pages_[page] == nullptr) {
+            pages_[page] = std::make_unique<u32[]>(PAGE_SIZE);
+            std::fill_n(pages_[page].get(), PAGE_SIZE, INVALID_POSITION);
+        }
+        return pages_[page][index % PAGE_SIZE];
+    }
+
+private:
+    std::vector<Type> dense_                   = {};
+    std::vector<handle> handles_               = {};
+    std::vector<std::unique_ptr<u32[]>> pages_ = {};
+};
+
+} // namespace zoo